@@ -0,0 +1,572 @@
+// benchmark.c
+// Mede o tempo de carregamento dos alunos com cada carregador
+// Uso: ./benchmark [--json] [--calculo <num_alunos>] [--ranking <max_alunos>] [--indice <max_alunos>] [--deltas <num_alunos>] [--estatisticas <num_alunos>] [--compacto <num_alunos>] [--threads N] <notas.csv> [outros.csv ...]
+// Com --json, cada arquivo é medido etapa por etapa (tempo, pico de RSS e alocações)
+// e o resultado sai como um objeto JSON por linha (ver comum/medicao.c)
+#include <time.h>
+#define MEDIR_ALOCACOES
+#include "../comum/medicao.c"
+#include "utils.c"
+
+// Compara dois arrays de alunos campo a campo (bits dos floats incluídos)
+static int alunos_iguais(const Aluno *a, const Aluno *b, int n) {
+    for (int i = 0; i < n; i++) {
+        if (a[i].matricula != b[i].matricula ||
+            strcmp(nome_aluno(&a[i]), nome_aluno(&b[i])) != 0 ||
+            a[i].num_avaliacoes != b[i].num_avaliacoes ||
+            memcmp(avaliacoes_aluno(&a[i]), avaliacoes_aluno(&b[i]), a[i].num_avaliacoes * sizeof(Avaliacao)) != 0 ||
+            memcmp(&a[i].nf, &b[i].nf, sizeof(float)) != 0 ||
+            a[i].status != b[i].status) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Gera alunos com notas aleatórias (incluindo notas fora de 0..10) para os testes de cálculo
+static Aluno *gerar_alunos(int n, unsigned semente) {
+    Aluno *alunos = (Aluno*) calloc(n, sizeof(Aluno));
+    if (!alunos) {
+        return NULL;
+    }
+    srand(semente);
+    for (int i = 0; i < n; i++) {
+        char nome[32];
+        int tamanho = snprintf(nome, sizeof(nome), "Aluno %d", i);
+        alunos[i].matricula = i;
+        if (!arena_adicionar(&arena_nomes, nome, (size_t) tamanho, &alunos[i].nome)) {
+            liberar_memoria(alunos, i);
+            return NULL;
+        }
+        for (int a = 0; a < AVALIACOES_FIXAS; a++) {
+            Avaliacao av;
+            av.ap1 = (rand() % 1401 - 200) / 100.0f;
+            av.ap2 = (rand() % 1401 - 200) / 100.0f;
+            av.ap3 = (rand() % 1401 - 200) / 100.0f;
+            av.np  = (rand() % 1401 - 200) / 100.0f;
+            adicionar_avaliacoes(&alunos[i], av);
+        }
+    }
+    return alunos;
+}
+
+// Compara calcular_notas (um aluno por vez) com calcular_notas_lote (tabela em colunas)
+static void benchmark_calculo(int n) {
+    Aluno *linhas = gerar_alunos(n, 42);
+    Aluno *colunas = gerar_alunos(n, 42);
+    TabelaNotas tabela;
+    if (!linhas || !colunas || !criar_tabela_notas(&tabela, n)) {
+        fprintf(stderr, "Erro ao alocar memória para o benchmark de cálculo\n");
+        exit(1);
+    }
+
+    double t0 = tempo_atual();
+    for (int i = 0; i < n; i++) {
+        calcular_notas(&linhas[i]);
+    }
+    double t1 = tempo_atual();
+    preencher_tabela_notas(&tabela, colunas, n);
+    double t2 = tempo_atual();
+    calcular_notas_lote(&tabela);
+    double t3 = tempo_atual();
+    aplicar_tabela_notas(&tabela, colunas, n);
+
+    printf("\nCalculo de notas (%d alunos)\n", n);
+    printf("%-24s | %-12s | %-16s\n", "Versao", "Tempo (ms)", "Alunos/s");
+    printf("%-24s | %-12.2f | %-16.0f\n", "calcular_notas", (t1 - t0) * 1e3, n / (t1 - t0));
+    printf("%-24s | %-12.2f | %-16.0f\n", "calcular_notas_lote", (t3 - t2) * 1e3, n / (t3 - t2));
+    printf("Resultados identicos: %s\n", alunos_iguais(linhas, colunas, n) ? "Sim" : "Nao");
+
+    liberar_tabela_notas(&tabela);
+    liberar_memoria(linhas, n);
+    liberar_memoria(colunas, n);
+}
+
+// Compara ordenar_alunos_bolha (original) com o ranking por radix sort
+// A ordenação por bolha só é medida até 30 mil alunos (acima disso leva minutos)
+static void benchmark_ranking(int maximo) {
+    printf("\nRanking por NF\n");
+    printf("%-12s | %-14s | %-14s | %-14s | %-14s | %-10s\n",
+           "Alunos", "Bolha (ms)", "Radix (ms)", "Matric. (ms)", "Nome (ms)", "Iguais");
+    for (int n = 1000; n <= maximo; n *= 10) {
+        Aluno *a = gerar_alunos(n, 7);
+        Aluno *b = gerar_alunos(n, 7);
+        if (!a || !b) {
+            fprintf(stderr, "Erro ao alocar memória para o benchmark de ranking\n");
+            exit(1);
+        }
+        for (int i = 0; i < n; i++) {
+            calcular_notas(&a[i]);
+            calcular_notas(&b[i]);
+        }
+
+        double tempo_bolha = -1;
+        if (n <= 30000) {
+            double t0 = tempo_atual();
+            ordenar_alunos_bolha(a, n);
+            tempo_bolha = (tempo_atual() - t0) * 1e3;
+        }
+
+        double t0 = tempo_atual();
+        int *indices = ranking_alunos(b, n, ORDEM_DECRESCENTE, DESEMPATE_NENHUM);
+        double t1 = tempo_atual();
+        int *por_matricula = ranking_alunos(b, n, ORDEM_DECRESCENTE, DESEMPATE_MATRICULA);
+        double t2 = tempo_atual();
+        int *por_nome = ranking_alunos(b, n, ORDEM_DECRESCENTE, DESEMPATE_NOME);
+        double t3 = tempo_atual();
+
+        // O ranking estável deve reproduzir exatamente a ordem do bubble sort
+        const char *iguais = "-";
+        if (tempo_bolha >= 0) {
+            aplicar_ranking(b, n, indices);
+            iguais = alunos_iguais(a, b, n) ? "Sim" : "Nao";
+        }
+
+        if (tempo_bolha >= 0) {
+            printf("%-12d | %-14.2f | ", n, tempo_bolha);
+        } else {
+            printf("%-12d | %-14s | ", n, "-");
+        }
+        printf("%-14.2f | %-14.2f | %-14.2f | %-10s\n", (t1 - t0) * 1e3, (t2 - t1) * 1e3, (t3 - t2) * 1e3, iguais);
+
+        free(indices);
+        free(por_matricula);
+        free(por_nome);
+        liberar_memoria(a, n);
+        liberar_memoria(b, n);
+    }
+}
+
+// Mede buscas, correções e remoções pelo índice de matrículas para tamanhos crescentes
+// O tempo por busca deve ficar praticamente constante; a busca linear é medida até 100 mil alunos
+static void benchmark_indice(int maximo) {
+    const int num_buscas = 1000000;
+    printf("\nIndice de matriculas\n");
+    printf("%-12s | %-14s | %-14s | %-14s | %-14s | %-14s | %-10s\n",
+           "Alunos", "Criar (ms)", "Busca (ns)", "Ausente (ns)", "Correcao (ns)", "Linear (ns)", "Consistente");
+    for (int n = 1000; n <= maximo; n *= 10) {
+        Aluno *alunos = gerar_alunos(n, 11);
+        if (!alunos) {
+            fprintf(stderr, "Erro ao alocar memória para o benchmark do índice\n");
+            exit(1);
+        }
+        // Matrículas espalhadas e sem repetição (multiplicar por ímpar é bijetor módulo 2^31)
+        for (int i = 0; i < n; i++) {
+            alunos[i].matricula = (int) (((unsigned int) i * 2654435761u) & 0x7fffffff);
+            calcular_notas(&alunos[i]);
+        }
+
+        IndiceAlunos indice;
+        double t0 = tempo_atual();
+        if (construir_indice_alunos(&indice, alunos, n) != 0) {
+            fprintf(stderr, "Erro ao criar o índice\n");
+            exit(1);
+        }
+        double t1 = tempo_atual();
+
+        // Buscas em posições aleatórias (gerador congruencial, sem custo de rand())
+        unsigned int semente = 12345;
+        long soma = 0;
+        for (int i = 0; i < num_buscas; i++) {
+            semente = semente * 1103515245u + 12345u;
+            soma += indice_buscar(&indice, alunos[semente % (unsigned int) n].matricula);
+        }
+        double t2 = tempo_atual();
+        for (int i = 0; i < num_buscas; i++) {
+            semente = semente * 1103515245u + 12345u;
+            soma += indice_buscar(&indice, (int) (semente | 0x80000000u)); // Negativas não existem
+        }
+        double t3 = tempo_atual();
+        for (int i = 0; i < num_buscas; i++) {
+            semente = semente * 1103515245u + 12345u;
+            atualizar_nota_aluno(&indice, alunos, alunos[semente % (unsigned int) n].matricula,
+                                 (int) (semente >> 8) & 1, CAMPO_NP, (float) (semente >> 20 & 1023) / 100.0f);
+        }
+        double t4 = tempo_atual();
+
+        double tempo_linear = -1;
+        if (n <= 100000) {
+            const int buscas_lineares = 1000;
+            double t5 = tempo_atual();
+            for (int i = 0; i < buscas_lineares; i++) {
+                semente = semente * 1103515245u + 12345u;
+                int matricula = alunos[semente % (unsigned int) n].matricula;
+                for (int j = 0; j < n; j++) {
+                    if (alunos[j].matricula == matricula) {
+                        soma += j;
+                        break;
+                    }
+                }
+            }
+            tempo_linear = (tempo_atual() - t5) * 1e9 / buscas_lineares;
+        }
+
+        // Remove 10% dos alunos e confere se todas as posições continuam corretas
+        int num_alunos = n;
+        for (int i = 0; i < n / 10; i++) {
+            semente = semente * 1103515245u + 12345u;
+            remover_aluno(&indice, alunos, &num_alunos, alunos[semente % (unsigned int) num_alunos].matricula);
+        }
+        int consistente = indice.num_itens == num_alunos;
+        for (int i = 0; i < num_alunos && consistente; i++) {
+            consistente = indice_buscar(&indice, alunos[i].matricula) == i;
+        }
+
+        printf("%-12d | %-14.2f | %-14.1f | %-14.1f | %-14.1f | ", n, (t1 - t0) * 1e3,
+               (t2 - t1) * 1e9 / num_buscas, (t3 - t2) * 1e9 / num_buscas, (t4 - t3) * 1e9 / num_buscas);
+        if (tempo_linear >= 0) {
+            printf("%-14.1f | ", tempo_linear);
+        } else {
+            printf("%-14s | ", "-");
+        }
+        printf("%-10s\n", consistente ? "Sim" : "Nao");
+        if (soma == 42) {
+            printf("\n"); // Impede que o compilador descarte as buscas
+        }
+
+        liberar_indice_alunos(&indice);
+        liberar_memoria(alunos, num_alunos);
+    }
+}
+
+// Mede a aplicação de 1000 correções com o ranking dinâmico, comparada a reordenar tudo
+// O ranking depois das correções é conferido contra ranking_alunos
+static void benchmark_deltas(int n) {
+    const int num_deltas = 1000;
+    Aluno *alunos = gerar_alunos(n, 5);
+    DeltaNota *deltas = (DeltaNota*) malloc(num_deltas * sizeof(DeltaNota));
+    MudancaRanking *mudancas = (MudancaRanking*) malloc(num_deltas * sizeof(MudancaRanking));
+    int *indices = (int*) malloc((size_t) n * sizeof(int));
+    IndiceAlunos indice;
+    RankingDinamico ranking;
+    if (!alunos || !deltas || !mudancas || !indices) {
+        fprintf(stderr, "Erro ao alocar memória para o benchmark de deltas\n");
+        exit(1);
+    }
+    for (int i = 0; i < n; i++) {
+        calcular_notas(&alunos[i]);
+    }
+
+    double t0 = tempo_atual();
+    if (construir_indice_alunos(&indice, alunos, n) != 0 ||
+        !criar_ranking_dinamico(&ranking, alunos, n, ORDEM_DECRESCENTE)) {
+        fprintf(stderr, "Erro ao criar o índice ou o ranking\n");
+        exit(1);
+    }
+    double t1 = tempo_atual();
+
+    srand(99);
+    for (int i = 0; i < num_deltas; i++) {
+        deltas[i].matricula = (int) (((unsigned int) rand() * 65536u + (unsigned int) rand()) % (unsigned int) n);
+        deltas[i].avaliacao = rand() % 2;
+        deltas[i].campo = (CampoNota) (rand() % 4);
+        deltas[i].valor = (rand() % 1001) / 100.0f;
+    }
+
+    double t2 = tempo_atual();
+    int num_mudancas = aplicar_deltas(&indice, alunos, &ranking, deltas, num_deltas, mudancas);
+    double t3 = tempo_atual();
+    int *reordenado = ranking_alunos(alunos, n, ORDEM_DECRESCENTE, DESEMPATE_NENHUM);
+    double t4 = tempo_atual();
+
+    indices_ranking_dinamico(&ranking, indices);
+    int iguais = reordenado && memcmp(indices, reordenado, (size_t) n * sizeof(int)) == 0;
+
+    printf("\nCorrecoes de notas (%d alunos, %d deltas, %d alunos alterados)\n", n, num_deltas, num_mudancas);
+    printf("%-32s | %-12s\n", "Etapa", "Tempo (ms)");
+    printf("%-32s | %-12.2f\n", "Indice + ranking dinamico", (t1 - t0) * 1e3);
+    printf("%-32s | %-12.3f\n", "aplicar_deltas", (t3 - t2) * 1e3);
+    printf("%-32s | %-12.2f\n", "Reordenar tudo (ranking_alunos)", (t4 - t3) * 1e3);
+    printf("Ranking identico: %s\n", iguais ? "Sim" : "Nao");
+
+    free(reordenado);
+    free(indices);
+    free(deltas);
+    free(mudancas);
+    liberar_ranking_dinamico(&ranking);
+    liberar_indice_alunos(&indice);
+    liberar_memoria(alunos, n);
+}
+
+static int comparar_floats(const void *a, const void *b) {
+    float x = *(const float*) a, y = *(const float*) b;
+    return (x > y) - (x < y);
+}
+
+// Compara as estatísticas em uma passada (1 thread e num_threads) com o cálculo
+// ingênuo: uma passada por estatística e qsort de cada coluna para os percentis exatos
+static void benchmark_estatisticas(int n, int num_threads) {
+    Aluno *alunos = gerar_alunos(n, 3);
+    TabelaNotas tabela;
+    EstatisticasNotas *uma = (EstatisticasNotas*) malloc(sizeof(EstatisticasNotas));
+    EstatisticasNotas *varias = (EstatisticasNotas*) malloc(sizeof(EstatisticasNotas));
+    float *copia = (float*) malloc((size_t) n * sizeof(float));
+    if (!alunos || !uma || !varias || !copia || !criar_tabela_notas(&tabela, n)) {
+        fprintf(stderr, "Erro ao alocar memória para o benchmark de estatísticas\n");
+        exit(1);
+    }
+    preencher_tabela_notas(&tabela, alunos, n);
+    calcular_notas_lote(&tabela);
+
+    double t0 = tempo_atual();
+    calcular_estatisticas(&tabela, 1, uma);
+    double t1 = tempo_atual();
+    calcular_estatisticas(&tabela, num_threads, varias);
+    double t2 = tempo_atual();
+
+    // Ingênuo: média, desvio, mínimo/máximo e histograma em passadas separadas, percentis por ordenação
+    double erro_percentil = 0;
+    double t3 = tempo_atual();
+    for (int c = 0; c < ESTATISTICAS_COLUNAS; c++) {
+        const float *valores = c < 8 ? (c % 4 == 0 ? tabela.ap1[c / 4] : c % 4 == 1 ? tabela.ap2[c / 4] :
+                                        c % 4 == 2 ? tabela.ap3[c / 4] : tabela.np[c / 4]) : tabela.nf;
+        double soma = 0, desvio = 0;
+        float min = valores[0], max = valores[0];
+        long long faixas[ESTATISTICAS_FAIXAS] = {0};
+        for (int i = 0; i < n; i++) soma += valores[i];
+        double media = soma / n;
+        for (int i = 0; i < n; i++) desvio += (valores[i] - media) * (valores[i] - media);
+        for (int i = 0; i < n; i++) {
+            if (valores[i] < min) min = valores[i];
+            if (valores[i] > max) max = valores[i];
+        }
+        for (int i = 0; i < n; i++) faixas[valores[i] >= 9 ? 9 : (int) valores[i]]++;
+        memcpy(copia, valores, (size_t) n * sizeof(float));
+        qsort(copia, n, sizeof(float), comparar_floats);
+        for (int p = 10; p <= 90; p += 20) {
+            long long posto = ((long long) p * n + 99) / 100;
+            double erro = fabs(copia[posto > 0 ? posto - 1 : 0] - percentil_coluna(&uma->colunas[c], p));
+            if (erro > erro_percentil) erro_percentil = erro;
+        }
+        if (faixas[0] != uma->colunas[c].faixas[0] || min != uma->colunas[c].min || max != uma->colunas[c].max ||
+            fabs(media - media_coluna(&uma->colunas[c])) > 1e-9 || desvio < 0) {
+            erro_percentil = 1e9;
+        }
+    }
+    double t4 = tempo_atual();
+
+    int iguais = 1;
+    for (int c = 0; c < ESTATISTICAS_COLUNAS; c++) {
+        iguais = iguais && uma->colunas[c].contagem == varias->colunas[c].contagem &&
+                 memcmp(uma->colunas[c].centesimos, varias->colunas[c].centesimos, sizeof(uma->colunas[c].centesimos)) == 0 &&
+                 memcmp(uma->colunas[c].faixas, varias->colunas[c].faixas, sizeof(uma->colunas[c].faixas)) == 0 &&
+                 fabs(uma->colunas[c].soma - varias->colunas[c].soma) <= 1e-9 * fabs(uma->colunas[c].soma);
+    }
+
+    printf("\nEstatisticas (%d alunos, %d colunas)\n", n, ESTATISTICAS_COLUNAS);
+    printf("%-28s | %-12s | %-16s\n", "Versao", "Tempo (ms)", "Valores/s");
+    printf("%-28s | %-12.2f | %-16.0f\n", "Uma passada, 1 thread", (t1 - t0) * 1e3, (double) n * ESTATISTICAS_COLUNAS / (t1 - t0));
+    printf("%-28s | %-12.2f | %-16.0f\n", "Uma passada, threads", (t2 - t1) * 1e3, (double) n * ESTATISTICAS_COLUNAS / (t2 - t1));
+    printf("%-28s | %-12.2f | %-16.0f\n", "Ingenuo (qsort)", (t4 - t3) * 1e3, (double) n * ESTATISTICAS_COLUNAS / (t4 - t3));
+    printf("Maior erro nos percentis: %.4f\n", erro_percentil);
+    printf("Threads e 1 thread iguais: %s\n", iguais ? "Sim" : "Nao");
+
+    liberar_tabela_notas(&tabela);
+    free(uma);
+    free(varias);
+    free(copia);
+    liberar_memoria(alunos, n);
+}
+
+// Mede carregar_alunos e ordenar_alunos (e o carregador paralelo, com --threads) no arquivo
+// Cada etapa é escrita em uma linha JSON na saída padrão
+static void benchmark_json(const char *nome_arquivo, int num_threads) {
+    Medicao medicao;
+    int num_alunos = 0;
+
+    iniciar_medicao(&medicao, "notas", nome_arquivo, "carregar_alunos");
+    Aluno *alunos = carregar_alunos(nome_arquivo, &num_alunos);
+    terminar_medicao(&medicao, num_alunos);
+    imprimir_medicao_json(stdout, &medicao);
+    if (!alunos) {
+        return;
+    }
+
+    iniciar_medicao(&medicao, "notas", nome_arquivo, "ordenar_alunos");
+    ordenar_alunos(alunos, num_alunos);
+    terminar_medicao(&medicao, num_alunos);
+    imprimir_medicao_json(stdout, &medicao);
+
+    liberar_memoria(alunos, num_alunos);
+    liberar_arena(&arena_nomes);
+
+    if (num_threads >= 0) {
+        iniciar_medicao(&medicao, "notas", nome_arquivo, "carregar_alunos_paralelo");
+        alunos = carregar_alunos_paralelo(nome_arquivo, &num_alunos, num_threads);
+        terminar_medicao(&medicao, alunos ? num_alunos : 0);
+        imprimir_medicao_json(stdout, &medicao);
+        liberar_memoria(alunos, num_alunos);
+        liberar_arena(&arena_nomes);
+    }
+}
+
+// Compara o modo normal (Aluno com floats) com o compacto (centésimos em int16):
+// memória por aluno, cálculo das notas e ranking, com a aprovação conferida aluno a aluno
+static void benchmark_compacto(int n) {
+    // A memória conta a arena de nomes inteira: começa vazia, só com os nomes deste teste
+    liberar_arena(&arena_nomes);
+    Aluno *alunos = gerar_alunos(n, 11);
+    TurmaCompacta turma;
+    if (!alunos || !converter_para_compacto(&turma, alunos, n)) {
+        fprintf(stderr, "Erro ao alocar memória para o benchmark do modo compacto\n");
+        exit(1);
+    }
+
+    double t0 = tempo_atual();
+    for (int i = 0; i < n; i++) {
+        calcular_notas(&alunos[i]);
+    }
+    double t1 = tempo_atual();
+    for (int i = 0; i < n; i++) {
+        calcular_notas_compacto(&turma.alunos[i]);
+    }
+    double t2 = tempo_atual();
+    int *ranking_normal = ranking_alunos(alunos, n, ORDEM_DECRESCENTE, DESEMPATE_NENHUM);
+    double t3 = tempo_atual();
+    int *ranking_fixo = ranking_compacto(&turma, ORDEM_DECRESCENTE);
+    double t4 = tempo_atual();
+
+    // As notas geradas têm 2 casas, então a aprovação só pode mudar quando a NF exata
+    // é 6.00 e a soma em float fica um pouco abaixo disso no modo normal
+    int status_diferentes = 0;
+    int diferencas_explicadas = 1;
+    for (int i = 0; i < n; i++) {
+        if (alunos[i].status != turma.alunos[i].status) {
+            status_diferentes++;
+            diferencas_explicadas &= turma.alunos[i].soma == SOMA_APROVACAO && alunos[i].nf < 6.0f;
+        }
+    }
+
+    size_t memoria_normal = memoria_alunos(alunos, n);
+    size_t memoria_compacta = memoria_turma_compacta(&turma);
+    printf("\nModo compacto (%d alunos; sizeof(Aluno) = %zu, sizeof(AlunoCompacto) = %zu)\n",
+           n, sizeof(Aluno), sizeof(AlunoCompacto));
+    printf("%-12s | %-16s | %-16s | %-16s | %-16s\n", "Layout", "Bytes/aluno", "Memoria (MB)", "Calculo (ms)", "Ranking (ms)");
+    printf("%-12s | %-16.1f | %-16.1f | %-16.2f | %-16.2f\n", "Aluno", (double) memoria_normal / n,
+           memoria_normal / (1024.0 * 1024.0), (t1 - t0) * 1e3, (t3 - t2) * 1e3);
+    printf("%-12s | %-16.1f | %-16.1f | %-16.2f | %-16.2f\n", "Compacto", (double) memoria_compacta / n,
+           memoria_compacta / (1024.0 * 1024.0), (t2 - t1) * 1e3, (t4 - t3) * 1e3);
+    printf("Aprovacao diferente: %d alunos (todos com NF exata 6.00 e NF em float abaixo de 6: %s)\n",
+           status_diferentes, diferencas_explicadas ? "Sim" : "Nao");
+
+    free(ranking_normal);
+    free(ranking_fixo);
+    liberar_turma_compacta(&turma);
+    liberar_memoria(alunos, n);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Uso: %s [--json] [--calculo <num_alunos>] [--ranking <max_alunos>] [--indice <max_alunos>] [--deltas <num_alunos>] [--estatisticas <num_alunos>] [--compacto <num_alunos>] [--threads N] <notas.csv> [outros.csv ...]\n", argv[0]);
+        return 1;
+    }
+
+    int num_calculo = 0;
+    int max_ranking = 0;
+    int max_indice = 0;
+    int num_deltas = 0;
+    int num_estatisticas = 0;
+    int num_compacto = 0;
+    int num_threads = 0;
+    int threads_pedidas = -1;   // Para o --json: -1 mede só os carregadores sequenciais
+    int modo_json = 0;
+    int cabecalho = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--calculo") == 0 && i + 1 < argc) {
+            num_calculo = atoi(argv[++i]);
+            continue;
+        }
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+            threads_pedidas = num_threads;
+            continue;
+        }
+        if (strcmp(argv[i], "--json") == 0) {
+            modo_json = 1;
+            continue;
+        }
+        if (strcmp(argv[i], "--ranking") == 0 && i + 1 < argc) {
+            max_ranking = atoi(argv[++i]);
+            continue;
+        }
+        if (strcmp(argv[i], "--indice") == 0 && i + 1 < argc) {
+            max_indice = atoi(argv[++i]);
+            continue;
+        }
+        if (strcmp(argv[i], "--deltas") == 0 && i + 1 < argc) {
+            num_deltas = atoi(argv[++i]);
+            continue;
+        }
+        if (strcmp(argv[i], "--estatisticas") == 0 && i + 1 < argc) {
+            num_estatisticas = atoi(argv[++i]);
+            continue;
+        }
+        if (strcmp(argv[i], "--compacto") == 0 && i + 1 < argc) {
+            num_compacto = atoi(argv[++i]);
+            continue;
+        }
+
+        if (modo_json) {
+            benchmark_json(argv[i], threads_pedidas);
+            continue;
+        }
+        if (!cabecalho) {
+            printf("%-30s | %-12s | %-16s | %-16s | %-20s | %-20s | %-10s\n", "Arquivo", "Linhas",
+                   "fgets (linhas/s)", "mmap (linhas/s)", "paralelo (linhas/s)", "snapshot (linhas/s)", "Iguais");
+            cabecalho = 1;
+        }
+
+        int n_fgets = 0, n_mmap = 0, n_paralelo = 0, n_snapshot = 0;
+
+        double t0 = tempo_atual();
+        Aluno *a = carregar_alunos(argv[i], &n_fgets);
+        double t1 = tempo_atual();
+        Aluno *b = carregar_alunos_mmap(argv[i], &n_mmap);
+        double t2 = tempo_atual();
+        Aluno *c = carregar_alunos_paralelo(argv[i], &n_paralelo, num_threads);
+        double t3 = tempo_atual();
+
+        // O snapshot é gravado antes da medição; só a leitura dele é medida
+        const char *nome_snapshot = "benchmark.snap";
+        Aluno *d = NULL;
+        double t4 = t3, t5 = t3;
+        if (c && salvar_snapshot(nome_snapshot, argv[i], c, n_paralelo)) {
+            t4 = tempo_atual();
+            d = carregar_snapshot(nome_snapshot, argv[i], &n_snapshot);
+            t5 = tempo_atual();
+            remove(nome_snapshot);
+        }
+
+        int iguais = (n_fgets == n_mmap) && (n_fgets == n_paralelo) && (n_fgets == n_snapshot) &&
+                     alunos_iguais(a, b, n_fgets) && alunos_iguais(a, c, n_fgets) && alunos_iguais(a, d, n_fgets);
+        printf("%-30s | %-12d | %-16.0f | %-16.0f | %-20.0f | %-20.0f | %-10s\n", argv[i], n_mmap,
+               n_fgets / (t1 - t0), n_mmap / (t2 - t1), n_paralelo / (t3 - t2), n_snapshot / (t5 - t4),
+               iguais ? "Sim" : "Nao");
+
+        liberar_memoria(a, n_fgets);
+        liberar_memoria(b, n_mmap);
+        liberar_memoria(c, n_paralelo);
+        liberar_memoria(d, n_snapshot);
+        liberar_arena(&arena_nomes);
+    }
+
+    if (num_calculo > 0) {
+        benchmark_calculo(num_calculo);
+    }
+    if (max_ranking > 0) {
+        benchmark_ranking(max_ranking);
+    }
+    if (max_indice > 0) {
+        benchmark_indice(max_indice);
+    }
+    if (num_deltas > 0) {
+        benchmark_deltas(num_deltas);
+    }
+    if (num_estatisticas > 0) {
+        benchmark_estatisticas(num_estatisticas, num_threads);
+    }
+    if (num_compacto > 0) {
+        benchmark_compacto(num_compacto);
+    }
+    return 0;
+}
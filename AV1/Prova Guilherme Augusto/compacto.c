@@ -0,0 +1,249 @@
+#include "compacto.h"
+
+// Converte uma nota em centésimos, arredondando para o mais próximo
+// Valores fora do int16 ficam no limite (o ajuste para 0..10 vem depois) e NaN vira 0
+int16_t nota_para_centesimos(float nota) {
+    if (nota != nota) {
+        return 0;
+    }
+    double centesimos = (double) nota * NOTA_ESCALA;
+    if (centesimos >= INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (centesimos <= INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t) (centesimos >= 0 ? (int) (centesimos + 0.5) : -(int) (-centesimos + 0.5));
+}
+
+// Mesmo cálculo de calcular_notas, só com inteiros:
+// ajusta as notas para 0..1000 centésimos, soma e compara com a soma de aprovação
+void calcular_notas_compacto(AlunoCompacto *aluno) {
+    int soma = 0;
+    for (int i = 0; i < NOTAS_COMPACTAS; i++) {
+        int nota = aluno->notas[i];
+        if (nota < 0) {
+            nota = 0;
+        } else if (nota > NOTA_MAXIMA_FIXA) {
+            nota = NOTA_MAXIMA_FIXA;
+        }
+        aluno->notas[i] = (int16_t) nota;
+        soma += nota;
+    }
+    aluno->soma = (int16_t) soma;
+    aluno->status = soma >= SOMA_APROVACAO ? 1 : 0;
+}
+
+// NF em centésimos (soma / 8), arredondada como o printf arredonda um valor exato:
+// para o mais próximo e, na metade, para o par
+int nf_centesimos(const AlunoCompacto *aluno) {
+    int inteiro = aluno->soma / NOTAS_COMPACTAS;
+    int resto = aluno->soma % NOTAS_COMPACTAS;
+    if (resto > NOTAS_COMPACTAS / 2 || (resto == NOTAS_COMPACTAS / 2 && (inteiro & 1))) {
+        inteiro++;
+    }
+    return inteiro;
+}
+
+// NF como float, para comparar com o modo normal
+float nf_compacta(const AlunoCompacto *aluno) {
+    return aluno->soma / (float) (NOTAS_COMPACTAS * NOTA_ESCALA);
+}
+
+void iniciar_turma_compacta(TurmaCompacta *turma) {
+    turma->alunos = NULL;
+    turma->num_alunos = 0;
+    turma->capacidade_alunos = 0;
+}
+
+void liberar_turma_compacta(TurmaCompacta *turma) {
+    free(turma->alunos);
+    iniciar_turma_compacta(turma);
+}
+
+// Acrescenta um aluno a partir da matrícula, do nome (já na arena_nomes) e das duas avaliações fixas
+// Retorna 1 em caso de sucesso e 0 se faltar memória
+static int adicionar_notas(TurmaCompacta *turma, int matricula, RefTexto nome, const Avaliacao *avaliacoes) {
+    AlunoCompacto *alunos = VETOR_RESERVAR(turma->alunos, turma->capacidade_alunos, turma->num_alunos + 1);
+    if (!alunos) {
+        return 0;
+    }
+    turma->alunos = alunos;
+
+    AlunoCompacto *aluno = &turma->alunos[turma->num_alunos];
+    aluno->matricula = matricula;
+    aluno->nome = nome.deslocamento;
+    for (int a = 0; a < AVALIACOES_FIXAS; a++) {
+        aluno->notas[4 * a + 0] = nota_para_centesimos(avaliacoes[a].ap1);
+        aluno->notas[4 * a + 1] = nota_para_centesimos(avaliacoes[a].ap2);
+        aluno->notas[4 * a + 2] = nota_para_centesimos(avaliacoes[a].ap3);
+        aluno->notas[4 * a + 3] = nota_para_centesimos(avaliacoes[a].np);
+    }
+    calcular_notas_compacto(aluno);
+    turma->num_alunos++;
+    return 1;
+}
+
+// Acrescenta um aluno do modo normal (avaliações que faltarem contam como zero)
+// O nome não é copiado: o registro compacto aponta para o mesmo texto da arena
+int adicionar_aluno_compacto(TurmaCompacta *turma, const Aluno *aluno) {
+    Avaliacao avaliacoes[AVALIACOES_FIXAS];
+    memset(avaliacoes, 0, sizeof(avaliacoes));
+    int num = aluno->num_avaliacoes < AVALIACOES_FIXAS ? aluno->num_avaliacoes : AVALIACOES_FIXAS;
+    if (num > 0) {
+        memcpy(avaliacoes, avaliacoes_aluno(aluno), (size_t) num * sizeof(Avaliacao));
+    }
+    return adicionar_notas(turma, aluno->matricula, aluno->nome, avaliacoes);
+}
+
+// Converte um array de alunos já carregado; retorna 1 em caso de sucesso e 0 se faltar memória
+int converter_para_compacto(TurmaCompacta *turma, const Aluno *alunos, int num_alunos) {
+    iniciar_turma_compacta(turma);
+    for (int i = 0; i < num_alunos; i++) {
+        if (!adicionar_aluno_compacto(turma, &alunos[i])) {
+            liberar_turma_compacta(turma);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Carrega o CSV direto no formato compacto, sem montar o array de Aluno
+// As linhas são lidas como em carregar_alunos_mmap (mesmas regras e mensagens de erro)
+// Retorna 1 em caso de sucesso e 0 se o arquivo não pôde ser lido ou faltou memória
+int carregar_turma_compacta(const char *nome_arquivo, TurmaCompacta *turma) {
+    iniciar_turma_compacta(turma);
+    ArquivoMapeado arquivo;
+    if (!mapear_arquivo(nome_arquivo, &arquivo)) {
+        perror("Erro ao abrir arquivo de alunos");
+        return 0;
+    }
+
+    const char *fim_arquivo = arquivo.dados + arquivo.tamanho;
+    const char *p = csv_fim_linha(arquivo.dados, fim_arquivo);
+    p = p < fim_arquivo ? p + 1 : fim_arquivo;
+
+    int numero_linha = 2;   // O cabeçalho é a linha 1
+    while (p < fim_arquivo) {
+        const char *fim_linha = csv_fim_linha(p, fim_arquivo);
+        Aluno aluno;
+        Avaliacao avaliacoes[AVALIACOES_FIXAS];
+        LinhaCSV campos;
+        iniciar_linha_csv(&campos, p, fim_linha);
+        if (analisar_linha_aluno(&campos, &arena_nomes, &aluno, &avaliacoes[0], &avaliacoes[1])) {
+            if (!adicionar_notas(turma, aluno.matricula, aluno.nome, avaliacoes)) {
+                perror("Erro ao alocar memória para alunos");
+                liberar_turma_compacta(turma);
+                desmapear_arquivo(&arquivo);
+                return 0;
+            }
+        } else {
+            reportar_erro_csv("alunos", numero_linha, &campos);
+        }
+        numero_linha++;
+        p = fim_linha < fim_arquivo ? fim_linha + 1 : fim_arquivo;
+    }
+
+    desmapear_arquivo(&arquivo);
+    // Devolve a capacidade que sobrou no array
+    turma->alunos = VETOR_AJUSTAR(turma->alunos, turma->capacidade_alunos, turma->num_alunos);
+    return 1;
+}
+
+// Ranking pela NF com counting sort: a soma só tem SOMA_MAXIMA_FIXA + 1 valores
+// É estável (empates ficam na ordem do array), como ranking_alunos com DESEMPATE_NENHUM
+// Retorna o array de índices (alocado com malloc) ou NULL se faltar memória
+int *ranking_compacto(const TurmaCompacta *turma, OrdemRanking ordem) {
+    int n = turma->num_alunos;
+    int *indices = (int*) malloc((size_t) (n > 0 ? n : 1) * sizeof(int));
+    int *posicao = (int*) calloc(SOMA_MAXIMA_FIXA + 2, sizeof(int));
+    if (!indices || !posicao) {
+        free(indices);
+        free(posicao);
+        return NULL;
+    }
+
+    // Na ordem decrescente a chave é invertida, então a contagem é sempre crescente
+    for (int i = 0; i < n; i++) {
+        int soma = turma->alunos[i].soma;
+        int chave = ordem == ORDEM_DECRESCENTE ? SOMA_MAXIMA_FIXA - soma : soma;
+        posicao[chave + 1]++;
+    }
+    for (int c = 1; c <= SOMA_MAXIMA_FIXA + 1; c++) {
+        posicao[c] += posicao[c - 1];
+    }
+    for (int i = 0; i < n; i++) {
+        int soma = turma->alunos[i].soma;
+        int chave = ordem == ORDEM_DECRESCENTE ? SOMA_MAXIMA_FIXA - soma : soma;
+        indices[posicao[chave]++] = i;
+    }
+
+    free(posicao);
+    return indices;
+}
+
+// Escreve um aluno compacto no mesmo formato de renderizar_aluno
+static void renderizar_aluno_compacto(Renderizador *r, const AlunoCompacto *aluno) {
+    const char *nome = texto_arena(&arena_nomes, (RefTexto){aluno->nome, 0});
+    const char *status = aluno->status == 1 ? "Aprovado" : "Reprovado";
+    int largura_numero = r->formato == SAIDA_TABELA ? 8 : 0;
+    const char *separador = r->formato == SAIDA_TABELA ? " | " : (r->formato == SAIDA_TSV ? "\t" : ",");
+    size_t tamanho_separador = strlen(separador);
+
+    int vermelho = r->formato == SAIDA_TABELA && r->cor && aluno->status == 0;
+    if (vermelho) {
+        renderizar_texto(r, RED_TEXT, sizeof(RED_TEXT) - 1);
+    }
+    renderizar_int(r, aluno->matricula, r->formato == SAIDA_TABELA ? 10 : 0);
+    renderizar_texto(r, separador, tamanho_separador);
+    renderizar_string(r, nome, r->formato == SAIDA_TABELA ? 30 : 0);
+    for (int i = 0; i < NOTAS_COMPACTAS; i++) {
+        renderizar_texto(r, separador, tamanho_separador);
+        renderizar_centesimos(r, aluno->notas[i], largura_numero);
+    }
+    renderizar_texto(r, separador, tamanho_separador);
+    renderizar_centesimos(r, nf_centesimos(aluno), largura_numero);
+    renderizar_texto(r, separador, tamanho_separador);
+    renderizar_string(r, status, r->formato == SAIDA_TABELA ? 10 : 0);
+    if (vermelho) {
+        renderizar_texto(r, RESET_TEXT, sizeof(RESET_TEXT) - 1);
+    }
+    renderizar_texto(r, "\n", 1);
+}
+
+// Lista os alunos na ordem de "indices" (os "quantidade" primeiros), como listar_alunos
+// Sem "indices", lista na ordem do arquivo
+void listar_turma_compacta(const TurmaCompacta *turma, const int *indices, int quantidade) {
+    if (quantidade == 0) {
+        printf("Nenhum aluno cadastrado.\n");
+        return;
+    }
+
+    Renderizador r;
+    if (!iniciar_renderizador(&r, stdout, formato_saida_padrao, modo_cor_padrao)) {
+        perror("Erro ao alocar memória para a listagem");
+        return;
+    }
+    renderizar_cabecalho(&r);
+    for (int i = 0; i < quantidade; i++) {
+        renderizar_aluno_compacto(&r, &turma->alunos[indices ? indices[i] : i]);
+    }
+    renderizar_rodape(&r);
+    finalizar_renderizador(&r);
+}
+
+// Bytes ocupados pela turma compacta (registros + arena de nomes)
+size_t memoria_turma_compacta(const TurmaCompacta *turma) {
+    return (size_t) turma->num_alunos * sizeof(AlunoCompacto) + arena_nomes.tamanho;
+}
+
+// Bytes ocupados pelos mesmos alunos no modo normal (structs + arena de nomes + avaliações no heap)
+size_t memoria_alunos(const Aluno *alunos, int num_alunos) {
+    size_t total = (size_t) num_alunos * sizeof(Aluno) + arena_nomes.tamanho;
+    for (int i = 0; i < num_alunos; i++) {
+        if (alunos[i].avaliacoes_extras) {
+            total += (size_t) alunos[i].capacidade_avaliacoes * sizeof(Avaliacao);
+        }
+    }
+    return total;
+}
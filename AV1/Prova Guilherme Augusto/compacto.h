@@ -0,0 +1,55 @@
+#ifndef COMPACTO_H
+#define COMPACTO_H
+
+#include <stdint.h>
+#include "utils.h"
+#include "ranking.h"
+#include "renderizador.h"
+
+// Modo compacto: as notas ficam em centésimos (int16, 7.25 -> 725) e cada aluno
+// ocupa um registro de 28 bytes; o nome fica na arena_nomes, como no modo normal, e o
+// registro guarda só a sua posição (o texto termina em '\0')
+//
+// Com as notas inteiras, ajustar para 0..10 e tirar as médias é aritmética exata:
+// a NF é a soma das 8 notas dividida por 800, então só a soma é guardada e a
+// aprovação (NF >= 6) é soma >= 4800, sem nenhum arredondamento de float
+// Diferenças para o modo normal: notas com mais de 2 casas são arredondadas para
+// o centésimo mais próximo, NaN vira 0 e a NF é impressa a partir do valor exato
+// (soma / 8), que às vezes difere na segunda casa da NF em float do modo normal
+
+#define NOTA_ESCALA 100                                     // Centésimos por ponto
+#define NOTA_MAXIMA_FIXA (10 * NOTA_ESCALA)                 // 10.00
+#define NOTAS_COMPACTAS (4 * AVALIACOES_FIXAS)              // ap1, ap2, ap3, np de AV1 e AV2
+#define SOMA_MAXIMA_FIXA (NOTAS_COMPACTAS * NOTA_MAXIMA_FIXA)
+#define SOMA_APROVACAO (6 * NOTAS_COMPACTAS * NOTA_ESCALA)  // NF 6.00
+
+typedef struct {
+    int32_t matricula;
+    uint32_t nome;                      // Posição do nome na arena_nomes
+    int16_t notas[NOTAS_COMPACTAS];     // Centésimos, na ordem das colunas do CSV
+    int16_t soma;                       // Soma das notas ajustadas (NF = soma / 800)
+    uint8_t status;                     // 0: Reprovado, 1: Aprovado
+} AlunoCompacto;
+
+typedef struct {
+    AlunoCompacto *alunos;
+    int num_alunos;
+    int capacidade_alunos;
+} TurmaCompacta;
+
+// Protótipos das funções em compacto.c
+int16_t nota_para_centesimos(float nota);
+void calcular_notas_compacto(AlunoCompacto *aluno);
+int nf_centesimos(const AlunoCompacto *aluno);
+float nf_compacta(const AlunoCompacto *aluno);
+void iniciar_turma_compacta(TurmaCompacta *turma);
+void liberar_turma_compacta(TurmaCompacta *turma);
+int adicionar_aluno_compacto(TurmaCompacta *turma, const Aluno *aluno);
+int converter_para_compacto(TurmaCompacta *turma, const Aluno *alunos, int num_alunos);
+int carregar_turma_compacta(const char *nome_arquivo, TurmaCompacta *turma);
+int *ranking_compacto(const TurmaCompacta *turma, OrdemRanking ordem);
+void listar_turma_compacta(const TurmaCompacta *turma, const int *indices, int quantidade);
+size_t memoria_turma_compacta(const TurmaCompacta *turma);
+size_t memoria_alunos(const Aluno *alunos, int num_alunos);
+
+#endif
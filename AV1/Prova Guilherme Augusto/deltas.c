@@ -0,0 +1,140 @@
+#include "deltas.h"
+
+// Converte o nome do campo ("ap1", "ap2", "ap3" ou "np"); retorna 0 se for inválido
+static int ler_campo_nota(const char *nome, CampoNota *campo) {
+    if (strcmp(nome, "ap1") == 0) {
+        *campo = CAMPO_AP1;
+    } else if (strcmp(nome, "ap2") == 0) {
+        *campo = CAMPO_AP2;
+    } else if (strcmp(nome, "ap3") == 0) {
+        *campo = CAMPO_AP3;
+    } else if (strcmp(nome, "np") == 0) {
+        *campo = CAMPO_NP;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+// Lê o arquivo de deltas; linhas inválidas são informadas e ignoradas
+// Retorna o array de correções (alocado com malloc) ou NULL em caso de erro
+DeltaNota *carregar_deltas(const char *nome_arquivo, int *num_deltas) {
+    FILE *arquivo = fopen(nome_arquivo, "r");
+    if (!arquivo) {
+        perror("Erro ao abrir arquivo de deltas");
+        return NULL;
+    }
+
+    DeltaNota *deltas = NULL;
+    int capacidade = 0;
+    char *linha = NULL;
+    int capacidade_linha = 0;
+    long tamanho_linha;
+    int num_linha = 1;
+    *num_deltas = 0;
+    ler_linha(arquivo, &linha, &capacidade_linha); // Ler e descartar o cabeçalho
+
+    while ((tamanho_linha = ler_linha(arquivo, &linha, &capacidade_linha)) >= 0) {
+        num_linha++;
+        DeltaNota delta;
+        char campo[8];
+        LinhaCSV campos;
+        iniciar_linha_csv(&campos, linha, linha + tamanho_linha);
+        int ok = csv_ler_int(&campos, &delta.matricula) && csv_separador(&campos) &&
+                 csv_ler_int(&campos, &delta.avaliacao) && csv_separador(&campos) &&
+                 csv_ler_texto(&campos, campo, sizeof(campo)) && csv_separador(&campos) &&
+                 csv_ler_float(&campos, &delta.valor);
+        if (ok && delta.avaliacao < 1) {
+            ok = csv_erro_campo(&campos, 2, "avaliação inválida");
+        } else if (ok && !ler_campo_nota(campo, &delta.campo)) {
+            ok = csv_erro_campo(&campos, 3, "campo inválido");
+        }
+        if (!ok) {
+            reportar_erro_csv("deltas", num_linha, &campos);
+            continue;
+        }
+        delta.avaliacao--;
+
+        deltas = VETOR_RESERVAR(deltas, capacidade, (*num_deltas + 1));
+        if (!deltas) {
+            perror("Erro ao alocar memória para os deltas");
+            free(linha);
+            fclose(arquivo);
+            return NULL;
+        }
+        deltas[(*num_deltas)++] = delta;
+    }
+
+    free(linha);
+    fclose(arquivo);
+    if (!deltas) {
+        // Arquivo sem correções: array vazio, mas válido
+        deltas = (DeltaNota*) malloc(sizeof(DeltaNota));
+    }
+    return deltas;
+}
+
+// Aplica as correções: cada aluno corrigido é recalculado (calcular_notas) e
+// movido uma única vez no ranking, depois de todas as suas correções
+// "mudancas" precisa ter espaço para num_deltas itens; cada aluno aparece uma vez,
+// na ordem da primeira correção
+// Retorna o número de alunos alterados, ou -1 se faltar memória
+int aplicar_deltas(const IndiceAlunos *indice, Aluno *alunos, RankingDinamico *ranking,
+                   const DeltaNota *deltas, int num_deltas, MudancaRanking *mudancas) {
+    // Alunos já vistos: matrícula -> posição em "mudancas"
+    IndiceAlunos vistos;
+    if (!criar_indice_alunos(&vistos, num_deltas)) {
+        return -1;
+    }
+
+    // As posições anteriores são lidas antes de qualquer alteração
+    int num_mudancas = 0;
+    for (int i = 0; i < num_deltas; i++) {
+        int aluno = indice_buscar(indice, deltas[i].matricula);
+        if (aluno < 0) {
+            fprintf(stderr, "Matrícula %d do delta %d não encontrada\n", deltas[i].matricula, i + 1);
+            continue;
+        }
+        if (indice_inserir(&vistos, deltas[i].matricula, num_mudancas) == 1) {
+            mudancas[num_mudancas].aluno = aluno;
+            mudancas[num_mudancas].nf_anterior = alunos[aluno].nf;
+            mudancas[num_mudancas].posicao_anterior = posicao_no_ranking(ranking, aluno);
+            num_mudancas++;
+        }
+    }
+
+    for (int i = 0; i < num_deltas; i++) {
+        if (indice_buscar(&vistos, deltas[i].matricula) < 0) {
+            continue;
+        }
+        if (!atualizar_nota_aluno(indice, alunos, deltas[i].matricula, deltas[i].avaliacao,
+                                  deltas[i].campo, deltas[i].valor)) {
+            fprintf(stderr, "Avaliação %d do delta %d não existe para a matrícula %d\n",
+                    deltas[i].avaliacao + 1, i + 1, deltas[i].matricula);
+        }
+    }
+
+    for (int i = 0; i < num_mudancas; i++) {
+        atualizar_ranking_dinamico(ranking, mudancas[i].aluno, alunos[mudancas[i].aluno].nf);
+    }
+    for (int i = 0; i < num_mudancas; i++) {
+        mudancas[i].posicao_nova = posicao_no_ranking(ranking, mudancas[i].aluno);
+    }
+
+    liberar_indice_alunos(&vistos);
+    return num_mudancas;
+}
+
+// Imprime a NF e a posição no ranking de cada aluno corrigido, antes e depois
+void imprimir_mudancas_ranking(FILE *saida, const Aluno *alunos, const MudancaRanking *mudancas, int num_mudancas) {
+    fprintf(saida, "\n%-10s| %-30s | %-9s | %-9s | %-13s | %-13s | %-8s\n",
+            " Matricula ", "Nome", "NF antes", "NF nova", "Posicao antes", "Posicao nova", "Variacao");
+    fprintf(saida, "-----------|--------------------------------|-----------|-----------|---------------|---------------|----------\n");
+    for (int i = 0; i < num_mudancas; i++) {
+        const Aluno *aluno = &alunos[mudancas[i].aluno];
+        fprintf(saida, "%-10d | %-30s | %-9.2f | %-9.2f | %-13d | %-13d | %+d\n", aluno->matricula, nome_aluno(aluno),
+                mudancas[i].nf_anterior, aluno->nf, mudancas[i].posicao_anterior, mudancas[i].posicao_nova,
+                mudancas[i].posicao_anterior - mudancas[i].posicao_nova);
+    }
+    fprintf(saida, "\n");
+}
@@ -0,0 +1,34 @@
+#ifndef DELTAS_H
+#define DELTAS_H
+
+#include "utils.h"
+#include "indice.h"
+#include "ranking_dinamico.h"
+
+// Correções de notas aplicadas sem recarregar o notas.csv
+// O arquivo de deltas tem o cabeçalho "matricula,avaliacao,campo,valor" e uma correção
+// por linha, por exemplo "12345,2,np,7.5" (avaliação 1 = AV1, 2 = AV2; campo ap1, ap2, ap3 ou np)
+// Só os alunos corrigidos são recalculados e movidos no ranking dinâmico
+
+typedef struct {
+    int matricula;
+    int avaliacao;      // A partir de 0 (a linha "1" do arquivo vira 0)
+    CampoNota campo;
+    float valor;
+} DeltaNota;
+
+// Efeito das correções sobre um aluno
+typedef struct {
+    int aluno;              // Posição do aluno no array
+    float nf_anterior;
+    int posicao_anterior;   // Posição no ranking antes das correções (a partir de 1)
+    int posicao_nova;       // Posição no ranking depois das correções
+} MudancaRanking;
+
+// Protótipos das funções em deltas.c
+DeltaNota *carregar_deltas(const char *nome_arquivo, int *num_deltas);
+int aplicar_deltas(const IndiceAlunos *indice, Aluno *alunos, RankingDinamico *ranking,
+                   const DeltaNota *deltas, int num_deltas, MudancaRanking *mudancas);
+void imprimir_mudancas_ranking(FILE *saida, const Aluno *alunos, const MudancaRanking *mudancas, int num_mudancas);
+
+#endif
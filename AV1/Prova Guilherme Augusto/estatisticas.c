@@ -0,0 +1,365 @@
+#include "estatisticas.h"
+
+#include <math.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Menor número de alunos por thread (abaixo disso criar threads não compensa)
+#define ESTATISTICAS_MIN_POR_THREAD 65536
+
+// Faixa de alunos de uma thread e as estatísticas parciais dela
+typedef struct {
+    int inicio;
+    int fim;
+    EstatisticasNotas parcial;
+} FaixaEstatisticas;
+
+// Coluna "c" da tabela: ap1, ap2, ap3 e np de cada avaliação e, por último, nf
+static const float *coluna_tabela(const TabelaNotas *tabela, int c) {
+    if (c == ESTATISTICAS_COLUNAS - 1) {
+        return tabela->nf;
+    }
+    int a = c / 4;
+    switch (c % 4) {
+        case 0: return tabela->ap1[a];
+        case 1: return tabela->ap2[a];
+        case 2: return tabela->ap3[a];
+        default: return tabela->np[a];
+    }
+}
+
+static void iniciar_acumulador(AcumuladorColuna *coluna) {
+    memset(coluna, 0, sizeof(AcumuladorColuna));
+    coluna->min = INFINITY;
+    coluna->max = -INFINITY;
+}
+
+// Faixa do histograma de 0 a 10 (10 entra na última)
+static int indice_faixa(float x) {
+    if (x <= 0) return 0;
+    if (x >= ESTATISTICAS_FAIXAS - 1) return ESTATISTICAS_FAIXAS - 1;
+    return (int) x;
+}
+
+// Centésimo mais próximo (x * 100 é exato em double)
+static int indice_centesimo(float x) {
+    double d = (double) x * 100.0 + 0.5;
+    if (d < 1) return 0;
+    if (d >= ESTATISTICAS_CENTESIMOS - 1) return ESTATISTICAS_CENTESIMOS - 1;
+    return (int) d;
+}
+
+// Acumula um valor (usado no resto das colunas e em blocos com NaN)
+static void acumular_valor(AcumuladorColuna *coluna, float x) {
+    if (x != x) {
+        coluna->invalidos++;
+        return;
+    }
+    coluna->contagem++;
+    coluna->soma += x;
+    coluna->soma_quadrados += (double) x * x;
+    if (x < coluna->min) coluna->min = x;
+    if (x > coluna->max) coluna->max = x;
+    coluna->faixas[indice_faixa(x)]++;
+    coluna->centesimos[indice_centesimo(x)]++;
+}
+
+// Acumula "n" valores de uma coluna
+// Soma, soma dos quadrados (em double), mínimo e máximo ficam em registradores SIMD;
+// os índices dos histogramas também são calculados com SIMD e só a contagem é escalar
+static void acumular_coluna(AcumuladorColuna *coluna, const float *valores, int n) {
+    int i = 0;
+
+#if defined(__AVX2__)
+    // 8 valores por instrução
+    __m256 vmin = _mm256_set1_ps(INFINITY);
+    __m256 vmax = _mm256_set1_ps(-INFINITY);
+    __m256d soma = _mm256_setzero_pd();
+    __m256d quadrados = _mm256_setzero_pd();
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 ultima_faixa = _mm256_set1_ps(ESTATISTICAS_FAIXAS - 1);
+    const __m256d cem = _mm256_set1_pd(100.0);
+    const __m256d meio = _mm256_set1_pd(0.5);
+    const __m256d zero_d = _mm256_setzero_pd();
+    const __m256d ultimo_centesimo = _mm256_set1_pd(ESTATISTICAS_CENTESIMOS - 1);
+    int faixas[8], centesimos[8];
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(valores + i);
+        if (_mm256_movemask_ps(_mm256_cmp_ps(v, v, _CMP_ORD_Q)) != 0xff) {
+            // Bloco com NaN: valor a valor
+            for (int k = 0; k < 8; k++) {
+                acumular_valor(coluna, valores[i + k]);
+            }
+            continue;
+        }
+        vmin = _mm256_min_ps(vmin, v);
+        vmax = _mm256_max_ps(vmax, v);
+        __m256d baixo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+        __m256d alto = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+        soma = _mm256_add_pd(soma, _mm256_add_pd(baixo, alto));
+        quadrados = _mm256_add_pd(quadrados, _mm256_add_pd(_mm256_mul_pd(baixo, baixo), _mm256_mul_pd(alto, alto)));
+
+        _mm256_storeu_si256((__m256i*) faixas, _mm256_cvttps_epi32(_mm256_min_ps(ultima_faixa, _mm256_max_ps(zero, v))));
+        __m256d c_baixo = _mm256_min_pd(ultimo_centesimo, _mm256_max_pd(zero_d, _mm256_add_pd(_mm256_mul_pd(baixo, cem), meio)));
+        __m256d c_alto = _mm256_min_pd(ultimo_centesimo, _mm256_max_pd(zero_d, _mm256_add_pd(_mm256_mul_pd(alto, cem), meio)));
+        _mm_storeu_si128((__m128i*) centesimos, _mm256_cvttpd_epi32(c_baixo));
+        _mm_storeu_si128((__m128i*) (centesimos + 4), _mm256_cvttpd_epi32(c_alto));
+        for (int k = 0; k < 8; k++) {
+            coluna->faixas[faixas[k]]++;
+            coluna->centesimos[centesimos[k]]++;
+        }
+        coluna->contagem += 8;
+    }
+
+    float min[8], max[8];
+    double somas[4], somas_quadrados[4];
+    _mm256_storeu_ps(min, vmin);
+    _mm256_storeu_ps(max, vmax);
+    _mm256_storeu_pd(somas, soma);
+    _mm256_storeu_pd(somas_quadrados, quadrados);
+    for (int k = 0; k < 8; k++) {
+        if (min[k] < coluna->min) coluna->min = min[k];
+        if (max[k] > coluna->max) coluna->max = max[k];
+    }
+    for (int k = 0; k < 4; k++) {
+        coluna->soma += somas[k];
+        coluna->soma_quadrados += somas_quadrados[k];
+    }
+#elif defined(__SSE2__)
+    // 4 valores por instrução
+    __m128 vmin = _mm_set1_ps(INFINITY);
+    __m128 vmax = _mm_set1_ps(-INFINITY);
+    __m128d soma = _mm_setzero_pd();
+    __m128d quadrados = _mm_setzero_pd();
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 ultima_faixa = _mm_set1_ps(ESTATISTICAS_FAIXAS - 1);
+    const __m128d cem = _mm_set1_pd(100.0);
+    const __m128d meio = _mm_set1_pd(0.5);
+    const __m128d zero_d = _mm_setzero_pd();
+    const __m128d ultimo_centesimo = _mm_set1_pd(ESTATISTICAS_CENTESIMOS - 1);
+    int faixas[4], centesimos[4];
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(valores + i);
+        if (_mm_movemask_ps(_mm_cmpord_ps(v, v)) != 0xf) {
+            // Bloco com NaN: valor a valor
+            for (int k = 0; k < 4; k++) {
+                acumular_valor(coluna, valores[i + k]);
+            }
+            continue;
+        }
+        vmin = _mm_min_ps(vmin, v);
+        vmax = _mm_max_ps(vmax, v);
+        __m128d baixo = _mm_cvtps_pd(v);
+        __m128d alto = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+        soma = _mm_add_pd(soma, _mm_add_pd(baixo, alto));
+        quadrados = _mm_add_pd(quadrados, _mm_add_pd(_mm_mul_pd(baixo, baixo), _mm_mul_pd(alto, alto)));
+
+        _mm_storeu_si128((__m128i*) faixas, _mm_cvttps_epi32(_mm_min_ps(ultima_faixa, _mm_max_ps(zero, v))));
+        __m128d c_baixo = _mm_min_pd(ultimo_centesimo, _mm_max_pd(zero_d, _mm_add_pd(_mm_mul_pd(baixo, cem), meio)));
+        __m128d c_alto = _mm_min_pd(ultimo_centesimo, _mm_max_pd(zero_d, _mm_add_pd(_mm_mul_pd(alto, cem), meio)));
+        _mm_storeu_si128((__m128i*) centesimos, _mm_unpacklo_epi64(_mm_cvttpd_epi32(c_baixo), _mm_cvttpd_epi32(c_alto)));
+        for (int k = 0; k < 4; k++) {
+            coluna->faixas[faixas[k]]++;
+            coluna->centesimos[centesimos[k]]++;
+        }
+        coluna->contagem += 4;
+    }
+
+    float min[4], max[4];
+    double somas[2], somas_quadrados[2];
+    _mm_storeu_ps(min, vmin);
+    _mm_storeu_ps(max, vmax);
+    _mm_storeu_pd(somas, soma);
+    _mm_storeu_pd(somas_quadrados, quadrados);
+    for (int k = 0; k < 4; k++) {
+        if (min[k] < coluna->min) coluna->min = min[k];
+        if (max[k] > coluna->max) coluna->max = max[k];
+    }
+    for (int k = 0; k < 2; k++) {
+        coluna->soma += somas[k];
+        coluna->soma_quadrados += somas_quadrados[k];
+    }
+#endif
+
+    // Valores restantes (ou todos, sem SIMD)
+    for (; i < n; i++) {
+        acumular_valor(coluna, valores[i]);
+    }
+}
+
+// Soma os acumuladores de "origem" em "destino"
+static void juntar_acumuladores(AcumuladorColuna *destino, const AcumuladorColuna *origem) {
+    destino->contagem += origem->contagem;
+    destino->invalidos += origem->invalidos;
+    destino->soma += origem->soma;
+    destino->soma_quadrados += origem->soma_quadrados;
+    if (origem->min < destino->min) destino->min = origem->min;
+    if (origem->max > destino->max) destino->max = origem->max;
+    for (int k = 0; k < ESTATISTICAS_FAIXAS; k++) {
+        destino->faixas[k] += origem->faixas[k];
+    }
+    for (int k = 0; k < ESTATISTICAS_CENTESIMOS; k++) {
+        destino->centesimos[k] += origem->centesimos[k];
+    }
+}
+
+// Função de cada thread: acumula todas as colunas da sua faixa de alunos
+static void acumular_faixa(PedacoArquivo *pedaco) {
+    const TabelaNotas *tabela = (const TabelaNotas*) pedaco->contexto;
+    FaixaEstatisticas *faixa = (FaixaEstatisticas*) pedaco->resultado;
+    for (int c = 0; c < ESTATISTICAS_COLUNAS; c++) {
+        iniciar_acumulador(&faixa->parcial.colunas[c]);
+        acumular_coluna(&faixa->parcial.colunas[c], coluna_tabela(tabela, c) + faixa->inicio, faixa->fim - faixa->inicio);
+    }
+}
+
+// Calcula as estatísticas de todas as colunas da tabela em uma passada
+// Os alunos são divididos entre num_threads threads (0 = número de processadores),
+// usando o mesmo executor dos carregadores paralelos (paralelo.c)
+// Retorna 1 em caso de sucesso e 0 se faltar memória
+int calcular_estatisticas(const TabelaNotas *tabela, int num_threads, EstatisticasNotas *estatisticas) {
+    int n = tabela->num_alunos;
+    int num_faixas = numero_threads(num_threads);
+    if (num_faixas > n / ESTATISTICAS_MIN_POR_THREAD) {
+        num_faixas = n / ESTATISTICAS_MIN_POR_THREAD > 0 ? n / ESTATISTICAS_MIN_POR_THREAD : 1;
+    }
+
+    PedacoArquivo pedacos[MAX_THREADS];
+    int ok = 1;
+    for (int i = 0; i < num_faixas; i++) {
+        memset(&pedacos[i], 0, sizeof(PedacoArquivo));
+        FaixaEstatisticas *faixa = (FaixaEstatisticas*) malloc(sizeof(FaixaEstatisticas));
+        if (!faixa) {
+            ok = 0;
+            continue;
+        }
+        faixa->inicio = (int) ((long long) n * i / num_faixas);
+        faixa->fim = (int) ((long long) n * (i + 1) / num_faixas);
+        pedacos[i].contexto = (void*) tabela;
+        pedacos[i].resultado = faixa;
+    }
+
+    if (ok) {
+        processar_pedacos(pedacos, num_faixas, acumular_faixa);
+
+        estatisticas->num_alunos = n;
+        for (int c = 0; c < ESTATISTICAS_COLUNAS; c++) {
+            iniciar_acumulador(&estatisticas->colunas[c]);
+            for (int i = 0; i < num_faixas; i++) {
+                const FaixaEstatisticas *faixa = (const FaixaEstatisticas*) pedacos[i].resultado;
+                juntar_acumuladores(&estatisticas->colunas[c], &faixa->parcial.colunas[c]);
+            }
+        }
+    }
+
+    liberar_pedacos(pedacos, num_faixas);
+    return ok;
+}
+
+double media_coluna(const AcumuladorColuna *coluna) {
+    return coluna->contagem > 0 ? coluna->soma / coluna->contagem : 0.0;
+}
+
+// Desvio padrão populacional
+double desvio_padrao_coluna(const AcumuladorColuna *coluna) {
+    if (coluna->contagem == 0) {
+        return 0.0;
+    }
+    double media = media_coluna(coluna);
+    double variancia = coluna->soma_quadrados / coluna->contagem - media * media;
+    return variancia > 0 ? sqrt(variancia) : 0.0;
+}
+
+// Percentil (0 a 100) pelo critério do posto mais próximo, lido do histograma de centésimos
+float percentil_coluna(const AcumuladorColuna *coluna, double percentil) {
+    if (coluna->contagem == 0) {
+        return 0.0f;
+    }
+    long long posto = (long long) ceil(percentil / 100.0 * coluna->contagem);
+    if (posto < 1) {
+        posto = 1;
+    }
+    long long acumulado = 0;
+    for (int k = 0; k < ESTATISTICAS_CENTESIMOS; k++) {
+        acumulado += coluna->centesimos[k];
+        if (acumulado >= posto) {
+            return k / 100.0f;
+        }
+    }
+    return (ESTATISTICAS_CENTESIMOS - 1) / 100.0f;
+}
+
+static const double percentis_impressos[] = {10, 25, 50, 75, 90};
+#define NUM_PERCENTIS (int) (sizeof(percentis_impressos) / sizeof(percentis_impressos[0]))
+
+// Imprime as estatísticas em tabela ou em CSV/TSV (uma linha por coluna de notas)
+void imprimir_estatisticas(FILE *saida, const EstatisticasNotas *estatisticas, FormatoSaida formato) {
+    static const char *nomes_tabela[ESTATISTICAS_COLUNAS] = {
+        "AV1:AP1", "AV1:AP2", "AV1:AP3", "NP1", "AV2:AP1", "AV2:AP2", "AV2:AP3", "NP2", "NF"
+    };
+    static const char *nomes_csv[ESTATISTICAS_COLUNAS] = {
+        "av1ap1", "av1ap2", "av1ap3", "np1", "av2ap1", "av2ap2", "av2ap3", "np2", "nf"
+    };
+
+    if (formato != SAIDA_TABELA) {
+        char sep = formato == SAIDA_TSV ? '\t' : ',';
+        fprintf(saida, "coluna%cvalidos%cinvalidos%cmedia%cdesvio%cmin%cmax", sep, sep, sep, sep, sep, sep);
+        for (int p = 0; p < NUM_PERCENTIS; p++) {
+            fprintf(saida, "%cp%.0f", sep, percentis_impressos[p]);
+        }
+        for (int k = 0; k < ESTATISTICAS_FAIXAS; k++) {
+            fprintf(saida, "%cfaixa_%d_%d", sep, k, k + 1);
+        }
+        fprintf(saida, "\n");
+        for (int c = 0; c < ESTATISTICAS_COLUNAS; c++) {
+            const AcumuladorColuna *coluna = &estatisticas->colunas[c];
+            fprintf(saida, "%s%c%lld%c%lld%c%.4f%c%.4f%c%.2f%c%.2f", nomes_csv[c], sep, coluna->contagem, sep,
+                    coluna->invalidos, sep, media_coluna(coluna), sep, desvio_padrao_coluna(coluna), sep,
+                    coluna->contagem ? coluna->min : 0.0f, sep, coluna->contagem ? coluna->max : 0.0f);
+            for (int p = 0; p < NUM_PERCENTIS; p++) {
+                fprintf(saida, "%c%.2f", sep, percentil_coluna(coluna, percentis_impressos[p]));
+            }
+            for (int k = 0; k < ESTATISTICAS_FAIXAS; k++) {
+                fprintf(saida, "%c%lld", sep, coluna->faixas[k]);
+            }
+            fprintf(saida, "\n");
+        }
+        return;
+    }
+
+    fprintf(saida, "\nEstatisticas da turma (%d alunos)\n\n", estatisticas->num_alunos);
+    fprintf(saida, "%-8s | %-8s | %-8s | %-6s | %-6s", "Coluna", "Media", "Desvio", "Min", "Max");
+    for (int p = 0; p < NUM_PERCENTIS; p++) {
+        fprintf(saida, " | P%-5.0f", percentis_impressos[p]);
+    }
+    fprintf(saida, "\n");
+    for (int c = 0; c < ESTATISTICAS_COLUNAS; c++) {
+        const AcumuladorColuna *coluna = &estatisticas->colunas[c];
+        fprintf(saida, "%-8s | %-8.2f | %-8.2f | %-6.2f | %-6.2f", nomes_tabela[c], media_coluna(coluna),
+                desvio_padrao_coluna(coluna), coluna->contagem ? coluna->min : 0.0f, coluna->contagem ? coluna->max : 0.0f);
+        for (int p = 0; p < NUM_PERCENTIS; p++) {
+            fprintf(saida, " | %-6.2f", percentil_coluna(coluna, percentis_impressos[p]));
+        }
+        fprintf(saida, "\n");
+    }
+
+    fprintf(saida, "\nHistograma (alunos por faixa de nota)\n\n%-8s", "Coluna");
+    for (int k = 0; k < ESTATISTICAS_FAIXAS; k++) {
+        char faixa[16];
+        snprintf(faixa, sizeof(faixa), "%d-%d", k, k + 1);
+        fprintf(saida, " | %-9s", faixa);
+    }
+    fprintf(saida, "\n");
+    for (int c = 0; c < ESTATISTICAS_COLUNAS; c++) {
+        fprintf(saida, "%-8s", nomes_tabela[c]);
+        for (int k = 0; k < ESTATISTICAS_FAIXAS; k++) {
+            fprintf(saida, " | %-9lld", estatisticas->colunas[c].faixas[k]);
+        }
+        fprintf(saida, "\n");
+    }
+    fprintf(saida, "\n");
+}
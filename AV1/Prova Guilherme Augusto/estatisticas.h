@@ -0,0 +1,46 @@
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+#include "utils.h"
+#include "tabela_notas.h"
+#include "renderizador.h"
+
+// Estatísticas da turma em uma única passada pela tabela de notas (em colunas):
+// média, desvio padrão, mínimo, máximo, percentis e histograma de 0 a 10 de cada
+// nota das avaliações e da NF. Cada thread acumula uma faixa de alunos com SIMD
+// e os resultados parciais são somados no final
+//
+// Os percentis vêm de um histograma fino (um compartimento por centésimo de 0 a 10),
+// então o erro é de no máximo 0,005 e é zero para notas com até 2 casas decimais
+// Valores fora de 0..10 (tabela ainda não calculada) entram nos compartimentos das pontas
+// NaN não entra em nenhuma estatística, só na contagem de inválidos
+
+#define ESTATISTICAS_COLUNAS (4 * AVALIACOES_FIXAS + 1)    // Notas das avaliações + NF
+#define ESTATISTICAS_CENTESIMOS 1001                        // Compartimentos de 0,00 a 10,00
+#define ESTATISTICAS_FAIXAS 10                              // Histograma [0,1), [1,2), ..., [9,10]
+
+// Acumuladores de uma coluna
+typedef struct {
+    long long contagem;                         // Valores válidos
+    long long invalidos;                        // Valores NaN
+    double soma;
+    double soma_quadrados;
+    float min;
+    float max;
+    long long faixas[ESTATISTICAS_FAIXAS];
+    long long centesimos[ESTATISTICAS_CENTESIMOS];
+} AcumuladorColuna;
+
+typedef struct {
+    int num_alunos;
+    AcumuladorColuna colunas[ESTATISTICAS_COLUNAS]; // ap1, ap2, ap3, np de cada avaliação e nf
+} EstatisticasNotas;
+
+// Protótipos das funções em estatisticas.c
+int calcular_estatisticas(const TabelaNotas *tabela, int num_threads, EstatisticasNotas *estatisticas);
+double media_coluna(const AcumuladorColuna *coluna);
+double desvio_padrao_coluna(const AcumuladorColuna *coluna);
+float percentil_coluna(const AcumuladorColuna *coluna, double percentil);
+void imprimir_estatisticas(FILE *saida, const EstatisticasNotas *estatisticas, FormatoSaida formato);
+
+#endif
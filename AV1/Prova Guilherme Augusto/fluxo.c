@@ -0,0 +1,78 @@
+#include "fluxo.h"
+
+// Lê os alunos de "entrada" um por vez, calcula as notas como calcular_notas
+// e imprime cada um pelo renderizador "saida" (tabela, CSV ou TSV)
+// O resumo (aprovação, média, mínimo e máximo) é acumulado em "resumo"
+// Retorna 1 em caso de sucesso e 0 se o arquivo estiver vazio
+int processar_alunos_fluxo(FILE *entrada, Renderizador *saida, ResumoFluxo *resumo) {
+    char *linha = NULL;
+    int capacidade = 0;
+    memset(resumo, 0, sizeof(ResumoFluxo));
+
+    // Pula o cabeçalho
+    if (ler_linha(entrada, &linha, &capacidade) < 0) {
+        free(linha);
+        return 0;
+    }
+
+    renderizar_cabecalho(saida);
+
+    // O nome de cada aluno é descartado da arena depois de impresso, para a memória não crescer
+    size_t marca = arena_marca(&arena_nomes);
+    long tamanho;
+    int num_linha = 1;
+    while ((tamanho = ler_linha(entrada, &linha, &capacidade)) >= 0) {
+        num_linha++;
+        arena_descartar(&arena_nomes, marca);
+
+        Aluno aluno;
+        Avaliacao avaliacao1;
+        Avaliacao avaliacao2;
+        LinhaCSV campos;
+        iniciar_linha_csv(&campos, linha, linha + tamanho);
+        if (!analisar_linha_aluno(&campos, &arena_nomes, &aluno, &avaliacao1, &avaliacao2)) {
+            reportar_erro_csv("alunos", num_linha, &campos);
+            resumo->linhas_com_erro++;
+            continue;
+        }
+
+        // As duas avaliações ficam dentro do próprio aluno: nenhuma alocação por linha
+        aluno.avaliacoes_extras = NULL;
+        aluno.num_avaliacoes = 0;
+        aluno.capacidade_avaliacoes = 0;
+        adicionar_avaliacoes(&aluno, avaliacao1);
+        adicionar_avaliacoes(&aluno, avaliacao2);
+        calcular_notas(&aluno);
+
+        renderizar_aluno(saida, &aluno);
+
+        // Atualiza o resumo
+        if (resumo->total == 0 || aluno.nf < resumo->min_nf) {
+            resumo->min_nf = aluno.nf;
+        }
+        if (resumo->total == 0 || aluno.nf > resumo->max_nf) {
+            resumo->max_nf = aluno.nf;
+        }
+        resumo->total++;
+        resumo->aprovados += aluno.status == 1;
+        resumo->soma_nf += aluno.nf;
+    }
+
+    arena_descartar(&arena_nomes, marca);
+    free(linha);
+    return 1;
+}
+
+// Imprime o resumo acumulado pelo processamento em fluxo
+void imprimir_resumo_fluxo(FILE *saida, const ResumoFluxo *resumo) {
+    fprintf(saida, "\nAlunos processados: %lld\n", resumo->total);
+    if (resumo->total > 0) {
+        fprintf(saida, "Aprovados: %lld (%.2f%%)\n", resumo->aprovados, 100.0 * resumo->aprovados / resumo->total);
+        fprintf(saida, "Media da NF: %.2f\n", resumo->soma_nf / resumo->total);
+        fprintf(saida, "Menor NF: %.2f\n", resumo->min_nf);
+        fprintf(saida, "Maior NF: %.2f\n", resumo->max_nf);
+    }
+    if (resumo->linhas_com_erro > 0) {
+        fprintf(saida, "Linhas com erro: %lld\n", resumo->linhas_com_erro);
+    }
+}
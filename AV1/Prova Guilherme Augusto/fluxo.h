@@ -0,0 +1,25 @@
+#ifndef FLUXO_H
+#define FLUXO_H
+
+#include "utils.h"
+#include "renderizador.h"
+
+// Processamento de notas em fluxo (streaming): cada linha é lida, calculada e
+// impressa antes da próxima, sem guardar os alunos. A memória usada é constante
+// (só o buffer da maior linha), então o arquivo pode ser maior que a RAM
+
+// Estatísticas acumuladas durante o processamento
+typedef struct {
+    long long total;            // Alunos processados
+    long long aprovados;        // Alunos com status 1
+    long long linhas_com_erro;  // Linhas que não puderam ser lidas
+    double soma_nf;             // Soma das notas finais (para a média)
+    float min_nf;               // Menor nota final
+    float max_nf;               // Maior nota final
+} ResumoFluxo;
+
+// Protótipos das funções em fluxo.c
+int processar_alunos_fluxo(FILE *entrada, Renderizador *saida, ResumoFluxo *resumo);
+void imprimir_resumo_fluxo(FILE *saida, const ResumoFluxo *resumo);
+
+#endif
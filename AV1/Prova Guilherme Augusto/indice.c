@@ -0,0 +1,232 @@
+#include "indice.h"
+
+// Espalha os bits da matrícula (matrículas costumam ser sequenciais)
+static unsigned int hash_matricula(int matricula) {
+    unsigned int h = (unsigned int) matricula * 2654435769u;
+    return h ^ (h >> 16);
+}
+
+// Aloca as entradas para "capacidade" posições, todas vazias
+static EntradaIndice *alocar_entradas(int capacidade) {
+    EntradaIndice *entradas = (EntradaIndice*) malloc((size_t) capacidade * sizeof(EntradaIndice));
+    if (!entradas) {
+        return NULL;
+    }
+    for (int i = 0; i < capacidade; i++) {
+        entradas[i].matricula = 0;
+        entradas[i].posicao = INDICE_VAZIO;
+        entradas[i].repeticoes = 0;
+    }
+    return entradas;
+}
+
+// Cria um índice vazio com espaço para "num_alunos" matrículas sem crescer
+// Retorna 1 em caso de sucesso e 0 se faltar memória
+int criar_indice_alunos(IndiceAlunos *indice, int num_alunos) {
+    int capacidade = 16;
+    while (capacidade < 2 * num_alunos + 2) {
+        capacidade *= 2;
+    }
+    indice->entradas = alocar_entradas(capacidade);
+    indice->capacidade = indice->entradas ? capacidade : 0;
+    indice->num_itens = 0;
+    indice->num_removidos = 0;
+    indice->num_duplicadas = 0;
+    return indice->entradas != NULL;
+}
+
+// Libera a memória do índice
+void liberar_indice_alunos(IndiceAlunos *indice) {
+    free(indice->entradas);
+    indice->entradas = NULL;
+    indice->capacidade = 0;
+    indice->num_itens = 0;
+    indice->num_removidos = 0;
+    indice->num_duplicadas = 0;
+}
+
+// Procura a entrada da matrícula; retorna o seu índice ou -1 se não estiver no índice
+static int procurar_entrada(const IndiceAlunos *indice, int matricula) {
+    if (indice->capacidade == 0) {
+        return -1;
+    }
+    unsigned int mascara = (unsigned int) indice->capacidade - 1;
+    unsigned int i = hash_matricula(matricula) & mascara;
+    while (indice->entradas[i].posicao != INDICE_VAZIO) {
+        if (indice->entradas[i].posicao >= 0 && indice->entradas[i].matricula == matricula) {
+            return (int) i;
+        }
+        i = (i + 1) & mascara;
+    }
+    return -1;
+}
+
+// Reconstrói o índice com "capacidade" entradas, descartando as removidas
+static int redimensionar_indice(IndiceAlunos *indice, int capacidade) {
+    EntradaIndice *entradas = alocar_entradas(capacidade);
+    if (!entradas) {
+        return 0;
+    }
+    unsigned int mascara = (unsigned int) capacidade - 1;
+    for (int j = 0; j < indice->capacidade; j++) {
+        if (indice->entradas[j].posicao < 0) {
+            continue;
+        }
+        unsigned int i = hash_matricula(indice->entradas[j].matricula) & mascara;
+        while (entradas[i].posicao != INDICE_VAZIO) {
+            i = (i + 1) & mascara;
+        }
+        entradas[i] = indice->entradas[j];
+    }
+    free(indice->entradas);
+    indice->entradas = entradas;
+    indice->capacidade = capacidade;
+    indice->num_removidos = 0;
+    return 1;
+}
+
+// Associa a matrícula à posição no array de alunos
+// Retorna 1 se inseriu, 0 se a matrícula já existe (o índice não muda) e -1 se faltar memória
+int indice_inserir(IndiceAlunos *indice, int matricula, int posicao) {
+    if (procurar_entrada(indice, matricula) >= 0) {
+        return 0;
+    }
+
+    // Mantém a ocupação abaixo de 1/2; se a maior parte for de removidos, só limpa
+    if (2 * (indice->num_itens + indice->num_removidos + 1) > indice->capacidade) {
+        int capacidade = indice->capacidade > 0 ? indice->capacidade : 16;
+        while (2 * (indice->num_itens + 1) > capacidade / 2) {
+            capacidade *= 2;
+        }
+        if (!redimensionar_indice(indice, capacidade)) {
+            return -1;
+        }
+    }
+
+    unsigned int mascara = (unsigned int) indice->capacidade - 1;
+    unsigned int i = hash_matricula(matricula) & mascara;
+    while (indice->entradas[i].posicao >= 0) {
+        i = (i + 1) & mascara;
+    }
+    if (indice->entradas[i].posicao == INDICE_REMOVIDO) {
+        indice->num_removidos--;
+    }
+    indice->entradas[i].matricula = matricula;
+    indice->entradas[i].posicao = posicao;
+    indice->entradas[i].repeticoes = 0;
+    indice->num_itens++;
+    return 1;
+}
+
+// Retorna a posição do aluno com a matrícula no array, ou -1 se não existir
+int indice_buscar(const IndiceAlunos *indice, int matricula) {
+    int i = procurar_entrada(indice, matricula);
+    return i >= 0 ? indice->entradas[i].posicao : -1;
+}
+
+// Retira a matrícula do índice (a entrada fica marcada como removida)
+// Retorna 1 se a matrícula estava no índice e 0 caso contrário
+int indice_remover(IndiceAlunos *indice, int matricula) {
+    int i = procurar_entrada(indice, matricula);
+    if (i < 0) {
+        return 0;
+    }
+    indice->entradas[i].posicao = INDICE_REMOVIDO;
+    indice->num_itens--;
+    indice->num_removidos++;
+    return 1;
+}
+
+// Cria o índice de um array de alunos já carregado
+// Matrículas repetidas são informadas em stderr; fica valendo a primeira ocorrência
+// Retorna o número de matrículas duplicadas, ou -1 se faltar memória
+int construir_indice_alunos(IndiceAlunos *indice, const Aluno *alunos, int num_alunos) {
+    if (!criar_indice_alunos(indice, num_alunos)) {
+        return -1;
+    }
+    int duplicadas = 0;
+    for (int i = 0; i < num_alunos; i++) {
+        int resultado = indice_inserir(indice, alunos[i].matricula, i);
+        if (resultado < 0) {
+            liberar_indice_alunos(indice);
+            return -1;
+        }
+        if (resultado == 0) {
+            EntradaIndice *entrada = &indice->entradas[procurar_entrada(indice, alunos[i].matricula)];
+            fprintf(stderr, "Matrícula %d duplicada (alunos %d e %d do arquivo)\n",
+                    alunos[i].matricula, entrada->posicao + 1, i + 1);
+            entrada->repeticoes++;
+            duplicadas++;
+        }
+    }
+    indice->num_duplicadas = duplicadas;
+    return duplicadas;
+}
+
+// Retorna o aluno com a matrícula, ou NULL se não existir
+Aluno *buscar_aluno(const IndiceAlunos *indice, Aluno *alunos, int matricula) {
+    int posicao = indice_buscar(indice, matricula);
+    return posicao >= 0 ? &alunos[posicao] : NULL;
+}
+
+// Corrige uma nota (campo da avaliação de número "avaliacao", a partir de 0) e
+// recalcula nf e status com calcular_notas
+// Retorna 1 em caso de sucesso e 0 se o aluno ou a avaliação não existirem
+int atualizar_nota_aluno(const IndiceAlunos *indice, Aluno *alunos, int matricula,
+                         int avaliacao, CampoNota campo, float valor) {
+    Aluno *aluno = buscar_aluno(indice, alunos, matricula);
+    if (!aluno || avaliacao < 0 || avaliacao >= aluno->num_avaliacoes) {
+        return 0;
+    }
+
+    Avaliacao *av = &avaliacoes_aluno_editaveis(aluno)[avaliacao];
+    switch (campo) {
+        case CAMPO_AP1: av->ap1 = valor; break;
+        case CAMPO_AP2: av->ap2 = valor; break;
+        case CAMPO_AP3: av->ap3 = valor; break;
+        case CAMPO_NP:  av->np = valor; break;
+        default: return 0;
+    }
+    calcular_notas(aluno);
+    return 1;
+}
+
+// Remove o aluno do array e do índice em O(1): o último aluno do array
+// passa a ocupar a posição do removido (a ordem do array muda)
+// Se a matrícula estava repetida (repeticoes > 0 na entrada), a próxima ocorrência no
+// array passa a valer no índice (só nesse caso o array é percorrido)
+// Retorna 1 se o aluno foi removido e 0 se a matrícula não existir
+int remover_aluno(IndiceAlunos *indice, Aluno *alunos, int *num_alunos, int matricula) {
+    int posicao = indice_buscar(indice, matricula);
+    if (posicao < 0) {
+        return 0;
+    }
+
+    int repeticoes = indice->entradas[procurar_entrada(indice, matricula)].repeticoes;
+    free(alunos[posicao].avaliacoes_extras);
+    indice_remover(indice, matricula);
+
+    int ultimo = *num_alunos - 1;
+    if (posicao != ultimo) {
+        alunos[posicao] = alunos[ultimo];
+        // Uma matrícula duplicada no fim do array não está no índice (vale a primeira)
+        int i = procurar_entrada(indice, alunos[posicao].matricula);
+        if (i >= 0 && indice->entradas[i].posicao == ultimo) {
+            indice->entradas[i].posicao = posicao;
+        }
+    }
+    (*num_alunos)--;
+
+    if (repeticoes > 0) {
+        for (int i = 0; i < *num_alunos; i++) {
+            if (alunos[i].matricula == matricula) {
+                if (indice_inserir(indice, matricula, i) > 0) {
+                    indice->entradas[procurar_entrada(indice, matricula)].repeticoes = repeticoes - 1;
+                    indice->num_duplicadas--;
+                }
+                break;
+            }
+        }
+    }
+    return 1;
+}
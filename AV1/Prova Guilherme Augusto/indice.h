@@ -0,0 +1,47 @@
+#ifndef INDICE_H
+#define INDICE_H
+
+#include "utils.h"
+
+// Índice hash (endereçamento aberto, sondagem linear) de matrícula para a posição
+// do aluno no array, para buscar, corrigir e remover alunos em O(1)
+// A capacidade é sempre potência de 2 e a ocupação (incluindo removidos) fica abaixo de 1/2
+
+#define INDICE_VAZIO (-1)       // Posição nunca usada
+#define INDICE_REMOVIDO (-2)    // Posição de um aluno removido (a sondagem continua)
+
+typedef struct {
+    int matricula;
+    int posicao;        // Posição no array de alunos, INDICE_VAZIO ou INDICE_REMOVIDO
+    int repeticoes;     // Outros alunos do array com a mesma matrícula (fora do índice)
+} EntradaIndice;
+
+typedef struct {
+    EntradaIndice *entradas;
+    int capacidade;     // Número de entradas (potência de 2)
+    int num_itens;      // Matrículas presentes
+    int num_removidos;  // Entradas marcadas como INDICE_REMOVIDO
+    int num_duplicadas; // Alunos do array fora do índice por repetirem uma matrícula
+} IndiceAlunos;
+
+// Nota de uma avaliação que pode ser corrigida
+typedef enum {
+    CAMPO_AP1 = 0,
+    CAMPO_AP2,
+    CAMPO_AP3,
+    CAMPO_NP
+} CampoNota;
+
+// Protótipos das funções em indice.c
+int criar_indice_alunos(IndiceAlunos *indice, int num_alunos);
+void liberar_indice_alunos(IndiceAlunos *indice);
+int indice_inserir(IndiceAlunos *indice, int matricula, int posicao);
+int indice_buscar(const IndiceAlunos *indice, int matricula);
+int indice_remover(IndiceAlunos *indice, int matricula);
+int construir_indice_alunos(IndiceAlunos *indice, const Aluno *alunos, int num_alunos);
+Aluno *buscar_aluno(const IndiceAlunos *indice, Aluno *alunos, int matricula);
+int atualizar_nota_aluno(const IndiceAlunos *indice, Aluno *alunos, int matricula,
+                         int avaliacao, CampoNota campo, float valor);
+int remover_aluno(IndiceAlunos *indice, Aluno *alunos, int *num_alunos, int matricula);
+
+#endif
@@ -1,31 +1,262 @@
 #include "utils.c"
 
+// Lista só os K primeiros (ou últimos) alunos do ranking, sem ordenar o array inteiro
+// Os alunos selecionados são copiados para um array de K posições apenas para a listagem
+static int listar_top_k(const Aluno *alunos, int num_alunos, int k, OrdemRanking ordem) {
+    if (k > num_alunos) {
+        k = num_alunos;
+    }
+    int *indices = (int*) malloc((size_t) (k > 0 ? k : 1) * sizeof(int));
+    Aluno *selecionados = (Aluno*) malloc((size_t) (k > 0 ? k : 1) * sizeof(Aluno));
+    if (!indices || !selecionados) {
+        perror("Erro ao alocar memória para o ranking");
+        free(indices);
+        free(selecionados);
+        return 0;
+    }
+
+    int encontrados = ranking_top_k(alunos, num_alunos, k, ordem, DESEMPATE_NENHUM, indices);
+    for (int i = 0; i < encontrados; i++) {
+        selecionados[i] = alunos[indices[i]];
+    }
+    listar_alunos(selecionados, encontrados > 0 ? encontrados : 0);
+
+    free(indices);
+    free(selecionados);
+    return encontrados >= 0;
+}
+
 int main(int argc, char *argv[]) {
 
-    // Verifica se o número correto de argumentos foi passado
-    if (argc != 2) {
-        fprintf(stderr, "Uso: %s <notas.csv>\n", argv[0]);
+    // Verifica se os argumentos passados são válidos
+    // --top K lista os K alunos com maior NF, --bottom K os K com menor NF
+    // --threads N carrega o arquivo com N threads (0 = número de processadores)
+    // --fluxo processa uma linha por vez, com memória constante ("-" lê da entrada padrão)
+    // --externo ordena fora da memória, usando no máximo --memoria MB para os alunos
+    // --formato tabela|csv|tsv escolhe o formato da listagem (--csv é o mesmo que --formato csv)
+    // --cor sempre|nunca|auto controla as cores do status (auto = só em terminal)
+    // --buscar M mostra só o aluno com a matrícula M (busca pelo índice hash)
+    // --estatisticas mostra média, desvio, percentis e histograma de cada nota (tabela ou --formato csv/tsv)
+    // --deltas arquivo aplica correções de notas e mostra como o ranking mudou
+    // --snapshot arquivo usa (ou cria) um snapshot binário do CSV para não ler o texto de novo
+    // --compacto guarda as notas em centésimos (int16) e lista a partir do registro compacto
+    // --internar guarda uma vez só os nomes repetidos na arena de nomes
+    const char *nome_arquivo_alunos = NULL;
+    int top_k = -1;
+    int num_threads = -1;
+    const char *nome_snapshot = NULL;
+    const char *nome_deltas = NULL;
+    int modo_estatisticas = 0;
+    int buscar_matricula = 0;
+    int buscar = 0;
+    int modo_fluxo = 0;
+    int modo_externo = 0;
+    int modo_compacto = 0;
+    size_t memoria_externa = MEMORIA_EXTERNA_PADRAO;
+    OrdemRanking ordem_k = ORDEM_DECRESCENTE;
+    for (int i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "--top") == 0 || strcmp(argv[i], "--bottom") == 0) && i + 1 < argc) {
+            ordem_k = (strcmp(argv[i], "--top") == 0) ? ORDEM_DECRESCENTE : ORDEM_CRESCENTE;
+            top_k = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--buscar") == 0 && i + 1 < argc) {
+            buscar = 1;
+            buscar_matricula = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--estatisticas") == 0) {
+            modo_estatisticas = 1;
+        } else if (strcmp(argv[i], "--deltas") == 0 && i + 1 < argc) {
+            nome_deltas = argv[++i];
+        } else if (strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc) {
+            nome_snapshot = argv[++i];
+        } else if (strcmp(argv[i], "--fluxo") == 0) {
+            modo_fluxo = 1;
+        } else if (strcmp(argv[i], "--externo") == 0) {
+            modo_externo = 1;
+        } else if (strcmp(argv[i], "--compacto") == 0) {
+            modo_compacto = 1;
+        } else if (strcmp(argv[i], "--internar") == 0) {
+            arena_nomes.internar = 1;
+        } else if (strcmp(argv[i], "--memoria") == 0 && i + 1 < argc) {
+            memoria_externa = (size_t) atol(argv[++i]) * 1024 * 1024;
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            formato_saida_padrao = SAIDA_CSV;
+        } else if (strcmp(argv[i], "--formato") == 0 && i + 1 < argc) {
+            if (!ler_formato_saida(argv[++i], &formato_saida_padrao)) {
+                nome_arquivo_alunos = NULL;
+                break;
+            }
+        } else if (strcmp(argv[i], "--cor") == 0 && i + 1 < argc) {
+            if (!ler_modo_cor(argv[++i], &modo_cor_padrao)) {
+                nome_arquivo_alunos = NULL;
+                break;
+            }
+        } else if (!nome_arquivo_alunos && (argv[i][0] != '-' || strcmp(argv[i], "-") == 0)) {
+            nome_arquivo_alunos = argv[i];
+        } else {
+            nome_arquivo_alunos = NULL;
+            break;
+        }
+    }
+    // O modo compacto só lista (todos ou --top/--bottom K)
+    if (modo_compacto && (nome_snapshot || nome_deltas || modo_estatisticas || buscar || modo_fluxo || modo_externo)) {
+        nome_arquivo_alunos = NULL;
+    }
+    if (!nome_arquivo_alunos) {
+        fprintf(stderr, "Uso: %s <notas.csv> [--top K | --bottom K | --buscar M | --estatisticas] [--threads N] [--snapshot arquivo] [--deltas arquivo] [--fluxo | --externo [--memoria MB] | --compacto] [--internar] [--formato tabela|csv|tsv] [--cor sempre|nunca|auto]\n", argv[0]);
         return 1;
     }
 
-    // Nome do arquivo CSV passado como argumento
-    const char *nome_arquivo_alunos = argv[1];
+    // Modo fluxo: lê, calcula e imprime um aluno por vez, sem carregar o arquivo
+    // Modo externo: ranking com blocos ordenados em arquivos temporários
+    if (modo_fluxo || modo_externo) {
+        FILE *entrada = strcmp(nome_arquivo_alunos, "-") == 0 ? stdin : fopen(nome_arquivo_alunos, "r");
+        if (!entrada) {
+            perror("Erro ao abrir arquivo de alunos");
+            return 1;
+        }
+        Renderizador saida;
+        if (!iniciar_renderizador(&saida, stdout, formato_saida_padrao, modo_cor_padrao)) {
+            perror("Erro ao alocar memória para a saída");
+            if (entrada != stdin) {
+                fclose(entrada);
+            }
+            return 1;
+        }
+        int ok;
+        if (modo_externo) {
+            ok = ranking_externo(entrada, &saida, memoria_externa, ORDEM_DECRESCENTE, DESEMPATE_NENHUM);
+            finalizar_renderizador(&saida);
+        } else {
+            ResumoFluxo resumo;
+            ok = processar_alunos_fluxo(entrada, &saida, &resumo);
+            finalizar_renderizador(&saida);
+            // No CSV/TSV o resumo vai para stderr, para não misturar com os dados
+            imprimir_resumo_fluxo(formato_saida_padrao != SAIDA_TABELA ? stderr : stdout, &resumo);
+        }
+        if (entrada != stdin) {
+            fclose(entrada);
+        }
+        return ok ? 0 : 1;
+    }
+
+    // Modo compacto: carrega direto nos registros de 28 bytes e ordena pela soma inteira
+    if (modo_compacto) {
+        TurmaCompacta turma;
+        if (!carregar_turma_compacta(nome_arquivo_alunos, &turma)) {
+            return 1;
+        }
+        int *indices = ranking_compacto(&turma, top_k >= 0 ? ordem_k : ORDEM_DECRESCENTE);
+        if (!indices) {
+            perror("Erro ao alocar memória para o ranking");
+            liberar_turma_compacta(&turma);
+            return 1;
+        }
+        int quantidade = (top_k >= 0 && top_k < turma.num_alunos) ? top_k : turma.num_alunos;
+        listar_turma_compacta(&turma, indices, quantidade);
+        free(indices);
+        liberar_turma_compacta(&turma);
+        liberar_arena(&arena_nomes);
+        return 0;
+    }
 
     // Carrega os alunos do arquivo CSV
     int num_alunos = 0;
-    Aluno *alunos = carregar_alunos(nome_arquivo_alunos, &num_alunos);
+    Aluno *alunos = NULL;
+    if (nome_snapshot) {
+        alunos = carregar_alunos_snapshot(nome_arquivo_alunos, nome_snapshot, &num_alunos, num_threads);
+    } else if (num_threads >= 0) {
+        alunos = carregar_alunos_paralelo(nome_arquivo_alunos, &num_alunos, num_threads);
+    } else {
+        alunos = carregar_alunos(nome_arquivo_alunos, &num_alunos);
+    }
     if (!alunos) {
         return 1;
     }
 
-    // Ordena os alunos por nota final (NF) e lista os alunos
-    ordenar_alunos(alunos, num_alunos);
-    listar_alunos(alunos, num_alunos);
+    // Índice de matrículas: também detecta matrículas repetidas no arquivo
+    IndiceAlunos indice;
+    if (construir_indice_alunos(&indice, alunos, num_alunos) < 0) {
+        perror("Erro ao alocar memória para o índice de matrículas");
+        liberar_memoria(alunos, num_alunos);
+        return 1;
+    }
+
+    // Correções: só os alunos alterados são recalculados e movidos no ranking
+    RankingDinamico ranking;
+    ranking.nos = NULL;
+    if (nome_deltas) {
+        int num_deltas = 0;
+        DeltaNota *deltas = carregar_deltas(nome_deltas, &num_deltas);
+        MudancaRanking *mudancas = (MudancaRanking*) malloc((size_t) (num_deltas > 0 ? num_deltas : 1) * sizeof(MudancaRanking));
+        int num_mudancas = -1;
+        if (deltas && mudancas && criar_ranking_dinamico(&ranking, alunos, num_alunos, ORDEM_DECRESCENTE)) {
+            num_mudancas = aplicar_deltas(&indice, alunos, &ranking, deltas, num_deltas, mudancas);
+        }
+        if (num_mudancas < 0) {
+            if (deltas) {
+                perror("Erro ao alocar memória para as correções");
+            }
+            free(deltas);
+            free(mudancas);
+            liberar_ranking_dinamico(&ranking);
+            liberar_indice_alunos(&indice);
+            liberar_memoria(alunos, num_alunos);
+            return 1;
+        }
+        imprimir_mudancas_ranking(stdout, alunos, mudancas, num_mudancas);
+        free(deltas);
+        free(mudancas);
+    }
+
+    if (modo_estatisticas) {
+        // Estatísticas em uma passada pela tabela de notas em colunas
+        TabelaNotas tabela;
+        EstatisticasNotas *estatisticas = (EstatisticasNotas*) malloc(sizeof(EstatisticasNotas));
+        if (estatisticas && criar_tabela_notas(&tabela, num_alunos)) {
+            preencher_tabela_notas(&tabela, alunos, num_alunos);
+            if (calcular_estatisticas(&tabela, num_threads >= 0 ? num_threads : 1, estatisticas)) {
+                imprimir_estatisticas(stdout, estatisticas, formato_saida_padrao);
+            } else {
+                perror("Erro ao alocar memória para as estatísticas");
+            }
+            liberar_tabela_notas(&tabela);
+        } else {
+            perror("Erro ao alocar memória para as estatísticas");
+        }
+        free(estatisticas);
+    } else if (buscar) {
+        // Lista só o aluno encontrado
+        Aluno *aluno = buscar_aluno(&indice, alunos, buscar_matricula);
+        if (aluno) {
+            listar_alunos(aluno, 1);
+        } else {
+            printf("Matrícula %d não encontrada.\n", buscar_matricula);
+        }
+    } else if (top_k >= 0) {
+        // Lista só os K primeiros (ou últimos) do ranking
+        listar_top_k(alunos, num_alunos, top_k, ordem_k);
+    } else {
+        // Ordena os alunos por nota final (NF) e lista os alunos
+        // Depois das correções a ordem já está no ranking dinâmico, sem ordenar de novo
+        int *indices = ranking.nos ? (int*) malloc((size_t) (num_alunos > 0 ? num_alunos : 1) * sizeof(int)) : NULL;
+        if (indices) {
+            indices_ranking_dinamico(&ranking, indices);
+            aplicar_ranking(alunos, num_alunos, indices);
+            free(indices);
+        } else {
+            ordenar_alunos(alunos, num_alunos);
+        }
+        listar_alunos(alunos, num_alunos);
+    }
 
     /* 
         ATENÇÃO: Essa função deve ser implementada
     */    
     // Libera a memória alocada para os alunos
+    liberar_ranking_dinamico(&ranking);
+    liberar_indice_alunos(&indice);
     liberar_memoria(alunos, num_alunos);
+    liberar_arena(&arena_nomes);
     return 0;
 }
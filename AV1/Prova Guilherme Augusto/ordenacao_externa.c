@@ -0,0 +1,383 @@
+#include "ordenacao_externa.h"
+#include <stdint.h>
+
+// Aluno lido de um bloco ordenado, com a chave do ranking já calculada
+typedef struct {
+    Aluno aluno;        // O nome não está na arena: fica em "nome"
+    const char *nome;   // Nome lido, no buffer do bloco de origem
+    uint32_t chave;     // Chave da NF (invertida na ordem decrescente), como em ranking_alunos
+    int bloco;          // Bloco de origem: blocos anteriores vêm antes no arquivo
+} RegistroExterno;
+
+// Formato binário de um aluno no arquivo temporário:
+// matrícula (int32), tamanho do nome (uint32), nome (sem '\0'), 8 notas, nf (floats) e status (uint8)
+static int gravar_registro(FILE *arquivo, const Aluno *aluno, const char *nome, uint32_t tamanho_nome) {
+    const Avaliacao *avaliacoes = avaliacoes_aluno(aluno);
+    int32_t matricula = aluno->matricula;
+    float notas[9] = {
+        avaliacoes[0].ap1, avaliacoes[0].ap2, avaliacoes[0].ap3, avaliacoes[0].np,
+        avaliacoes[1].ap1, avaliacoes[1].ap2, avaliacoes[1].ap3, avaliacoes[1].np,
+        aluno->nf
+    };
+    uint8_t status = (uint8_t) aluno->status;
+
+    return fwrite(&matricula, sizeof(matricula), 1, arquivo) == 1 &&
+           fwrite(&tamanho_nome, sizeof(tamanho_nome), 1, arquivo) == 1 &&
+           fwrite(nome, 1, tamanho_nome, arquivo) == tamanho_nome &&
+           fwrite(notas, sizeof(float), 9, arquivo) == 9 &&
+           fwrite(&status, 1, 1, arquivo) == 1;
+}
+
+// Buffer do nome do registro atual de cada bloco (cada bloco tem no máximo um registro no heap)
+typedef struct {
+    char *dados;
+    uint32_t tamanho;
+    int capacidade;
+} NomeBloco;
+
+// Lê um aluno gravado por gravar_registro; o nome vai para o buffer "nome" (aumentado se preciso)
+// Retorna 0 no fim do arquivo ou se faltar memória
+static int ler_registro(FILE *arquivo, Aluno *aluno, NomeBloco *nome) {
+    int32_t matricula;
+    uint32_t tamanho_nome;
+    float notas[9];
+    uint8_t status;
+
+    if (fread(&matricula, sizeof(matricula), 1, arquivo) != 1 ||
+        fread(&tamanho_nome, sizeof(tamanho_nome), 1, arquivo) != 1) {
+        return 0;
+    }
+    char *temp = VETOR_RESERVAR(nome->dados, nome->capacidade, (int) tamanho_nome + 1);
+    if (!temp) {
+        return 0;
+    }
+    nome->dados = temp;
+    if (fread(nome->dados, 1, tamanho_nome, arquivo) != tamanho_nome ||
+        fread(notas, sizeof(float), 9, arquivo) != 9 ||
+        fread(&status, 1, 1, arquivo) != 1) {
+        return 0;
+    }
+    nome->dados[tamanho_nome] = '\0';
+    nome->tamanho = tamanho_nome;
+
+    aluno->matricula = matricula;
+    aluno->nome = (RefTexto){0, 0};
+    aluno->avaliacoes_extras = NULL;
+    aluno->num_avaliacoes = 0;
+    aluno->capacidade_avaliacoes = 0;
+    adicionar_avaliacoes(aluno, (Avaliacao){notas[0], notas[1], notas[2], notas[3]});
+    adicionar_avaliacoes(aluno, (Avaliacao){notas[4], notas[5], notas[6], notas[7]});
+    aluno->nf = notas[8];
+    aluno->status = status;
+    return 1;
+}
+
+// Critério de desempate usado na intercalação
+static CriterioDesempate desempate_externo;
+
+// Compara dois registros com as mesmas regras de ranking_alunos
+// Em caso de empate total, o bloco anterior vem primeiro, o que mantém a ordenação estável
+static int comparar_registros(const RegistroExterno *a, const RegistroExterno *b) {
+    if (a->chave != b->chave) {
+        return a->chave < b->chave ? -1 : 1;
+    }
+    if (desempate_externo == DESEMPATE_MATRICULA && a->aluno.matricula != b->aluno.matricula) {
+        return a->aluno.matricula < b->aluno.matricula ? -1 : 1;
+    }
+    if (desempate_externo == DESEMPATE_NOME) {
+        int c = strcmp(a->nome, b->nome);
+        if (c != 0) {
+            return c;
+        }
+    }
+    return a->bloco < b->bloco ? -1 : (a->bloco > b->bloco);
+}
+
+// Desce o elemento i no heap de mínimo da intercalação
+static void descer_heap_externo(RegistroExterno *heap, int tamanho, int i) {
+    while (1) {
+        int menor = i;
+        int esq = 2 * i + 1;
+        int dir = esq + 1;
+        if (esq < tamanho && comparar_registros(&heap[esq], &heap[menor]) < 0) {
+            menor = esq;
+        }
+        if (dir < tamanho && comparar_registros(&heap[dir], &heap[menor]) < 0) {
+            menor = dir;
+        }
+        if (menor == i) {
+            return;
+        }
+        RegistroExterno temp = heap[i];
+        heap[i] = heap[menor];
+        heap[menor] = temp;
+        i = menor;
+    }
+}
+
+// Lê o próximo registro do bloco e calcula a sua chave
+static int proximo_registro(FILE *bloco, int indice, NomeBloco *nome, OrdemRanking ordem,
+                            RegistroExterno *registro) {
+    if (!ler_registro(bloco, &registro->aluno, nome)) {
+        return 0;
+    }
+    registro->nome = nome->dados;
+    uint32_t chave = chave_nota_final(registro->aluno.nf);
+    registro->chave = (ordem == ORDEM_DECRESCENTE) ? ~chave : chave;
+    registro->bloco = indice;
+    return 1;
+}
+
+// Intercala os blocos em ordem; cada registro vai para o arquivo "destino" (formato binário)
+// ou, se destino for NULL, é impresso pelo renderizador "saida"
+static int intercalar_blocos(FILE **blocos, int num_blocos, OrdemRanking ordem, FILE *destino,
+                             Renderizador *saida) {
+    RegistroExterno heap[MAX_BLOCOS_INTERCALACAO];
+    NomeBloco nomes[MAX_BLOCOS_INTERCALACAO];
+    int tamanho = 0;
+    int ok = 1;
+
+    memset(nomes, 0, sizeof(nomes));
+    for (int i = 0; i < num_blocos; i++) {
+        rewind(blocos[i]);
+        if (proximo_registro(blocos[i], i, &nomes[i], ordem, &heap[tamanho])) {
+            tamanho++;
+        }
+    }
+    for (int i = tamanho / 2 - 1; i >= 0; i--) {
+        descer_heap_externo(heap, tamanho, i);
+    }
+
+    while (tamanho > 0) {
+        Aluno *aluno = &heap[0].aluno;
+        int origem = heap[0].bloco;
+        if (destino) {
+            if (!gravar_registro(destino, aluno, nomes[origem].dados, nomes[origem].tamanho)) {
+                ok = 0;
+                break;
+            }
+        } else {
+            // O renderizador lê o nome da arena: entra só enquanto o aluno é impresso
+            size_t marca = arena_marca(&arena_nomes);
+            if (!arena_adicionar(&arena_nomes, nomes[origem].dados, nomes[origem].tamanho, &aluno->nome)) {
+                ok = 0;
+                break;
+            }
+            renderizar_aluno(saida, aluno);
+            arena_descartar(&arena_nomes, marca);
+        }
+
+        // Substitui o topo pelo próximo registro do mesmo bloco (ou remove o bloco esgotado)
+        if (!proximo_registro(blocos[origem], origem, &nomes[origem], ordem, &heap[0])) {
+            heap[0] = heap[--tamanho];
+        }
+        descer_heap_externo(heap, tamanho, 0);
+    }
+
+    for (int i = 0; i < num_blocos; i++) {
+        free(nomes[i].dados);
+    }
+    return ok;
+}
+
+// Intercala "grupo" blocos consecutivos em um arquivo temporário novo e fecha os originais
+// Retorna o novo bloco ou NULL em caso de erro (os originais continuam abertos)
+static FILE *juntar_blocos(FILE **blocos, int grupo, OrdemRanking ordem) {
+    FILE *destino = tmpfile();
+    if (!destino || !intercalar_blocos(blocos, grupo, ordem, destino, NULL)) {
+        perror("Erro ao intercalar blocos do ranking");
+        if (destino) {
+            fclose(destino);
+        }
+        return NULL;
+    }
+    for (int i = 0; i < grupo; i++) {
+        fclose(blocos[i]);
+        blocos[i] = NULL;
+    }
+    return destino;
+}
+
+// Ordena um bloco em memória e grava em um arquivo temporário
+static FILE *gravar_bloco(Aluno *alunos, int num_alunos, OrdemRanking ordem, CriterioDesempate desempate) {
+    int *indices = ranking_alunos(alunos, num_alunos, ordem, desempate);
+    FILE *bloco = tmpfile();
+    if (!indices || !bloco) {
+        free(indices);
+        if (bloco) {
+            fclose(bloco);
+        }
+        return NULL;
+    }
+    for (int i = 0; i < num_alunos; i++) {
+        const Aluno *aluno = &alunos[indices[i]];
+        if (!gravar_registro(bloco, aluno, nome_aluno(aluno), aluno->nome.tamanho)) {
+            free(indices);
+            fclose(bloco);
+            return NULL;
+        }
+    }
+    free(indices);
+    return bloco;
+}
+
+// Lê o CSV de "entrada", ordena pelo ranking usando no máximo "memoria_max" bytes para os
+// alunos (structs e nomes na arena) e imprime o resultado pelo renderizador "saida" (tabela, CSV ou TSV)
+// Retorna 1 em caso de sucesso e 0 em caso de erro
+int ranking_externo(FILE *entrada, Renderizador *saida, size_t memoria_max, OrdemRanking ordem,
+                    CriterioDesempate desempate) {
+    // Cada aluno do bloco ocupa o struct mais ~24 bytes do ranking (pares chave/índice)
+    size_t por_aluno = sizeof(Aluno) + 24;
+    int capacidade_bloco = (int) (memoria_max / por_aluno);
+    if (capacidade_bloco < 16) {
+        capacidade_bloco = 16;
+    }
+
+    Aluno *alunos = (Aluno*) malloc((size_t) capacidade_bloco * sizeof(Aluno));
+    FILE **blocos = NULL;
+    int *niveis = NULL;         // Quantas intercalações cada bloco já passou (0: bloco lido do CSV)
+    int num_blocos = 0;
+    int capacidade_blocos = 0;
+    int capacidade_niveis = 0;
+    char *linha = NULL;
+    int capacidade_linha = 0;
+    int ok = alunos != NULL;
+    if (!alunos) {
+        perror("Erro ao alocar memória para o bloco do ranking");
+    }
+    desempate_externo = desempate;
+
+    // Pula o cabeçalho
+    if (ok && ler_linha(entrada, &linha, &capacidade_linha) < 0) {
+        ok = 0;
+    }
+
+    // Fase 1: lê blocos que cabem na memória, ordena e grava cada um
+    // Os nomes do bloco ficam na arena_nomes e são descartados depois que o bloco é gravado
+    // Quando os últimos MAX_BLOCOS_INTERCALACAO blocos são do mesmo nível, eles viram um
+    // bloco do nível seguinte: ficam abertos no máximo MAX_BLOCOS_INTERCALACAO - 1 blocos
+    // por nível, e cada nível cobre MAX_BLOCOS_INTERCALACAO vezes mais alunos que o anterior
+    size_t marca = arena_marca(&arena_nomes);
+    int num_alunos = 0;
+    int num_linha = 1;
+    long tamanho = 0;
+    while (ok) {
+        tamanho = ler_linha(entrada, &linha, &capacidade_linha);
+        if (tamanho >= 0) {
+            num_linha++;
+            Avaliacao avaliacao1;
+            Avaliacao avaliacao2;
+            Aluno *aluno = &alunos[num_alunos];
+            LinhaCSV campos;
+            iniciar_linha_csv(&campos, linha, linha + tamanho);
+            if (!analisar_linha_aluno(&campos, &arena_nomes, aluno, &avaliacao1, &avaliacao2)) {
+                reportar_erro_csv("alunos", num_linha, &campos);
+                continue;
+            }
+            aluno->avaliacoes_extras = NULL;
+            aluno->num_avaliacoes = 0;
+            aluno->capacidade_avaliacoes = 0;
+            adicionar_avaliacoes(aluno, avaliacao1);
+            adicionar_avaliacoes(aluno, avaliacao2);
+            calcular_notas(aluno);
+            num_alunos++;
+        }
+
+        // Bloco cheio (ou fim do arquivo com mais de um bloco): grava em disco
+        int fim = tamanho < 0;
+        size_t memoria_bloco = (size_t) num_alunos * por_aluno + (arena_nomes.tamanho - marca);
+        int cheio = num_alunos == capacidade_bloco || (num_alunos > 0 && memoria_bloco >= memoria_max);
+        if (cheio || (fim && num_alunos > 0 && num_blocos > 0)) {
+            FILE **temp = VETOR_RESERVAR(blocos, capacidade_blocos, num_blocos + 1);
+            if (temp) {
+                blocos = temp;
+            }
+            int *temp_niveis = VETOR_RESERVAR(niveis, capacidade_niveis, num_blocos + 1);
+            if (temp_niveis) {
+                niveis = temp_niveis;
+            }
+            FILE *bloco = temp && temp_niveis ? gravar_bloco(alunos, num_alunos, ordem, desempate) : NULL;
+            if (!bloco) {
+                perror("Erro ao gravar bloco temporário do ranking");
+                ok = 0;
+                break;
+            }
+            niveis[num_blocos] = 0;
+            blocos[num_blocos++] = bloco;
+            num_alunos = 0;
+            arena_descartar(&arena_nomes, marca);
+
+            // Os níveis nunca crescem do início para o fim, então se o primeiro e o último
+            // dos MAX_BLOCOS_INTERCALACAO blocos finais têm o mesmo nível, todos têm
+            while (ok && num_blocos >= MAX_BLOCOS_INTERCALACAO &&
+                   niveis[num_blocos - MAX_BLOCOS_INTERCALACAO] == niveis[num_blocos - 1]) {
+                int inicio = num_blocos - MAX_BLOCOS_INTERCALACAO;
+                FILE *destino = juntar_blocos(blocos + inicio, MAX_BLOCOS_INTERCALACAO, ordem);
+                if (!destino) {
+                    ok = 0;
+                    break;
+                }
+                blocos[inicio] = destino;
+                niveis[inicio]++;
+                num_blocos = inicio + 1;
+            }
+        }
+        if (fim) {
+            break;
+        }
+    }
+    free(linha);
+
+    if (ok) {
+        renderizar_cabecalho(saida);
+    }
+
+    if (ok && num_blocos == 0) {
+        // Tudo coube em um bloco: ordena e imprime direto da memória
+        int *indices = num_alunos > 0 ? ranking_alunos(alunos, num_alunos, ordem, desempate) : NULL;
+        ok = num_alunos == 0 || indices != NULL;
+        for (int i = 0; ok && i < num_alunos; i++) {
+            renderizar_aluno(saida, &alunos[indices[i]]);
+        }
+        free(indices);
+    }
+    free(alunos);
+    arena_descartar(&arena_nomes, marca);
+
+    // Fase 2: intercala grupos de blocos vizinhos até sobrarem MAX_BLOCOS_INTERCALACAO
+    // Grupos de blocos consecutivos mantêm a ordem do arquivo, então o resultado continua estável
+    while (ok && num_blocos > MAX_BLOCOS_INTERCALACAO) {
+        int novos = 0;
+        for (int i = 0; i < num_blocos; i += MAX_BLOCOS_INTERCALACAO) {
+            int grupo = num_blocos - i < MAX_BLOCOS_INTERCALACAO ? num_blocos - i : MAX_BLOCOS_INTERCALACAO;
+            FILE *destino = juntar_blocos(blocos + i, grupo, ordem);
+            if (!destino) {
+                ok = 0;
+                break;
+            }
+            blocos[novos++] = destino;
+        }
+        if (!ok) {
+            break;
+        }
+        num_blocos = novos;
+    }
+
+    // Intercalação final direto para a saída
+    if (ok && num_blocos > 0) {
+        ok = intercalar_blocos(blocos, num_blocos, ordem, NULL, saida);
+    }
+
+    if (ok) {
+        renderizar_rodape(saida);
+    }
+
+    for (int i = 0; i < num_blocos; i++) {
+        if (blocos[i]) {
+            fclose(blocos[i]);
+        }
+    }
+    free(blocos);
+    free(niveis);
+    return ok;
+}
@@ -0,0 +1,22 @@
+#ifndef ORDENACAO_EXTERNA_H
+#define ORDENACAO_EXTERNA_H
+
+#include "utils.h"
+#include "ranking.h"
+#include "fluxo.h"
+#include "renderizador.h"
+
+// Ranking fora da memória (external merge sort) para arquivos que não cabem na RAM
+// 1. Lê o CSV em blocos que cabem no limite de memória
+// 2. Ordena cada bloco com ranking_alunos e grava em um arquivo temporário (formato binário compacto)
+// 3. Intercala os blocos (k-way merge) e imprime o ranking final
+// O resultado é exatamente o mesmo do ranking em memória com a mesma ordem e desempate
+
+#define MEMORIA_EXTERNA_PADRAO (64u * 1024u * 1024u)   // 64 MB
+#define MAX_BLOCOS_INTERCALACAO 64                      // Blocos intercalados de uma vez
+
+// Protótipos das funções em ordenacao_externa.c
+int ranking_externo(FILE *entrada, Renderizador *saida, size_t memoria_max, OrdemRanking ordem,
+                    CriterioDesempate desempate);
+
+#endif
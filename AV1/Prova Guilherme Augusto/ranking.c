@@ -0,0 +1,268 @@
+#include "ranking.h"
+
+// Par chave/índice ordenado no lugar dos structs Aluno (8 bytes em vez de ~112)
+typedef struct {
+    uint32_t chave; // Chave de ordenação (NF ou matrícula convertida para inteiro sem sinal)
+    uint32_t indice; // Posição do aluno no array original
+} ChaveRanking;
+
+// Converte a NF em um inteiro sem sinal com a mesma ordem dos floats
+// Inverte todos os bits dos negativos e só o bit de sinal dos positivos;
+// a conversão não perde precisão, então duas notas diferentes nunca empatam
+uint32_t chave_nota_final(float nf) {
+    nf += 0.0f; // -0.0 e 0.0 são a mesma nota
+    uint32_t bits;
+    memcpy(&bits, &nf, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+// Ordena os pares pela chave com radix sort LSD (4 passadas de 8 bits)
+// É estável: pares com a mesma chave mantêm a ordem em que estavam
+static int radix_sort_chaves(ChaveRanking *pares, int n) {
+    ChaveRanking *temp = (ChaveRanking*) malloc((size_t) n * sizeof(ChaveRanking));
+    if (!temp) {
+        return 0;
+    }
+
+    // Conta os dígitos das 4 passadas de uma vez
+    size_t contagem[4][256];
+    memset(contagem, 0, sizeof(contagem));
+    for (int i = 0; i < n; i++) {
+        uint32_t c = pares[i].chave;
+        contagem[0][c & 0xFF]++;
+        contagem[1][(c >> 8) & 0xFF]++;
+        contagem[2][(c >> 16) & 0xFF]++;
+        contagem[3][c >> 24]++;
+    }
+
+    ChaveRanking *origem = pares;
+    ChaveRanking *destino = temp;
+    for (int passada = 0; passada < 4; passada++) {
+        // Passadas em que todos têm o mesmo dígito não mudam nada
+        int deslocamento = passada * 8;
+        if (contagem[passada][(origem[0].chave >> deslocamento) & 0xFF] == (size_t) n) {
+            continue;
+        }
+
+        // Soma de prefixos: posição inicial de cada dígito
+        size_t posicao[256];
+        size_t soma = 0;
+        for (int d = 0; d < 256; d++) {
+            posicao[d] = soma;
+            soma += contagem[passada][d];
+        }
+
+        for (int i = 0; i < n; i++) {
+            destino[posicao[(origem[i].chave >> deslocamento) & 0xFF]++] = origem[i];
+        }
+
+        ChaveRanking *troca = origem;
+        origem = destino;
+        destino = troca;
+    }
+
+    // O resultado pode ter terminado no buffer temporário
+    if (origem != pares) {
+        memcpy(pares, origem, (size_t) n * sizeof(ChaveRanking));
+    }
+    free(temp);
+    return 1;
+}
+
+// Contexto da comparação (qsort não recebe parâmetros extras)
+static const Aluno *alunos_comparacao;
+static CriterioDesempate desempate_comparacao;
+
+// Compara dois pares: chave, depois o critério de desempate e, por fim, a posição original
+// O último critério torna a ordenação por comparação estável como a do radix sort
+static int comparar_chaves(const void *a, const void *b) {
+    const ChaveRanking *x = (const ChaveRanking*) a;
+    const ChaveRanking *y = (const ChaveRanking*) b;
+
+    if (x->chave != y->chave) {
+        return x->chave < y->chave ? -1 : 1;
+    }
+
+    const Aluno *ax = &alunos_comparacao[x->indice];
+    const Aluno *ay = &alunos_comparacao[y->indice];
+    if (desempate_comparacao == DESEMPATE_MATRICULA && ax->matricula != ay->matricula) {
+        return ax->matricula < ay->matricula ? -1 : 1;
+    }
+    if (desempate_comparacao == DESEMPATE_NOME) {
+        int c = strcmp(nome_aluno(ax), nome_aluno(ay));
+        if (c != 0) {
+            return c;
+        }
+    }
+
+    return x->indice < y->indice ? -1 : (x->indice > y->indice);
+}
+
+// Calcula o ranking dos alunos pela NF sem mover os structs
+// Retorna um array (alocado com malloc) com os índices dos alunos na ordem do ranking,
+// ou NULL em caso de erro. Com DESEMPATE_NENHUM o resultado é o mesmo do bubble sort
+// original de ordenar_alunos (ordenação estável)
+int *ranking_alunos(const Aluno *alunos, int num_alunos, OrdemRanking ordem, CriterioDesempate desempate) {
+    if (num_alunos <= 0) {
+        return NULL;
+    }
+
+    ChaveRanking *pares = (ChaveRanking*) malloc((size_t) num_alunos * sizeof(ChaveRanking));
+    int *indices = (int*) malloc((size_t) num_alunos * sizeof(int));
+    if (!pares || !indices) {
+        free(pares);
+        free(indices);
+        return NULL;
+    }
+
+    // Na ordem decrescente a chave é invertida, então o radix sort é sempre crescente
+    for (int i = 0; i < num_alunos; i++) {
+        uint32_t chave = chave_nota_final(alunos[i].nf);
+        pares[i].chave = (ordem == ORDEM_DECRESCENTE) ? ~chave : chave;
+        pares[i].indice = (uint32_t) i;
+    }
+
+    int ok = 1;
+    if (num_alunos < RANKING_LIMITE_RADIX || desempate == DESEMPATE_NOME) {
+        // Poucos alunos, ou desempate por nome: ordenação por comparação
+        alunos_comparacao = alunos;
+        desempate_comparacao = desempate;
+        qsort(pares, num_alunos, sizeof(ChaveRanking), comparar_chaves);
+    } else if (desempate == DESEMPATE_MATRICULA) {
+        // Primeiro ordena pela matrícula e depois, de forma estável, pela NF
+        // O sinal da matrícula é invertido para que negativos fiquem antes dos positivos
+        uint32_t *chave_nf = (uint32_t*) malloc((size_t) num_alunos * sizeof(uint32_t));
+        ok = chave_nf != NULL;
+        if (ok) {
+            for (int i = 0; i < num_alunos; i++) {
+                chave_nf[i] = pares[i].chave;
+                pares[i].chave = (uint32_t) alunos[i].matricula ^ 0x80000000u;
+            }
+            ok = radix_sort_chaves(pares, num_alunos);
+            for (int i = 0; ok && i < num_alunos; i++) {
+                pares[i].chave = chave_nf[pares[i].indice];
+            }
+            ok = ok && radix_sort_chaves(pares, num_alunos);
+            free(chave_nf);
+        }
+    } else {
+        ok = radix_sort_chaves(pares, num_alunos);
+    }
+
+    if (!ok) {
+        free(pares);
+        free(indices);
+        return NULL;
+    }
+
+    for (int i = 0; i < num_alunos; i++) {
+        indices[i] = (int) pares[i].indice;
+    }
+    free(pares);
+    return indices;
+}
+
+// Reorganiza o array de alunos de acordo com os índices do ranking
+// Cada aluno é copiado uma única vez; retorna 1 em caso de sucesso
+int aplicar_ranking(Aluno *alunos, int num_alunos, const int *indices) {
+    Aluno *ordenados = (Aluno*) malloc((size_t) num_alunos * sizeof(Aluno));
+    if (!ordenados) {
+        return 0;
+    }
+    for (int i = 0; i < num_alunos; i++) {
+        ordenados[i] = alunos[indices[i]];
+    }
+    memcpy(alunos, ordenados, (size_t) num_alunos * sizeof(Aluno));
+    free(ordenados);
+    return 1;
+}
+
+// Ordena o array de alunos pela NF com a ordem e o desempate escolhidos
+// Retorna 1 em caso de sucesso e 0 se faltar memória (o array não é alterado)
+int ordenar_alunos_ranking(Aluno *alunos, int num_alunos, OrdemRanking ordem, CriterioDesempate desempate) {
+    if (num_alunos <= 1) {
+        return 1;
+    }
+    int *indices = ranking_alunos(alunos, num_alunos, ordem, desempate);
+    if (!indices) {
+        return 0;
+    }
+    int ok = aplicar_ranking(alunos, num_alunos, indices);
+    free(indices);
+    return ok;
+}
+
+// Desce o elemento da posição i no heap até restaurar a propriedade de heap
+// O heap mantém no topo o pior dos K melhores alunos encontrados até agora
+static void descer_heap(ChaveRanking *heap, int tamanho, int i) {
+    while (1) {
+        int maior = i;
+        int esq = 2 * i + 1;
+        int dir = esq + 1;
+        if (esq < tamanho && comparar_chaves(&heap[esq], &heap[maior]) > 0) {
+            maior = esq;
+        }
+        if (dir < tamanho && comparar_chaves(&heap[dir], &heap[maior]) > 0) {
+            maior = dir;
+        }
+        if (maior == i) {
+            return;
+        }
+        ChaveRanking temp = heap[i];
+        heap[i] = heap[maior];
+        heap[maior] = temp;
+        i = maior;
+    }
+}
+
+// Encontra os K primeiros alunos do ranking sem ordenar (nem alterar) o array inteiro
+// Usa um heap limitado a K elementos: O(n log K) de tempo e O(K) de memória
+// Com ORDEM_DECRESCENTE retorna os K maiores NFs; com ORDEM_CRESCENTE, os K menores
+// Os índices são escritos em "indices" (espaço para K inteiros) na ordem do ranking,
+// a mesma que ranking_alunos daria. Retorna quantos índices foram escritos ou -1 em caso de erro
+int ranking_top_k(const Aluno *alunos, int num_alunos, int k, OrdemRanking ordem, CriterioDesempate desempate, int *indices) {
+    if (k > num_alunos) {
+        k = num_alunos;
+    }
+    if (k <= 0) {
+        return 0;
+    }
+
+    ChaveRanking *heap = (ChaveRanking*) malloc((size_t) k * sizeof(ChaveRanking));
+    if (!heap) {
+        return -1;
+    }
+
+    alunos_comparacao = alunos;
+    desempate_comparacao = desempate;
+
+    int tamanho = 0;
+    for (int i = 0; i < num_alunos; i++) {
+        uint32_t chave = chave_nota_final(alunos[i].nf);
+        ChaveRanking candidato = { (ordem == ORDEM_DECRESCENTE) ? ~chave : chave, (uint32_t) i };
+
+        if (tamanho < k) {
+            // Ainda há espaço: insere e sobe até a posição correta
+            int j = tamanho++;
+            heap[j] = candidato;
+            while (j > 0 && comparar_chaves(&heap[j], &heap[(j - 1) / 2]) > 0) {
+                ChaveRanking temp = heap[j];
+                heap[j] = heap[(j - 1) / 2];
+                heap[(j - 1) / 2] = temp;
+                j = (j - 1) / 2;
+            }
+        } else if (comparar_chaves(&candidato, &heap[0]) < 0) {
+            // Melhor que o pior dos K atuais: substitui o topo
+            heap[0] = candidato;
+            descer_heap(heap, tamanho, 0);
+        }
+    }
+
+    // Ordena só os K selecionados
+    qsort(heap, tamanho, sizeof(ChaveRanking), comparar_chaves);
+    for (int i = 0; i < tamanho; i++) {
+        indices[i] = (int) heap[i].indice;
+    }
+    free(heap);
+    return tamanho;
+}
@@ -0,0 +1,30 @@
+#ifndef RANKING_H
+#define RANKING_H
+
+#include <stdint.h>
+#include "utils.h"
+
+// Ordem do ranking pela nota final (NF)
+typedef enum {
+    ORDEM_DECRESCENTE = 0,  // Maior NF primeiro (padrão de ordenar_alunos)
+    ORDEM_CRESCENTE = 1     // Menor NF primeiro
+} OrdemRanking;
+
+// Critério de desempate entre alunos com a mesma NF (sempre crescente)
+typedef enum {
+    DESEMPATE_NENHUM = 0,   // Mantém a ordem original do array (ordenação estável)
+    DESEMPATE_MATRICULA,    // Menor matrícula primeiro
+    DESEMPATE_NOME          // Nome em ordem alfabética
+} CriterioDesempate;
+
+// Abaixo deste número de alunos a ordenação por comparação é mais rápida que o radix sort
+#define RANKING_LIMITE_RADIX 256
+
+// Protótipos das funções em ranking.c
+uint32_t chave_nota_final(float nf);
+int *ranking_alunos(const Aluno *alunos, int num_alunos, OrdemRanking ordem, CriterioDesempate desempate);
+int aplicar_ranking(Aluno *alunos, int num_alunos, const int *indices);
+int ranking_top_k(const Aluno *alunos, int num_alunos, int k, OrdemRanking ordem, CriterioDesempate desempate, int *indices);
+int ordenar_alunos_ranking(Aluno *alunos, int num_alunos, OrdemRanking ordem, CriterioDesempate desempate);
+
+#endif
@@ -0,0 +1,221 @@
+#include "ranking_dinamico.h"
+
+// Chave do aluno no ranking (a ordem da árvore é sempre crescente)
+static uint32_t chave_ranking(const RankingDinamico *ranking, float nf) {
+    uint32_t chave = chave_nota_final(nf);
+    return ranking->ordem == ORDEM_DECRESCENTE ? ~chave : chave;
+}
+
+// 1 se o aluno "a" vem antes do aluno "b" no ranking (empate: menor posição no array)
+static int vem_antes(const RankingDinamico *ranking, int a, int b) {
+    uint32_t chave_a = ranking->nos[a].chave;
+    uint32_t chave_b = ranking->nos[b].chave;
+    return chave_a < chave_b || (chave_a == chave_b && a < b);
+}
+
+static int tamanho_subarvore(const RankingDinamico *ranking, int no) {
+    return no == RANKING_NULO ? 0 : ranking->nos[no].tamanho;
+}
+
+static void atualizar_tamanho(RankingDinamico *ranking, int no) {
+    ranking->nos[no].tamanho = 1 + tamanho_subarvore(ranking, ranking->nos[no].esq) +
+                               tamanho_subarvore(ranking, ranking->nos[no].dir);
+}
+
+// Calcula o tamanho de todas as subárvores (pós-ordem)
+static void calcular_tamanhos(RankingDinamico *ranking, int no) {
+    if (no == RANKING_NULO) {
+        return;
+    }
+    calcular_tamanhos(ranking, ranking->nos[no].esq);
+    calcular_tamanhos(ranking, ranking->nos[no].dir);
+    atualizar_tamanho(ranking, no);
+}
+
+// Cria o ranking dos alunos (ordenação inicial por ranking_alunos, depois O(n))
+// Retorna 1 em caso de sucesso e 0 se faltar memória
+int criar_ranking_dinamico(RankingDinamico *ranking, const Aluno *alunos, int num_alunos, OrdemRanking ordem) {
+    ranking->ordem = ordem;
+    ranking->num_alunos = num_alunos;
+    ranking->raiz = RANKING_NULO;
+    ranking->nos = (NoRanking*) malloc((size_t) (num_alunos > 0 ? num_alunos : 1) * sizeof(NoRanking));
+    if (!ranking->nos) {
+        return 0;
+    }
+    if (num_alunos <= 0) {
+        return 1;
+    }
+
+    int *indices = ranking_alunos(alunos, num_alunos, ordem, DESEMPATE_NENHUM);
+    int *pilha = (int*) malloc((size_t) num_alunos * sizeof(int));
+    if (!indices || !pilha) {
+        free(indices);
+        free(pilha);
+        liberar_ranking_dinamico(ranking);
+        return 0;
+    }
+
+    // Com os alunos já em ordem, a árvore é montada com uma pilha do caminho mais à direita:
+    // cada aluno novo fica à direita do último nó com prioridade maior que a sua
+    uint32_t semente = 2463534242u;
+    int topo = 0;
+    for (int i = 0; i < num_alunos; i++) {
+        int aluno = indices[i];
+        NoRanking *no = &ranking->nos[aluno];
+        semente ^= semente << 13;
+        semente ^= semente >> 17;
+        semente ^= semente << 5;
+        no->chave = chave_ranking(ranking, alunos[aluno].nf);
+        no->prioridade = semente;
+        no->dir = RANKING_NULO;
+
+        int ultimo = RANKING_NULO;
+        while (topo > 0 && ranking->nos[pilha[topo - 1]].prioridade < no->prioridade) {
+            ultimo = pilha[--topo];
+        }
+        no->esq = ultimo;
+        if (topo > 0) {
+            ranking->nos[pilha[topo - 1]].dir = aluno;
+        }
+        pilha[topo++] = aluno;
+    }
+    ranking->raiz = pilha[0];
+    calcular_tamanhos(ranking, ranking->raiz);
+
+    free(indices);
+    free(pilha);
+    return 1;
+}
+
+// Libera a memória do ranking
+void liberar_ranking_dinamico(RankingDinamico *ranking) {
+    free(ranking->nos);
+    ranking->nos = NULL;
+    ranking->raiz = RANKING_NULO;
+    ranking->num_alunos = 0;
+}
+
+// Junta duas árvores (todos os nós de "a" vêm antes dos de "b")
+static int juntar(RankingDinamico *ranking, int a, int b) {
+    if (a == RANKING_NULO) {
+        return b;
+    }
+    if (b == RANKING_NULO) {
+        return a;
+    }
+    if (ranking->nos[a].prioridade > ranking->nos[b].prioridade) {
+        ranking->nos[a].dir = juntar(ranking, ranking->nos[a].dir, b);
+        atualizar_tamanho(ranking, a);
+        return a;
+    }
+    ranking->nos[b].esq = juntar(ranking, a, ranking->nos[b].esq);
+    atualizar_tamanho(ranking, b);
+    return b;
+}
+
+// Divide a árvore em nós que vêm antes e depois do aluno "alvo" (que não está nela)
+static void dividir(RankingDinamico *ranking, int no, int alvo, int *antes, int *depois) {
+    if (no == RANKING_NULO) {
+        *antes = RANKING_NULO;
+        *depois = RANKING_NULO;
+        return;
+    }
+    if (vem_antes(ranking, no, alvo)) {
+        dividir(ranking, ranking->nos[no].dir, alvo, &ranking->nos[no].dir, depois);
+        *antes = no;
+    } else {
+        dividir(ranking, ranking->nos[no].esq, alvo, antes, &ranking->nos[no].esq);
+        *depois = no;
+    }
+    atualizar_tamanho(ranking, no);
+}
+
+// Insere o nó do aluno "alvo" (chave já preenchida) e retorna a nova raiz da subárvore
+static int inserir_no(RankingDinamico *ranking, int no, int alvo) {
+    if (no == RANKING_NULO || ranking->nos[alvo].prioridade > ranking->nos[no].prioridade) {
+        dividir(ranking, no, alvo, &ranking->nos[alvo].esq, &ranking->nos[alvo].dir);
+        atualizar_tamanho(ranking, alvo);
+        return alvo;
+    }
+    if (vem_antes(ranking, alvo, no)) {
+        ranking->nos[no].esq = inserir_no(ranking, ranking->nos[no].esq, alvo);
+    } else {
+        ranking->nos[no].dir = inserir_no(ranking, ranking->nos[no].dir, alvo);
+    }
+    ranking->nos[no].tamanho++;
+    return no;
+}
+
+// Retira o nó do aluno "alvo" e retorna a nova raiz da subárvore
+static int remover_no(RankingDinamico *ranking, int no, int alvo) {
+    if (no == alvo) {
+        return juntar(ranking, ranking->nos[no].esq, ranking->nos[no].dir);
+    }
+    if (vem_antes(ranking, alvo, no)) {
+        ranking->nos[no].esq = remover_no(ranking, ranking->nos[no].esq, alvo);
+    } else {
+        ranking->nos[no].dir = remover_no(ranking, ranking->nos[no].dir, alvo);
+    }
+    ranking->nos[no].tamanho--;
+    return no;
+}
+
+// Retorna a posição (a partir de 1) do aluno no ranking
+int posicao_no_ranking(const RankingDinamico *ranking, int aluno) {
+    int posicao = 0;
+    int no = ranking->raiz;
+    while (no != RANKING_NULO) {
+        if (no == aluno) {
+            return posicao + tamanho_subarvore(ranking, ranking->nos[no].esq) + 1;
+        }
+        if (vem_antes(ranking, aluno, no)) {
+            no = ranking->nos[no].esq;
+        } else {
+            posicao += tamanho_subarvore(ranking, ranking->nos[no].esq) + 1;
+            no = ranking->nos[no].dir;
+        }
+    }
+    return -1;
+}
+
+// Retorna o aluno (posição no array) que ocupa a posição (a partir de 1) do ranking,
+// ou -1 se a posição não existir
+int aluno_na_posicao(const RankingDinamico *ranking, int posicao) {
+    int no = ranking->raiz;
+    while (no != RANKING_NULO) {
+        int antes = tamanho_subarvore(ranking, ranking->nos[no].esq);
+        if (posicao == antes + 1) {
+            return no;
+        }
+        if (posicao <= antes) {
+            no = ranking->nos[no].esq;
+        } else {
+            posicao -= antes + 1;
+            no = ranking->nos[no].dir;
+        }
+    }
+    return -1;
+}
+
+// Move o aluno para a posição correspondente à nova NF em O(log n)
+void atualizar_ranking_dinamico(RankingDinamico *ranking, int aluno, float nf) {
+    ranking->raiz = remover_no(ranking, ranking->raiz, aluno);
+    ranking->nos[aluno].chave = chave_ranking(ranking, nf);
+    ranking->raiz = inserir_no(ranking, ranking->raiz, aluno);
+}
+
+// Percorre a árvore em ordem, preenchendo "indices" a partir de "*proximo"
+static void percorrer_em_ordem(const RankingDinamico *ranking, int no, int *indices, int *proximo) {
+    while (no != RANKING_NULO) {
+        percorrer_em_ordem(ranking, ranking->nos[no].esq, indices, proximo);
+        indices[(*proximo)++] = no;
+        no = ranking->nos[no].dir;
+    }
+}
+
+// Preenche "indices" (num_alunos posições) com os alunos na ordem do ranking,
+// no mesmo formato de ranking_alunos (pode ser usado com aplicar_ranking)
+void indices_ranking_dinamico(const RankingDinamico *ranking, int *indices) {
+    int proximo = 0;
+    percorrer_em_ordem(ranking, ranking->raiz, indices, &proximo);
+}
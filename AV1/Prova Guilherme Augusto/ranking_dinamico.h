@@ -0,0 +1,39 @@
+#ifndef RANKING_DINAMICO_H
+#define RANKING_DINAMICO_H
+
+#include <stdint.h>
+#include "utils.h"
+#include "ranking.h"
+
+// Ranking que acompanha mudanças de nota sem reordenar o array inteiro
+// É uma treap (árvore de busca com prioridades aleatórias) em que cada nó guarda
+// o tamanho da sua subárvore, então a posição de um aluno e o k-ésimo colocado
+// saem em O(log n). O nó de cada aluno tem o mesmo número da sua posição no array
+// A ordem é a mesma de ranking_alunos com DESEMPATE_NENHUM: NF e, no empate, a posição no array
+
+#define RANKING_NULO (-1)
+
+typedef struct {
+    uint32_t chave;         // chave_nota_final da NF (invertida na ordem decrescente)
+    uint32_t prioridade;    // Prioridade aleatória (heap de máximo)
+    int esq;
+    int dir;
+    int tamanho;            // Número de nós da subárvore
+} NoRanking;
+
+typedef struct {
+    NoRanking *nos;         // Um nó por aluno, na mesma posição do array de alunos
+    int raiz;
+    int num_alunos;
+    OrdemRanking ordem;
+} RankingDinamico;
+
+// Protótipos das funções em ranking_dinamico.c
+int criar_ranking_dinamico(RankingDinamico *ranking, const Aluno *alunos, int num_alunos, OrdemRanking ordem);
+void liberar_ranking_dinamico(RankingDinamico *ranking);
+int posicao_no_ranking(const RankingDinamico *ranking, int aluno);
+int aluno_na_posicao(const RankingDinamico *ranking, int posicao);
+void atualizar_ranking_dinamico(RankingDinamico *ranking, int aluno, float nf);
+void indices_ranking_dinamico(const RankingDinamico *ranking, int *indices);
+
+#endif
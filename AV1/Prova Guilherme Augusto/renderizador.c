@@ -0,0 +1,287 @@
+#include "renderizador.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#endif
+
+FormatoSaida formato_saida_padrao = SAIDA_TABELA;
+ModoCor modo_cor_padrao = COR_AUTO;
+
+// Converte o nome de um formato ("tabela", "csv" ou "tsv")
+// Retorna 1 em caso de sucesso e 0 se o nome não for reconhecido
+int ler_formato_saida(const char *nome, FormatoSaida *formato) {
+    if (strcmp(nome, "tabela") == 0) {
+        *formato = SAIDA_TABELA;
+    } else if (strcmp(nome, "csv") == 0) {
+        *formato = SAIDA_CSV;
+    } else if (strcmp(nome, "tsv") == 0) {
+        *formato = SAIDA_TSV;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+// Converte o modo de cor ("sempre", "nunca" ou "auto")
+// Retorna 1 em caso de sucesso e 0 se o nome não for reconhecido
+int ler_modo_cor(const char *nome, ModoCor *cor) {
+    if (strcmp(nome, "sempre") == 0) {
+        *cor = COR_SEMPRE;
+    } else if (strcmp(nome, "nunca") == 0) {
+        *cor = COR_NUNCA;
+    } else if (strcmp(nome, "auto") == 0) {
+        *cor = COR_AUTO;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+// Prepara o renderizador para escrever em "saida"
+// No modo COR_AUTO as cores só são usadas quando a saída é um terminal
+// Retorna 1 em caso de sucesso e 0 se faltar memória
+int iniciar_renderizador(Renderizador *r, FILE *saida, FormatoSaida formato, ModoCor cor) {
+    r->saida = saida;
+    r->usado = 0;
+    r->formato = formato;
+    r->buffer = (char*) malloc(TAMANHO_BUFFER_SAIDA);
+    if (cor == COR_AUTO) {
+        r->cor = isatty(fileno(saida));
+    } else {
+        r->cor = (cor == COR_SEMPRE);
+    }
+    return r->buffer != NULL;
+}
+
+// Escreve o conteúdo do buffer no arquivo de saída
+void descarregar_renderizador(Renderizador *r) {
+    if (r->usado == 0) {
+        return;
+    }
+    // O que já foi escrito com printf precisa sair antes
+    fflush(r->saida);
+#ifndef _WIN32
+    const char *p = r->buffer;
+    size_t restante = r->usado;
+    while (restante > 0) {
+        ssize_t escritos = write(fileno(r->saida), p, restante);
+        if (escritos <= 0) {
+            break;
+        }
+        p += escritos;
+        restante -= (size_t) escritos;
+    }
+#else
+    fwrite(r->buffer, 1, r->usado, r->saida);
+    fflush(r->saida);
+#endif
+    r->usado = 0;
+}
+
+// Escreve o que falta e libera o buffer
+void finalizar_renderizador(Renderizador *r) {
+    descarregar_renderizador(r);
+    free(r->buffer);
+    r->buffer = NULL;
+}
+
+// Garante espaço para "tamanho" bytes no buffer, escrevendo o conteúdo atual se preciso
+static void reservar_saida(Renderizador *r, size_t tamanho) {
+    if (r->usado + tamanho > TAMANHO_BUFFER_SAIDA) {
+        descarregar_renderizador(r);
+    }
+}
+
+// Copia texto para o buffer (textos maiores que o buffer são escritos em partes)
+void renderizar_texto(Renderizador *r, const char *texto, size_t tamanho) {
+    while (tamanho > 0) {
+        reservar_saida(r, tamanho < TAMANHO_BUFFER_SAIDA ? tamanho : TAMANHO_BUFFER_SAIDA);
+        size_t parte = TAMANHO_BUFFER_SAIDA - r->usado;
+        if (parte > tamanho) {
+            parte = tamanho;
+        }
+        memcpy(r->buffer + r->usado, texto, parte);
+        r->usado += parte;
+        texto += parte;
+        tamanho -= parte;
+    }
+}
+
+// Completa com espaços até "largura" (alinhamento à esquerda, como "%-Ns")
+static void completar_espacos(Renderizador *r, size_t escritos, int largura) {
+    if (largura <= 0 || escritos >= (size_t) largura) {
+        return;
+    }
+    size_t faltam = (size_t) largura - escritos;
+    reservar_saida(r, faltam);
+    memset(r->buffer + r->usado, ' ', faltam);
+    r->usado += faltam;
+}
+
+// Escreve os dígitos de "valor" em "destino" e retorna quantos foram escritos
+static int escrever_digitos(char *destino, unsigned long long valor) {
+    char temp[24];
+    int n = 0;
+    do {
+        temp[n++] = (char) ('0' + valor % 10);
+        valor /= 10;
+    } while (valor > 0);
+    for (int i = 0; i < n; i++) {
+        destino[i] = temp[n - 1 - i];
+    }
+    return n;
+}
+
+// Escreve um inteiro alinhado à esquerda, como "%-Nd" (largura 0 = sem alinhamento)
+void renderizar_int(Renderizador *r, int valor, int largura) {
+    char texto[16];
+    int n = 0;
+    unsigned long long absoluto = valor < 0 ? -(long long) valor : valor;
+    if (valor < 0) {
+        texto[n++] = '-';
+    }
+    n += escrever_digitos(texto + n, absoluto);
+    renderizar_texto(r, texto, n);
+    completar_espacos(r, n, largura);
+}
+
+// Escreve um texto alinhado à esquerda, como "%-Ns"
+void renderizar_string(Renderizador *r, const char *texto, int largura) {
+    size_t tamanho = strlen(texto);
+    renderizar_texto(r, texto, tamanho);
+    completar_espacos(r, tamanho, largura);
+}
+
+// Escreve um float com 2 casas decimais alinhado à esquerda, como "%-N.2f"
+// O valor * 100 é exato em double (24 bits de mantissa vezes 100 cabem em 53 bits),
+// então basta arredondar para o par mais próximo, como faz o printf
+void renderizar_float2(Renderizador *r, float valor, int largura) {
+    double d = valor;
+    if (d != d || d > 1e15 || d < -1e15) {
+        // NaN, infinitos e valores enormes ficam com o printf
+        char texto[64];
+        int n = snprintf(texto, sizeof(texto), "%.2f", d);
+        renderizar_texto(r, texto, (size_t) n);
+        completar_espacos(r, (size_t) n, largura);
+        return;
+    }
+
+    int negativo = (d < 0) || (d == 0 && 1 / d < 0); // -0.0 também leva sinal
+    double centesimos = (negativo ? -d : d) * 100.0;
+    unsigned long long inteiro = (unsigned long long) centesimos;
+    double resto = centesimos - (double) inteiro;
+    if (resto > 0.5 || (resto == 0.5 && (inteiro & 1))) {
+        inteiro++;
+    }
+
+    char texto[32];
+    int n = 0;
+    if (negativo) {
+        texto[n++] = '-';
+    }
+    n += escrever_digitos(texto + n, inteiro / 100);
+    texto[n++] = '.';
+    texto[n++] = (char) ('0' + (inteiro % 100) / 10);
+    texto[n++] = (char) ('0' + inteiro % 10);
+    renderizar_texto(r, texto, (size_t) n);
+    completar_espacos(r, (size_t) n, largura);
+}
+
+// Escreve um valor em centésimos com 2 casas decimais (725 -> "7.25"), como "%-N.2f"
+// Usado pelo modo compacto, em que as notas já são inteiras
+void renderizar_centesimos(Renderizador *r, int centesimos, int largura) {
+    char texto[24];
+    int n = 0;
+    unsigned long long absoluto = centesimos < 0 ? -(long long) centesimos : centesimos;
+    if (centesimos < 0) {
+        texto[n++] = '-';
+    }
+    n += escrever_digitos(texto + n, absoluto / 100);
+    texto[n++] = '.';
+    texto[n++] = (char) ('0' + (absoluto % 100) / 10);
+    texto[n++] = (char) ('0' + absoluto % 10);
+    renderizar_texto(r, texto, (size_t) n);
+    completar_espacos(r, (size_t) n, largura);
+}
+
+// Nomes das colunas nos formatos CSV e TSV
+static const char *colunas_csv[] = {
+    "matricula", "nome", "av1ap1", "av1ap2", "av1ap3", "np1", "av2ap1", "av2ap2", "av2ap3", "np2", "nf", "status"
+};
+
+// Escreve o cabeçalho no formato do renderizador
+void renderizar_cabecalho(Renderizador *r) {
+    if (r->formato == SAIDA_TABELA) {
+        static const char cabecalho[] =
+            "\n"
+            " Matricula | Nome                           | AV1:AP1  | AV1:AP2  | AV1:AP3  | NP1      | AV2:AP1  | AV2:AP2  | AV2:AP3  | NP2      | NF       | Status    \n"
+            "-----------|--------------------------------|----------|----------|----------|----------|----------|----------|----------|----------|----------|------------\n";
+        renderizar_texto(r, cabecalho, sizeof(cabecalho) - 1);
+        return;
+    }
+
+    char separador = r->formato == SAIDA_TSV ? '\t' : ',';
+    for (int i = 0; i < 12; i++) {
+        if (i > 0) {
+            renderizar_texto(r, &separador, 1);
+        }
+        renderizar_string(r, colunas_csv[i], 0);
+    }
+    renderizar_texto(r, "\n", 1);
+}
+
+// Escreve um aluno no formato do renderizador
+// Na tabela, a linha é a mesma do printf original de listar_alunos (vermelha se reprovado)
+void renderizar_aluno(Renderizador *r, const Aluno *aluno) {
+    const Avaliacao *avaliacoes = avaliacoes_aluno(aluno);
+    const float notas[9] = {
+        avaliacoes[0].ap1, avaliacoes[0].ap2, avaliacoes[0].ap3, avaliacoes[0].np,
+        avaliacoes[1].ap1, avaliacoes[1].ap2, avaliacoes[1].ap3, avaliacoes[1].np,
+        aluno->nf
+    };
+    const char *status = aluno->status == 1 ? "Aprovado" : "Reprovado";
+
+    if (r->formato == SAIDA_TABELA) {
+        int vermelho = r->cor && aluno->status == 0;
+        if (vermelho) {
+            renderizar_texto(r, RED_TEXT, sizeof(RED_TEXT) - 1);
+        }
+        renderizar_int(r, aluno->matricula, 10);
+        renderizar_texto(r, " | ", 3);
+        renderizar_string(r, nome_aluno(aluno), 30);
+        for (int i = 0; i < 9; i++) {
+            renderizar_texto(r, " | ", 3);
+            renderizar_float2(r, notas[i], 8);
+        }
+        renderizar_texto(r, " | ", 3);
+        renderizar_string(r, status, 10);
+        if (vermelho) {
+            renderizar_texto(r, RESET_TEXT, sizeof(RESET_TEXT) - 1);
+        }
+        renderizar_texto(r, "\n", 1);
+        return;
+    }
+
+    char separador = r->formato == SAIDA_TSV ? '\t' : ',';
+    renderizar_int(r, aluno->matricula, 0);
+    renderizar_texto(r, &separador, 1);
+    renderizar_string(r, nome_aluno(aluno), 0);
+    for (int i = 0; i < 9; i++) {
+        renderizar_texto(r, &separador, 1);
+        renderizar_float2(r, notas[i], 0);
+    }
+    renderizar_texto(r, &separador, 1);
+    renderizar_string(r, status, 0);
+    renderizar_texto(r, "\n", 1);
+}
+
+// Fecha a listagem (a tabela termina com uma linha em branco)
+void renderizar_rodape(Renderizador *r) {
+    if (r->formato == SAIDA_TABELA) {
+        renderizar_texto(r, "\n", 1);
+    }
+}
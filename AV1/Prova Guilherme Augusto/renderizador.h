@@ -0,0 +1,53 @@
+#ifndef RENDERIZADOR_H
+#define RENDERIZADOR_H
+
+#include "utils.h"
+
+// Renderização da lista de alunos em um buffer grande, escrito com poucas chamadas a write
+// Substitui os printf por aluno: os números são formatados por funções próprias
+// (inteiros alinhados e floats com 2 casas) que geram os mesmos bytes que o printf
+
+#define TAMANHO_BUFFER_SAIDA (256 * 1024)
+
+// Formato das linhas impressas
+typedef enum {
+    SAIDA_TABELA = 0,   // Tabela de listar_alunos
+    SAIDA_CSV,          // CSV com as notas ajustadas, nf e status
+    SAIDA_TSV           // Igual ao CSV, separado por tabulação
+} FormatoSaida;
+
+// Uso das cores ANSI na tabela
+typedef enum {
+    COR_AUTO = 0,       // Só usa cores se a saída for um terminal
+    COR_SEMPRE,
+    COR_NUNCA
+} ModoCor;
+
+typedef struct {
+    FILE *saida;            // Arquivo de destino (o buffer do stdio é esvaziado antes de cada escrita)
+    char *buffer;           // Buffer de saída
+    size_t usado;           // Bytes ocupados no buffer
+    FormatoSaida formato;
+    int cor;                // 1 se as cores ANSI estão ativas
+} Renderizador;
+
+// Formato e cor usados por listar_alunos (definidos pela linha de comando)
+extern FormatoSaida formato_saida_padrao;
+extern ModoCor modo_cor_padrao;
+
+// Protótipos das funções em renderizador.c
+int ler_formato_saida(const char *nome, FormatoSaida *formato);
+int ler_modo_cor(const char *nome, ModoCor *cor);
+int iniciar_renderizador(Renderizador *r, FILE *saida, FormatoSaida formato, ModoCor cor);
+void finalizar_renderizador(Renderizador *r);
+void descarregar_renderizador(Renderizador *r);
+void renderizar_texto(Renderizador *r, const char *texto, size_t tamanho);
+void renderizar_int(Renderizador *r, int valor, int largura);
+void renderizar_string(Renderizador *r, const char *texto, int largura);
+void renderizar_float2(Renderizador *r, float valor, int largura);
+void renderizar_centesimos(Renderizador *r, int centesimos, int largura);
+void renderizar_cabecalho(Renderizador *r);
+void renderizar_aluno(Renderizador *r, const Aluno *aluno);
+void renderizar_rodape(Renderizador *r);
+
+#endif
@@ -0,0 +1,259 @@
+#include "snapshot.h"
+
+#include <limits.h>
+#include <sys/stat.h>
+
+// Posição de cada seção dentro do arquivo
+typedef struct {
+    size_t matricula;
+    size_t notas[SNAPSHOT_COLUNAS_NOTAS];
+    size_t nf;
+    size_t status;
+    size_t num_avaliacoes;
+    size_t deslocamento_nome;
+    size_t nomes;
+    size_t total;
+} SecoesSnapshot;
+
+// Calcula onde começa cada seção para "n" alunos e "tamanho_nomes" bytes de nomes
+static void calcular_secoes(size_t n, size_t tamanho_nomes, SecoesSnapshot *secoes) {
+    size_t pos = sizeof(CabecalhoSnapshot);
+    secoes->matricula = pos;          pos += alinhar_secao(n * sizeof(int32_t));
+    for (int c = 0; c < SNAPSHOT_COLUNAS_NOTAS; c++) {
+        secoes->notas[c] = pos;       pos += alinhar_secao(n * sizeof(float));
+    }
+    secoes->nf = pos;                 pos += alinhar_secao(n * sizeof(float));
+    secoes->status = pos;             pos += alinhar_secao(n);
+    secoes->num_avaliacoes = pos;     pos += alinhar_secao(n);
+    secoes->deslocamento_nome = pos;  pos += alinhar_secao(n * sizeof(uint32_t));
+    secoes->nomes = pos;              pos += alinhar_secao(tamanho_nomes);
+    secoes->total = pos;
+}
+
+// Tamanho e data de modificação do CSV, usados para saber se o snapshot está atualizado
+static int informacoes_csv(const char *nome_csv, uint64_t *tamanho, int64_t *modificacao) {
+    struct stat info;
+    if (stat(nome_csv, &info) != 0) {
+        return 0;
+    }
+    *tamanho = (uint64_t) info.st_size;
+#if defined(__linux__)
+    *modificacao = (int64_t) info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec;
+#else
+    *modificacao = (int64_t) info.st_mtime * 1000000000;
+#endif
+    return 1;
+}
+
+// Grava os alunos em "nome_snapshot", marcando o tamanho e a data do CSV de origem
+// O arquivo é gravado de forma atômica (substituir_arquivo), então um snapshot pela
+// metade nunca é usado
+// Só as AVALIACOES_FIXAS primeiras avaliações de cada aluno são guardadas
+// Retorna 1 em caso de sucesso e 0 em caso de erro
+int salvar_snapshot(const char *nome_snapshot, const char *nome_csv, const Aluno *alunos, int num_alunos) {
+    CabecalhoSnapshot cabecalho;
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.magica, SNAPSHOT_MAGICA, sizeof(cabecalho.magica));
+    cabecalho.versao = SNAPSHOT_VERSAO;
+    cabecalho.ordem_bytes = SNAPSHOT_ORDEM_BYTES;
+    cabecalho.num_alunos = (uint64_t) num_alunos;
+    if (!informacoes_csv(nome_csv, &cabecalho.tamanho_csv, &cabecalho.modificacao_csv)) {
+        return 0;
+    }
+
+    size_t n = (size_t) num_alunos;
+    size_t tamanho_nomes = 0;
+    for (size_t i = 0; i < n; i++) {
+        tamanho_nomes += (size_t) alunos[i].nome.tamanho + 1;
+    }
+    if (tamanho_nomes > UINT32_MAX) {
+        fprintf(stderr, "Erro ao salvar snapshot: nomes excedem o limite do formato\n");
+        return 0;
+    }
+    cabecalho.tamanho_nomes = tamanho_nomes;
+
+    // Um buffer serve para todas as colunas de 4 bytes; os nomes têm o seu
+    char *coluna = (char*) malloc(alinhar_secao(n * 4) + SNAPSHOT_ALINHAMENTO);
+    char *nomes = (char*) malloc(alinhar_secao(tamanho_nomes) + SNAPSHOT_ALINHAMENTO);
+    char nome_temporario[FILENAME_MAX];
+    FILE *fp = (coluna && nomes) ? abrir_arquivo_temporario(nome_snapshot, nome_temporario, sizeof(nome_temporario)) : NULL;
+    if (!fp) {
+        free(coluna);
+        free(nomes);
+        return 0;
+    }
+
+    // O cabeçalho é gravado de novo no final, com o checksum
+    uint64_t checksum = CHECKSUM_INICIAL;
+    int ok = fwrite(&cabecalho, sizeof(cabecalho), 1, fp) == 1;
+
+    int32_t *matriculas = (int32_t*) coluna;
+    for (size_t i = 0; i < n; i++) {
+        matriculas[i] = alunos[i].matricula;
+    }
+    ok = ok && escrever_secao(fp, coluna, n * sizeof(int32_t), &checksum);
+
+    float *notas = (float*) coluna;
+    for (int c = 0; c < SNAPSHOT_COLUNAS_NOTAS; c++) {
+        int a = c / 4;
+        for (size_t i = 0; i < n; i++) {
+            const Avaliacao *av = avaliacoes_aluno(&alunos[i]);
+            Avaliacao nota = a < alunos[i].num_avaliacoes ? av[a] : (Avaliacao){0, 0, 0, 0};
+            switch (c % 4) {
+                case 0: notas[i] = nota.ap1; break;
+                case 1: notas[i] = nota.ap2; break;
+                case 2: notas[i] = nota.ap3; break;
+                default: notas[i] = nota.np; break;
+            }
+        }
+        ok = ok && escrever_secao(fp, coluna, n * sizeof(float), &checksum);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        notas[i] = alunos[i].nf;
+    }
+    ok = ok && escrever_secao(fp, coluna, n * sizeof(float), &checksum);
+
+    uint8_t *bytes = (uint8_t*) coluna;
+    for (size_t i = 0; i < n; i++) {
+        bytes[i] = (uint8_t) alunos[i].status;
+    }
+    ok = ok && escrever_secao(fp, coluna, n, &checksum);
+
+    for (size_t i = 0; i < n; i++) {
+        int num = alunos[i].num_avaliacoes;
+        bytes[i] = (uint8_t) (num < AVALIACOES_FIXAS ? num : AVALIACOES_FIXAS);
+    }
+    ok = ok && escrever_secao(fp, coluna, n, &checksum);
+
+    uint32_t *deslocamentos = (uint32_t*) coluna;
+    size_t pos = 0;
+    for (size_t i = 0; i < n; i++) {
+        size_t tamanho = (size_t) alunos[i].nome.tamanho + 1;
+        deslocamentos[i] = (uint32_t) pos;
+        memcpy(nomes + pos, nome_aluno(&alunos[i]), tamanho);
+        pos += tamanho;
+    }
+    ok = ok && escrever_secao(fp, coluna, n * sizeof(uint32_t), &checksum);
+    ok = ok && escrever_secao(fp, nomes, tamanho_nomes, &checksum);
+
+    cabecalho.checksum = checksum;
+    ok = ok && fseek(fp, 0, SEEK_SET) == 0 && fwrite(&cabecalho, sizeof(cabecalho), 1, fp) == 1;
+    free(coluna);
+    free(nomes);
+    return substituir_arquivo(fp, nome_temporario, nome_snapshot, ok);
+}
+
+// Monta os alunos a partir do snapshot "nome_snapshot", se ele for do CSV "nome_csv" atual
+// Retorna NULL (sem mensagem) se o snapshot não existir ou estiver desatualizado,
+// e também, com uma mensagem, se estiver corrompido
+Aluno *carregar_snapshot(const char *nome_snapshot, const char *nome_csv, int *num_alunos) {
+    uint64_t tamanho_csv;
+    int64_t modificacao_csv;
+    if (!informacoes_csv(nome_csv, &tamanho_csv, &modificacao_csv)) {
+        return NULL;
+    }
+
+    ArquivoMapeado arquivo;
+    if (!mapear_arquivo_binario(nome_snapshot, &arquivo)) {
+        return NULL;
+    }
+
+    // Confere o cabeçalho e se o CSV mudou desde que o snapshot foi gravado
+    CabecalhoSnapshot cabecalho;
+    if (arquivo.tamanho < sizeof(cabecalho)) {
+        desmapear_arquivo(&arquivo);
+        return NULL;
+    }
+    memcpy(&cabecalho, arquivo.dados, sizeof(cabecalho));
+    if (memcmp(cabecalho.magica, SNAPSHOT_MAGICA, sizeof(cabecalho.magica)) != 0 ||
+        cabecalho.versao != SNAPSHOT_VERSAO || cabecalho.ordem_bytes != SNAPSHOT_ORDEM_BYTES ||
+        cabecalho.tamanho_csv != tamanho_csv || cabecalho.modificacao_csv != modificacao_csv ||
+        cabecalho.num_alunos > INT_MAX || cabecalho.tamanho_nomes > UINT32_MAX) {
+        desmapear_arquivo(&arquivo);
+        return NULL;
+    }
+
+    size_t n = (size_t) cabecalho.num_alunos;
+    SecoesSnapshot secoes;
+    calcular_secoes(n, (size_t) cabecalho.tamanho_nomes, &secoes);
+    const char *dados = arquivo.dados;
+    const char *nomes = dados + secoes.nomes;
+    size_t tamanho_nomes = (size_t) cabecalho.tamanho_nomes;
+    if (secoes.total != arquivo.tamanho ||
+        atualizar_checksum(0xcbf29ce484222325ull, dados + sizeof(cabecalho), secoes.total - sizeof(cabecalho)) != cabecalho.checksum ||
+        (tamanho_nomes > 0 && nomes[tamanho_nomes - 1] != '\0')) {
+        fprintf(stderr, "Snapshot %s corrompido, será recriado\n", nome_snapshot);
+        desmapear_arquivo(&arquivo);
+        return NULL;
+    }
+
+    Aluno *alunos = (Aluno*) malloc((n > 0 ? n : 1) * sizeof(Aluno));
+    if (!alunos) {
+        perror("Erro ao alocar memória para alunos");
+        desmapear_arquivo(&arquivo);
+        return NULL;
+    }
+
+    // As colunas são lidas direto do mapeamento (todas alinhadas em 64 bytes)
+    const int32_t *matriculas = (const int32_t*) (dados + secoes.matricula);
+    const float *notas[SNAPSHOT_COLUNAS_NOTAS];
+    for (int c = 0; c < SNAPSHOT_COLUNAS_NOTAS; c++) {
+        notas[c] = (const float*) (dados + secoes.notas[c]);
+    }
+    const float *nf = (const float*) (dados + secoes.nf);
+    const uint8_t *status = (const uint8_t*) (dados + secoes.status);
+    const uint8_t *num_avaliacoes = (const uint8_t*) (dados + secoes.num_avaliacoes);
+    const uint32_t *deslocamentos = (const uint32_t*) (dados + secoes.deslocamento_nome);
+
+    for (size_t i = 0; i < n; i++) {
+        Aluno *aluno = &alunos[i];
+        aluno->matricula = matriculas[i];
+
+        // Um deslocamento inválido vira nome vazio (o '\0' final da tabela)
+        const char *nome = deslocamentos[i] < tamanho_nomes ? nomes + deslocamentos[i] : "";
+        size_t limite = tamanho_nomes - (size_t) (deslocamentos[i] < tamanho_nomes ? deslocamentos[i] : 0);
+        if (!arena_adicionar(&arena_nomes, nome, strnlen(nome, limite), &aluno->nome)) {
+            perror("Erro ao alocar memória para os nomes");
+            free(alunos);
+            desmapear_arquivo(&arquivo);
+            return NULL;
+        }
+
+        for (int a = 0; a < AVALIACOES_FIXAS; a++) {
+            aluno->avaliacoes_fixas[a].ap1 = notas[4 * a][i];
+            aluno->avaliacoes_fixas[a].ap2 = notas[4 * a + 1][i];
+            aluno->avaliacoes_fixas[a].ap3 = notas[4 * a + 2][i];
+            aluno->avaliacoes_fixas[a].np  = notas[4 * a + 3][i];
+        }
+        aluno->avaliacoes_extras = NULL;
+        aluno->num_avaliacoes = num_avaliacoes[i] < AVALIACOES_FIXAS ? num_avaliacoes[i] : AVALIACOES_FIXAS;
+        aluno->capacidade_avaliacoes = 0;
+        aluno->nf = nf[i];
+        aluno->status = status[i];
+    }
+
+    desmapear_arquivo(&arquivo);
+    *num_alunos = (int) n;
+    return alunos;
+}
+
+// Carrega os alunos do snapshot; se ele não existir, estiver desatualizado ou
+// corrompido, lê o CSV (com threads se num_threads >= 0) e grava um snapshot novo
+Aluno *carregar_alunos_snapshot(const char *nome_csv, const char *nome_snapshot, int *num_alunos, int num_threads) {
+    Aluno *alunos = carregar_snapshot(nome_snapshot, nome_csv, num_alunos);
+    if (alunos) {
+        return alunos;
+    }
+
+    *num_alunos = 0;
+    if (num_threads >= 0) {
+        alunos = carregar_alunos_paralelo(nome_csv, num_alunos, num_threads);
+    } else {
+        alunos = carregar_alunos(nome_csv, num_alunos);
+    }
+    if (alunos && !salvar_snapshot(nome_snapshot, nome_csv, alunos, *num_alunos)) {
+        perror("Erro ao salvar snapshot");
+    }
+    return alunos;
+}
@@ -0,0 +1,44 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+#include "utils.h"
+
+// Snapshot binário dos alunos já carregados e calculados (formato em colunas)
+// Evita ler e converter o CSV de novo: o arquivo é mapeado com mmap e os alunos
+// são montados copiando as colunas, sem nenhuma conversão de texto
+//
+// Layout (na ordem de bytes da máquina, cada seção começa em múltiplo de 64 bytes):
+//   CabecalhoSnapshot (64 bytes)
+//   matricula           int32[n]
+//   notas               float[n] para ap1, ap2, ap3 e np de cada avaliação fixa
+//   nf                  float[n]
+//   status              uint8[n]
+//   num_avaliacoes      uint8[n]
+//   deslocamento_nome   uint32[n]  (posição do nome na tabela de nomes)
+//   tabela de nomes     nomes terminados em '\0'
+
+#define SNAPSHOT_MAGICA "NOTASNAP"
+#define SNAPSHOT_VERSAO 1
+#define SNAPSHOT_ORDEM_BYTES BINARIO_ORDEM_BYTES
+#define SNAPSHOT_ALINHAMENTO BINARIO_ALINHAMENTO
+#define SNAPSHOT_COLUNAS_NOTAS (4 * AVALIACOES_FIXAS)
+
+typedef struct {
+    char magica[8];             // SNAPSHOT_MAGICA
+    uint32_t versao;            // SNAPSHOT_VERSAO
+    uint32_t ordem_bytes;       // SNAPSHOT_ORDEM_BYTES, para detectar outra arquitetura
+    uint64_t num_alunos;        // Número de linhas de cada coluna
+    uint64_t tamanho_nomes;     // Bytes da tabela de nomes
+    uint64_t tamanho_csv;       // Tamanho do CSV de origem
+    int64_t modificacao_csv;    // Data de modificação do CSV de origem (ns)
+    uint64_t checksum;          // Checksum de tudo o que vem depois do cabeçalho
+    uint64_t reservado;
+} CabecalhoSnapshot;
+
+// Protótipos das funções em snapshot.c
+int salvar_snapshot(const char *nome_snapshot, const char *nome_csv, const Aluno *alunos, int num_alunos);
+Aluno *carregar_snapshot(const char *nome_snapshot, const char *nome_csv, int *num_alunos);
+Aluno *carregar_alunos_snapshot(const char *nome_csv, const char *nome_snapshot, int *num_alunos, int num_threads);
+
+#endif
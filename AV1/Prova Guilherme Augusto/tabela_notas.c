@@ -0,0 +1,198 @@
+#include "tabela_notas.h"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Cada coluna é arredondada para um múltiplo de 16 floats (64 bytes),
+// assim todas começam alinhadas dentro do bloco
+#define ALINHAMENTO_COLUNA 16
+#define NUM_COLUNAS_FLOAT (4 * AVALIACOES_FIXAS + 1)
+
+// Aloca as colunas da tabela para "num_alunos" linhas em um único bloco
+// Retorna 1 em caso de sucesso e 0 se faltar memória
+int criar_tabela_notas(TabelaNotas *tabela, int num_alunos) {
+    size_t linhas = ((size_t) num_alunos + ALINHAMENTO_COLUNA - 1) / ALINHAMENTO_COLUNA * ALINHAMENTO_COLUNA;
+    if (linhas == 0) {
+        linhas = ALINHAMENTO_COLUNA;
+    }
+
+    // Espaço extra para alinhar o início do bloco em 64 bytes
+    char *bloco = (char*) malloc(linhas * (NUM_COLUNAS_FLOAT * sizeof(float) + sizeof(int)) + 64);
+    if (!bloco) {
+        return 0;
+    }
+
+    float *coluna = (float*) (((size_t) bloco + 63) & ~(size_t) 63);
+    for (int a = 0; a < AVALIACOES_FIXAS; a++) {
+        tabela->ap1[a] = coluna; coluna += linhas;
+        tabela->ap2[a] = coluna; coluna += linhas;
+        tabela->ap3[a] = coluna; coluna += linhas;
+        tabela->np[a]  = coluna; coluna += linhas;
+    }
+    tabela->nf = coluna; coluna += linhas;
+    tabela->status = (int*) coluna;
+
+    tabela->num_alunos = num_alunos;
+    tabela->bloco = bloco;
+    return 1;
+}
+
+// Libera a memória das colunas
+void liberar_tabela_notas(TabelaNotas *tabela) {
+    free(tabela->bloco);
+    tabela->bloco = NULL;
+    tabela->num_alunos = 0;
+}
+
+// Copia as notas dos alunos (formato de linhas) para as colunas da tabela
+// A tabela guarda só as AVALIACOES_FIXAS primeiras avaliações de cada aluno
+void preencher_tabela_notas(TabelaNotas *tabela, const Aluno *alunos, int num_alunos) {
+    for (int i = 0; i < num_alunos; i++) {
+        const Avaliacao *avaliacoes = avaliacoes_aluno(&alunos[i]);
+        for (int a = 0; a < AVALIACOES_FIXAS; a++) {
+            Avaliacao av = a < alunos[i].num_avaliacoes ? avaliacoes[a] : (Avaliacao){0, 0, 0, 0};
+            tabela->ap1[a][i] = av.ap1;
+            tabela->ap2[a][i] = av.ap2;
+            tabela->ap3[a][i] = av.ap3;
+            tabela->np[a][i]  = av.np;
+        }
+        tabela->nf[i] = alunos[i].nf;
+        tabela->status[i] = alunos[i].status;
+    }
+}
+
+// Copia o resultado do cálculo em lote de volta para os alunos
+// Assim como calcular_notas, alunos com menos de 2 avaliações não são alterados
+void aplicar_tabela_notas(const TabelaNotas *tabela, Aluno *alunos, int num_alunos) {
+    for (int i = 0; i < num_alunos; i++) {
+        if (alunos[i].num_avaliacoes < 2) {
+            continue;
+        }
+        Avaliacao *avaliacoes = avaliacoes_aluno_editaveis(&alunos[i]);
+        for (int a = 0; a < AVALIACOES_FIXAS; a++) {
+            avaliacoes[a].ap1 = tabela->ap1[a][i];
+            avaliacoes[a].ap2 = tabela->ap2[a][i];
+            avaliacoes[a].ap3 = tabela->ap3[a][i];
+            avaliacoes[a].np  = tabela->np[a][i];
+        }
+        // Avaliações além das fixas não estão na tabela, mas também são ajustadas
+        for (int a = AVALIACOES_FIXAS; a < alunos[i].num_avaliacoes; a++) {
+            avaliacoes[a].ap1 = ajustar_nota(avaliacoes[a].ap1);
+            avaliacoes[a].ap2 = ajustar_nota(avaliacoes[a].ap2);
+            avaliacoes[a].ap3 = ajustar_nota(avaliacoes[a].ap3);
+            avaliacoes[a].np  = ajustar_nota(avaliacoes[a].np);
+        }
+        alunos[i].nf = tabela->nf[i];
+        alunos[i].status = tabela->status[i];
+    }
+}
+
+// Calcula a nota de uma linha da tabela, com as mesmas operações de calcular_notas
+static void calcular_linha(TabelaNotas *tabela, int i) {
+    float media[AVALIACOES_FIXAS];
+    for (int a = 0; a < AVALIACOES_FIXAS; a++) {
+        tabela->ap1[a][i] = ajustar_nota(tabela->ap1[a][i]);
+        tabela->ap2[a][i] = ajustar_nota(tabela->ap2[a][i]);
+        tabela->ap3[a][i] = ajustar_nota(tabela->ap3[a][i]);
+        tabela->np[a][i]  = ajustar_nota(tabela->np[a][i]);
+        media[a] = (tabela->ap1[a][i] + tabela->ap2[a][i] + tabela->ap3[a][i] + tabela->np[a][i]) / 4.0;
+    }
+    tabela->nf[i] = (media[0] + media[1]) / 2.0;
+    tabela->status[i] = (tabela->nf[i] >= 6.0) ? 1 : 0;
+}
+
+// Ajusta as notas, calcula as médias, a nota final e o status de todos os alunos da tabela
+// O resultado é idêntico, bit a bit, ao de calcular_notas aplicado a cada aluno:
+//  - max(0, x) e min(10, x) com a constante no primeiro operando preservam NaN e -0.0,
+//    como em ajustar_nota
+//  - a soma é feita na mesma ordem, e dividir por 4.0 ou 2.0 é exato, então
+//    multiplicar por 0.25f e 0.5f gera o mesmo float
+void calcular_notas_lote(TabelaNotas *tabela) {
+    int n = tabela->num_alunos;
+    int i = 0;
+
+#if defined(__AVX512F__)
+    // 16 alunos por instrução
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 dez = _mm512_set1_ps(10.0f);
+    const __m512 quarto = _mm512_set1_ps(0.25f);
+    const __m512 meio = _mm512_set1_ps(0.5f);
+    const __m512 seis = _mm512_set1_ps(6.0f);
+    for (; i + 16 <= n; i += 16) {
+        __m512 media[AVALIACOES_FIXAS];
+        for (int a = 0; a < AVALIACOES_FIXAS; a++) {
+            __m512 ap1 = _mm512_min_ps(dez, _mm512_max_ps(zero, _mm512_loadu_ps(tabela->ap1[a] + i)));
+            __m512 ap2 = _mm512_min_ps(dez, _mm512_max_ps(zero, _mm512_loadu_ps(tabela->ap2[a] + i)));
+            __m512 ap3 = _mm512_min_ps(dez, _mm512_max_ps(zero, _mm512_loadu_ps(tabela->ap3[a] + i)));
+            __m512 np  = _mm512_min_ps(dez, _mm512_max_ps(zero, _mm512_loadu_ps(tabela->np[a] + i)));
+            _mm512_storeu_ps(tabela->ap1[a] + i, ap1);
+            _mm512_storeu_ps(tabela->ap2[a] + i, ap2);
+            _mm512_storeu_ps(tabela->ap3[a] + i, ap3);
+            _mm512_storeu_ps(tabela->np[a] + i, np);
+            media[a] = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(_mm512_add_ps(ap1, ap2), ap3), np), quarto);
+        }
+        __m512 nf = _mm512_mul_ps(_mm512_add_ps(media[0], media[1]), meio);
+        __mmask16 aprovado = _mm512_cmp_ps_mask(nf, seis, _CMP_GE_OQ);
+        _mm512_storeu_ps(tabela->nf + i, nf);
+        _mm512_storeu_si512((void*) (tabela->status + i), _mm512_maskz_set1_epi32(aprovado, 1));
+    }
+#elif defined(__AVX2__)
+    // 8 alunos por instrução
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 dez = _mm256_set1_ps(10.0f);
+    const __m256 quarto = _mm256_set1_ps(0.25f);
+    const __m256 meio = _mm256_set1_ps(0.5f);
+    const __m256 seis = _mm256_set1_ps(6.0f);
+    for (; i + 8 <= n; i += 8) {
+        __m256 media[AVALIACOES_FIXAS];
+        for (int a = 0; a < AVALIACOES_FIXAS; a++) {
+            __m256 ap1 = _mm256_min_ps(dez, _mm256_max_ps(zero, _mm256_loadu_ps(tabela->ap1[a] + i)));
+            __m256 ap2 = _mm256_min_ps(dez, _mm256_max_ps(zero, _mm256_loadu_ps(tabela->ap2[a] + i)));
+            __m256 ap3 = _mm256_min_ps(dez, _mm256_max_ps(zero, _mm256_loadu_ps(tabela->ap3[a] + i)));
+            __m256 np  = _mm256_min_ps(dez, _mm256_max_ps(zero, _mm256_loadu_ps(tabela->np[a] + i)));
+            _mm256_storeu_ps(tabela->ap1[a] + i, ap1);
+            _mm256_storeu_ps(tabela->ap2[a] + i, ap2);
+            _mm256_storeu_ps(tabela->ap3[a] + i, ap3);
+            _mm256_storeu_ps(tabela->np[a] + i, np);
+            media[a] = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(ap1, ap2), ap3), np), quarto);
+        }
+        __m256 nf = _mm256_mul_ps(_mm256_add_ps(media[0], media[1]), meio);
+        __m256 aprovado = _mm256_cmp_ps(nf, seis, _CMP_GE_OQ);
+        _mm256_storeu_ps(tabela->nf + i, nf);
+        _mm256_storeu_si256((__m256i*) (tabela->status + i), _mm256_srli_epi32(_mm256_castps_si256(aprovado), 31));
+    }
+#elif defined(__SSE2__)
+    // 4 alunos por instrução
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 dez = _mm_set1_ps(10.0f);
+    const __m128 quarto = _mm_set1_ps(0.25f);
+    const __m128 meio = _mm_set1_ps(0.5f);
+    const __m128 seis = _mm_set1_ps(6.0f);
+    for (; i + 4 <= n; i += 4) {
+        __m128 media[AVALIACOES_FIXAS];
+        for (int a = 0; a < AVALIACOES_FIXAS; a++) {
+            __m128 ap1 = _mm_min_ps(dez, _mm_max_ps(zero, _mm_loadu_ps(tabela->ap1[a] + i)));
+            __m128 ap2 = _mm_min_ps(dez, _mm_max_ps(zero, _mm_loadu_ps(tabela->ap2[a] + i)));
+            __m128 ap3 = _mm_min_ps(dez, _mm_max_ps(zero, _mm_loadu_ps(tabela->ap3[a] + i)));
+            __m128 np  = _mm_min_ps(dez, _mm_max_ps(zero, _mm_loadu_ps(tabela->np[a] + i)));
+            _mm_storeu_ps(tabela->ap1[a] + i, ap1);
+            _mm_storeu_ps(tabela->ap2[a] + i, ap2);
+            _mm_storeu_ps(tabela->ap3[a] + i, ap3);
+            _mm_storeu_ps(tabela->np[a] + i, np);
+            media[a] = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(ap1, ap2), ap3), np), quarto);
+        }
+        __m128 nf = _mm_mul_ps(_mm_add_ps(media[0], media[1]), meio);
+        __m128 aprovado = _mm_cmpge_ps(nf, seis);
+        _mm_storeu_ps(tabela->nf + i, nf);
+        _mm_storeu_si128((__m128i*) (tabela->status + i), _mm_srli_epi32(_mm_castps_si128(aprovado), 31));
+    }
+#endif
+
+    // Alunos restantes (ou todos, sem SIMD)
+    for (; i < n; i++) {
+        calcular_linha(tabela, i);
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef TABELA_NOTAS_H
+#define TABELA_NOTAS_H
+
+#include "utils.h"
+
+// Tabela de notas em colunas (structure of arrays)
+// Cada nota de cada avaliação fica em um array contíguo, o que permite
+// calcular as notas finais de vários alunos por instrução (SSE/AVX2/AVX-512)
+typedef struct {
+    int num_alunos;                 // Número de linhas da tabela
+    float *ap1[AVALIACOES_FIXAS];   // ap1[a][i]: nota ap1 da avaliação a do aluno i
+    float *ap2[AVALIACOES_FIXAS];
+    float *ap3[AVALIACOES_FIXAS];
+    float *np[AVALIACOES_FIXAS];
+    float *nf;                      // Nota final de cada aluno
+    int *status;                    // 0: Reprovado, 1: Aprovado
+    void *bloco;                    // Bloco único onde todas as colunas são alocadas
+} TabelaNotas;
+
+// Protótipos das funções em tabela_notas.c
+int criar_tabela_notas(TabelaNotas *tabela, int num_alunos);
+void liberar_tabela_notas(TabelaNotas *tabela);
+void preencher_tabela_notas(TabelaNotas *tabela, const Aluno *alunos, int num_alunos);
+void aplicar_tabela_notas(const TabelaNotas *tabela, Aluno *alunos, int num_alunos);
+void calcular_notas_lote(TabelaNotas *tabela);
+
+#endif
@@ -1,4 +1,22 @@
 #include "utils.h"
+#include "../comum/mapeamento.c"
+#include "../comum/binario.c"
+#include "../comum/vetor.c"
+#include "../comum/paralelo.c"
+#include "../comum/csv.c"
+#include "../comum/arena.c"
+#include "../comum/tempo.c"
+#include "tabela_notas.c"
+#include "ranking.c"
+#include "renderizador.c"
+#include "fluxo.c"
+#include "ordenacao_externa.c"
+#include "snapshot.c"
+#include "indice.c"
+#include "ranking_dinamico.c"
+#include "deltas.c"
+#include "estatisticas.c"
+#include "compacto.c"
 
 /* 
     ATENÇÃO: Essa função deve ser implementada
@@ -17,18 +35,21 @@ void calcular_notas(Aluno *aluno) {
         return; //nao tem avaliaoces suficientes para calcular a nota final
     }
 
+    //avaliacoes ficam no proprio aluno ou no heap, dependendo da quantidade
+    Avaliacao *avaliacoes = avaliacoes_aluno_editaveis(aluno);
+
     //ajusta as notas para o intervalo de 0 a 10, < 0 = 0, > 10 = 10
     for (int i = 0; i < aluno->num_avaliacoes; i++) {
-        aluno->avaliacoes[i].ap1 = ajustar_nota(aluno->avaliacoes[i].ap1);
-        aluno->avaliacoes[i].ap2 = ajustar_nota(aluno->avaliacoes[i].ap2);
-        aluno->avaliacoes[i].ap3 = ajustar_nota(aluno->avaliacoes[i].ap3);
-        aluno->avaliacoes[i].np  = ajustar_nota(aluno->avaliacoes[i].np);
+        avaliacoes[i].ap1 = ajustar_nota(avaliacoes[i].ap1);
+        avaliacoes[i].ap2 = ajustar_nota(avaliacoes[i].ap2);
+        avaliacoes[i].ap3 = ajustar_nota(avaliacoes[i].ap3);
+        avaliacoes[i].np  = ajustar_nota(avaliacoes[i].np);
     }
 
     //calcula a media das notas de AV1 (primeira avaliacao)
-    float av1 = (aluno->avaliacoes[0].ap1 + aluno->avaliacoes[0].ap2 + aluno->avaliacoes[0].ap3 + aluno->avaliacoes[0].np) / 4.0;
+    float av1 = (avaliacoes[0].ap1 + avaliacoes[0].ap2 + avaliacoes[0].ap3 + avaliacoes[0].np) / 4.0;
     //calcula a media das notas de AV2 (segunda avaliacao)
-    float av2 = (aluno->avaliacoes[1].ap1 + aluno->avaliacoes[1].ap2 + aluno->avaliacoes[1].ap3 + aluno->avaliacoes[1].np) / 4.0;
+    float av2 = (avaliacoes[1].ap1 + avaliacoes[1].ap2 + avaliacoes[1].ap3 + avaliacoes[1].np) / 4.0;
     //calcula a nota final (media das duas avaliacoes)
     aluno->nf = (av1 + av2) / 2.0;
 
@@ -85,11 +106,11 @@ void liberar_memoria(Aluno *alunos, int num_alunos) {
         return;
     }
     
-    //libera a memoria alocada para as avaliacoes de cada aluno
+    //libera a memoria das avaliacoes que nao couberam no proprio aluno
     for (int i = 0; i < num_alunos; i++) {
-        if (alunos[i].avaliacoes) {
-            free(alunos[i].avaliacoes);
-            alunos[i].avaliacoes = NULL;
+        if (alunos[i].avaliacoes_extras) {
+            free(alunos[i].avaliacoes_extras);
+            alunos[i].avaliacoes_extras = NULL;
         }
     }
     
@@ -97,24 +118,59 @@ void liberar_memoria(Aluno *alunos, int num_alunos) {
     free(alunos);
 }
 
+// Retorna o array de avaliações do aluno, só para leitura
+// Até AVALIACOES_FIXAS elas ficam dentro do próprio Aluno; acima disso, todas vão para o heap
+const Avaliacao *avaliacoes_aluno(const Aluno *aluno) {
+    if (aluno->avaliacoes_extras) {
+        return aluno->avaliacoes_extras;
+    }
+    return aluno->avaliacoes_fixas;
+}
+
+// Mesmo array de avaliacoes_aluno, para quem altera as notas
+Avaliacao *avaliacoes_aluno_editaveis(Aluno *aluno) {
+    if (aluno->avaliacoes_extras) {
+        return aluno->avaliacoes_extras;
+    }
+    return aluno->avaliacoes_fixas;
+}
+
+// Nome do aluno (guardado na arena_nomes); o ponteiro vale até o próximo nome inserido
+const char *nome_aluno(const Aluno *aluno) {
+    return texto_arena(&arena_nomes, aluno->nome);
+}
+
 /* 
     ATENÇÃO: Essa função deve ser implementada
 */ 
 // Função para adicionar uma nova avaliação ao histórico de avaliações do aluno
 void adicionar_avaliacoes(Aluno *aluno, Avaliacao avaliacao) {
-    //realoca memoria para mais uma avaliacao
-    Avaliacao *temp = realocar_memoria_avaliacao(aluno->avaliacoes, aluno->num_avaliacoes + 1);
+    //caso comum: ainda cabe no espaco fixo do aluno, nenhuma alocacao e feita
+    if (!aluno->avaliacoes_extras && aluno->num_avaliacoes < AVALIACOES_FIXAS) {
+        aluno->avaliacoes_fixas[aluno->num_avaliacoes] = avaliacao;
+        aluno->num_avaliacoes++;
+        return;
+    }
+
+    //garante espaco no heap para mais uma avaliacao (a capacidade cresce dobrando)
+    int primeira_vez = (aluno->avaliacoes_extras == NULL);
+    Avaliacao *temp = VETOR_RESERVAR(aluno->avaliacoes_extras, aluno->capacidade_avaliacoes, aluno->num_avaliacoes + 1);
     
     //verifica se a realocacao foi feito com sucesso
     if (!temp) {
         perror("Erro ao alocar memória para avaliações");
         return;
     }
+
+    //na primeira vez, copia as avaliacoes fixas para o heap para manter o array contiguo
+    if (primeira_vez) {
+        memcpy(temp, aluno->avaliacoes_fixas, aluno->num_avaliacoes * sizeof(Avaliacao));
+    }
     
     //atualiza o ponteiro para o array de avaliacoes
-    aluno->avaliacoes = temp;
+    aluno->avaliacoes_extras = temp;
     //adiciona a nova avaliacao ao array
-    aluno->avaliacoes[aluno->num_avaliacoes] = avaliacao; 
+    aluno->avaliacoes_extras[aluno->num_avaliacoes] = avaliacao; 
     //incrementa o nmero de avaliacoes
     aluno->num_avaliacoes++;
 }
@@ -132,34 +188,42 @@ Aluno *carregar_alunos(const char *nome_arquivo, int *num_alunos) {
     }
 
     Aluno *alunos   = NULL;                 // Inicializa o ponteiro para alunos
-    char linha[256];                        // Buffer para ler cada linha do arquivo
-    fgets(linha, sizeof(linha), arquivo);   // Ler e descartar o cabeçalho
+    int capacidade  = 0;                    // Espaço alocado no array de alunos
+    char *linha = NULL;                     // Buffer para ler cada linha do arquivo (cresce se preciso)
+    int capacidade_linha = 0;
+    long tamanho_linha;
+    int numero_linha = 1;                   // Número da linha no arquivo (para as mensagens de erro)
+    ler_linha(arquivo, &linha, &capacidade_linha); // Ler e descartar o cabeçalho
 
-    while (fgets(linha, sizeof(linha), arquivo)) { // Lê cada linha do arquivo
+    while ((tamanho_linha = ler_linha(arquivo, &linha, &capacidade_linha)) >= 0) { // Lê cada linha do arquivo
         Aluno novo_aluno;       // Inicializa um novo aluno
         Avaliacao avaliacao1;   // Inicializa a avaliação 1
         Avaliacao avaliacao2;   // Inicializa a avaliação 2
+        numero_linha++;
         // Lê os dados do aluno da linha e armazena em novo_aluno
-        // O sscanf retorna o número de itens lidos com sucesso
-        float av1ap1, av1ap2, av1ap3, np1, av2ap1, av2ap2, av2ap3, np2;
-        if (sscanf(linha, "%d,%[^,],%f,%f,%f,%f,%f,%f,%f,%f", &novo_aluno.matricula, novo_aluno.nome, &avaliacao1.ap1,&avaliacao1.ap2, &avaliacao1.ap3, &avaliacao1.np, &avaliacao2.ap1, &avaliacao2.ap2,&avaliacao2.ap3, &avaliacao2.np) == 10) {
+        // Os campos são lidos pelo leitor de CSV (comum/csv.c) e o nome vai para a arena_nomes
+        LinhaCSV campos;
+        iniciar_linha_csv(&campos, linha, linha + tamanho_linha);
+        if (analisar_linha_aluno(&campos, &arena_nomes, &novo_aluno, &avaliacao1, &avaliacao2)) {
 
             /* 
                 ATENÇÃO: Essa função deve ser implementada
             */             
-            // Realoca memória para mais um aluno
-            alunos = realocar_memoria_aluno(alunos, (*num_alunos + 1));
+            // Garante espaço para mais um aluno (a capacidade cresce dobrando)
+            alunos = VETOR_RESERVAR(alunos, capacidade, (*num_alunos + 1));
 
             // Verifica se a realocação foi bem-sucedida
             if (!alunos) {
                 perror("Erro ao alocar memória para alunos");
+                free(linha);
                 fclose(arquivo);
                 return NULL;
             }
 
             // Adiciona o novo aluno ao array
-            novo_aluno.avaliacoes = NULL; // Inicializa o histórico de avaliações
+            novo_aluno.avaliacoes_extras = NULL; // Inicializa o histórico de avaliações
             novo_aluno.num_avaliacoes = 0; // Inicializa o número de avaliacoes
+            novo_aluno.capacidade_avaliacoes = 0;
 
             /* 
                 ATENÇÃO: Essa função deve ser implementada
@@ -178,16 +242,237 @@ Aluno *carregar_alunos(const char *nome_arquivo, int *num_alunos) {
             (*num_alunos)++; // Incrementa o número de alunos
 
         } else { // Se a leitura falhar, imprime uma mensagem de erro
-            fprintf(stderr, "Erro ao ler linha do arquivo de alunos: %s", linha);
+            reportar_erro_csv("alunos", numero_linha, &campos);
         }
     }
 
+    free(linha);
     fclose(arquivo);
+    // Devolve a capacidade que sobrou no fim do array
+    return VETOR_AJUSTAR(alunos, capacidade, *num_alunos);
+}
+
+// Lê os campos de uma linha do CSV de notas
+// Segue as mesmas regras do formato "%d,%[^,],%f,%f,%f,%f,%f,%f,%f,%f" do sscanf,
+// mas lê direto da memória, sem copiar a linha para um buffer
+// O nome é guardado inteiro em "arena" (sem limite de tamanho)
+// Retorna 1 se os 10 campos foram lidos e 0 caso contrário (o campo com erro fica em "linha")
+int analisar_linha_aluno(LinhaCSV *linha, ArenaTextos *arena, Aluno *aluno, Avaliacao *avaliacao1, Avaliacao *avaliacao2) {
+    const char *nome;
+    size_t tamanho_nome;
+    if (!csv_ler_int(linha, &aluno->matricula) || !csv_separador(linha)) {
+        return 0;
+    }
+    if (!csv_ler_campo(linha, &nome, &tamanho_nome)) {
+        return 0;
+    }
+    int coluna_nome = linha->coluna;
+    if (!csv_separador(linha)) {
+        return 0;
+    }
+
+    // Oito notas separadas por vírgula: AV1 (ap1, ap2, ap3, np) e AV2 (ap1, ap2, ap3, np)
+    float *notas[8] = {
+        &avaliacao1->ap1, &avaliacao1->ap2, &avaliacao1->ap3, &avaliacao1->np,
+        &avaliacao2->ap1, &avaliacao2->ap2, &avaliacao2->ap3, &avaliacao2->np
+    };
+    for (int i = 0; i < 8; i++) {
+        if (!csv_ler_float(linha, notas[i])) {
+            return 0;
+        }
+        if (i < 7 && !csv_separador(linha)) {
+            return 0;
+        }
+    }
+
+    // O nome só vai para a arena depois que a linha inteira foi aceita
+    if (!arena_adicionar(arena, nome, tamanho_nome, &aluno->nome)) {
+        return csv_erro_campo(linha, coluna_nome, "sem memória");
+    }
+    return 1;
+}
+
+// Carrega os alunos do arquivo CSV usando mmap, sem copiar cada linha
+// Conta as linhas antes para alocar o array de alunos uma única vez
+// Produz o mesmo array que carregar_alunos, mas sem limite de tamanho de linha
+Aluno *carregar_alunos_mmap(const char *nome_arquivo, int *num_alunos) {
+    ArquivoMapeado arquivo;
+    if (!mapear_arquivo(nome_arquivo, &arquivo)) {
+        perror("Erro ao abrir arquivo de alunos");
+        return NULL;
+    }
+
+    *num_alunos = 0;
+    const char *p = arquivo.dados;
+    const char *fim_arquivo = arquivo.dados + arquivo.tamanho;
+
+    // Pula o cabeçalho
+    const char *fim_linha = csv_fim_linha(p, fim_arquivo);
+    p = fim_linha < fim_arquivo ? fim_linha + 1 : fim_arquivo;
+
+    // Conta as linhas restantes para alocar tudo de uma vez
+    size_t max_linhas = 0;
+    for (const char *q = p; q < fim_arquivo; ) {
+        const char *nl = csv_fim_linha(q, fim_arquivo);
+        max_linhas++;
+        q = nl < fim_arquivo ? nl + 1 : fim_arquivo;
+    }
+
+    if (max_linhas == 0) {
+        desmapear_arquivo(&arquivo);
+        return NULL;
+    }
+
+    Aluno *alunos = realocar_memoria_aluno(NULL, (int) max_linhas);
+    if (!alunos) {
+        perror("Erro ao alocar memória para alunos");
+        desmapear_arquivo(&arquivo);
+        return NULL;
+    }
+
+    int numero_linha = 2;   // O cabeçalho é a linha 1
+    while (p < fim_arquivo) {
+        fim_linha = csv_fim_linha(p, fim_arquivo);
+
+        Aluno novo_aluno;
+        Avaliacao avaliacao1;
+        Avaliacao avaliacao2;
+        LinhaCSV campos;
+        iniciar_linha_csv(&campos, p, fim_linha);
+        if (analisar_linha_aluno(&campos, &arena_nomes, &novo_aluno, &avaliacao1, &avaliacao2)) {
+            novo_aluno.avaliacoes_extras = NULL;
+            novo_aluno.num_avaliacoes = 0;
+            novo_aluno.capacidade_avaliacoes = 0;
+            adicionar_avaliacoes(&novo_aluno, avaliacao1);
+            adicionar_avaliacoes(&novo_aluno, avaliacao2);
+            calcular_notas(&novo_aluno);
+            alunos[*num_alunos] = novo_aluno;
+            (*num_alunos)++;
+        } else {
+            reportar_erro_csv("alunos", numero_linha, &campos);
+        }
+
+        numero_linha++;
+        p = fim_linha < fim_arquivo ? fim_linha + 1 : fim_arquivo;
+    }
+
+    desmapear_arquivo(&arquivo);
+
+    if (*num_alunos == 0) {
+        free(alunos);
+        return NULL;
+    }
+    return alunos;
+}
+
+// Analisa as linhas de um pedaço do arquivo de alunos (executada em uma thread)
+// Os alunos lidos vão para o array do próprio pedaço; nada é compartilhado entre threads
+static void analisar_pedaco_alunos(PedacoArquivo *pedaco) {
+    Aluno *alunos = NULL;
+    const char *p = pedaco->inicio;
+
+    while (p < pedaco->fim) {
+        const char *fim = csv_fim_linha(p, pedaco->fim);
+
+        Aluno novo_aluno;
+        Avaliacao avaliacao1;
+        Avaliacao avaliacao2;
+        LinhaCSV campos;
+        iniciar_linha_csv(&campos, p, fim);
+        if (analisar_linha_aluno(&campos, &pedaco->textos, &novo_aluno, &avaliacao1, &avaliacao2)) {
+            Aluno *temp = VETOR_RESERVAR(alunos, pedaco->capacidade_resultados, pedaco->num_resultados + 1);
+            if (!temp) {
+                registrar_erro_linha(pedaco, pedaco->num_linhas, p, fim, 0, "sem memória");
+            } else {
+                alunos = temp;
+                novo_aluno.avaliacoes_extras = NULL;
+                novo_aluno.num_avaliacoes = 0;
+                novo_aluno.capacidade_avaliacoes = 0;
+                adicionar_avaliacoes(&novo_aluno, avaliacao1);
+                adicionar_avaliacoes(&novo_aluno, avaliacao2);
+                calcular_notas(&novo_aluno);
+                alunos[pedaco->num_resultados++] = novo_aluno;
+            }
+        } else {
+            registrar_erro_linha(pedaco, pedaco->num_linhas, p, fim, campos.coluna_erro, campos.erro);
+        }
+
+        pedaco->num_linhas++;
+        p = fim < pedaco->fim ? fim + 1 : pedaco->fim;
+    }
+    pedaco->resultado = alunos;
+}
+
+// Carrega os alunos do arquivo CSV usando várias threads
+// O arquivo é dividido em pedaços nas quebras de linha, cada thread lê o seu pedaço
+// e os resultados são juntados na ordem original do arquivo
+// num_threads = 0 usa o número de processadores disponíveis
+// Os erros informam o número da linha no arquivo (o cabeçalho é a linha 1)
+Aluno *carregar_alunos_paralelo(const char *nome_arquivo, int *num_alunos, int num_threads) {
+    ArquivoMapeado arquivo;
+    if (!mapear_arquivo(nome_arquivo, &arquivo)) {
+        perror("Erro ao abrir arquivo de alunos");
+        return NULL;
+    }
+
+    *num_alunos = 0;
+    const char *fim_arquivo = arquivo.dados + arquivo.tamanho;
+
+    // Pula o cabeçalho
+    const char *p = memchr(arquivo.dados, '\n', arquivo.tamanho);
+    p = p ? p + 1 : fim_arquivo;
+
+    PedacoArquivo pedacos[MAX_THREADS];
+    int num_pedacos = dividir_em_pedacos(p, fim_arquivo, numero_threads(num_threads), pedacos);
+    processar_pedacos(pedacos, num_pedacos, analisar_pedaco_alunos);
+    reportar_erros_pedacos(pedacos, num_pedacos, 2, "alunos");
+
+    // Junta os arrays de cada pedaço na ordem do arquivo
+    int total = 0;
+    for (int i = 0; i < num_pedacos; i++) {
+        total += pedacos[i].num_resultados;
+    }
+
+    Aluno *alunos = NULL;
+    if (total > 0) {
+        alunos = realocar_memoria_aluno(NULL, total);
+        if (!alunos) {
+            perror("Erro ao alocar memória para alunos");
+        } else {
+            // Os nomes de cada pedaço passam para a arena global e as referências são corrigidas
+            for (int i = 0; i < num_pedacos; i++) {
+                Aluno *destino = alunos + *num_alunos;
+                memcpy(destino, pedacos[i].resultado, pedacos[i].num_resultados * sizeof(Aluno));
+                if (pedacos[i].num_resultados > 0 &&
+                    !arena_transferir(&arena_nomes, &pedacos[i].textos, &destino->nome,
+                                      (size_t) pedacos[i].num_resultados, sizeof(Aluno))) {
+                    perror("Erro ao alocar memória para os nomes");
+                    free(alunos);
+                    alunos = NULL;
+                    *num_alunos = 0;
+                    break;
+                }
+                *num_alunos += pedacos[i].num_resultados;
+            }
+        }
+    }
+
+    liberar_pedacos(pedacos, num_pedacos);
+    desmapear_arquivo(&arquivo);
     return alunos;
 }
 
 // Função para ordenar os alunos por nota final (NF)
+// Ordena pares chave/índice com radix sort (ranking.c) e move cada aluno uma única vez
+// Se faltar memória para o ranking, usa a ordenação por bolha no próprio array
 void ordenar_alunos(Aluno *alunos, int num_alunos) {
+    if (!ordenar_alunos_ranking(alunos, num_alunos, ORDEM_DECRESCENTE, DESEMPATE_NENHUM)) {
+        ordenar_alunos_bolha(alunos, num_alunos);
+    }
+}
+
+// Ordenação por bolha original (O(n²)), mantida como alternativa sem memória extra
+void ordenar_alunos_bolha(Aluno *alunos, int num_alunos) {
     for (int i = 0; i < num_alunos - 1; i++) {
         for (int j = 0; j < num_alunos - i - 1; j++) {
             if (alunos[j].nf < alunos[j + 1].nf) {
@@ -199,40 +484,25 @@ void ordenar_alunos(Aluno *alunos, int num_alunos) {
     }
 }
 
+// Lista os alunos no formato e com as cores definidos em formato_saida_padrao e modo_cor_padrao
+// A saída é montada em um buffer grande (renderizador.c) e escrita com poucas chamadas a write
 void listar_alunos(const Aluno *alunos, int num_alunos) {
     if (num_alunos == 0) {
         printf("Nenhum aluno cadastrado.\n");
         return;
     }
 
-    printf("\n");
-    printf("%-10s| %-30s | %-8s | %-8s | %-8s | %-8s | %-8s | %-8s | %-8s | %-8s | %-8s | %-10s\n",
-           " Matricula ", "Nome", "AV1:AP1", "AV1:AP2", "AV1:AP3", "NP1", "AV2:AP1", "AV2:AP2", "AV2:AP3", "NP2", "NF", "Status"); //correcao de nomes com caracteres especiais
-    printf("-----------|--------------------------------|----------|----------|----------|----------|----------|----------|----------|----------|----------|------------\n");
-
+    Renderizador r;
+    if (!iniciar_renderizador(&r, stdout, formato_saida_padrao, modo_cor_padrao)) {
+        perror("Erro ao alocar memória para a listagem");
+        return;
+    }
+    renderizar_cabecalho(&r);
     for (int i = 0; i < num_alunos; i++) {
-        if (alunos[i].status == 0) { // Reprovado
-            printf(RED_TEXT);
-        }
-        printf("%-10d | %-30s | %-8.2f | %-8.2f | %-8.2f | %-8.2f | %-8.2f | %-8.2f | %-8.2f | %-8.2f | %-8.2f | %-10s",
-                alunos[i].matricula,
-                alunos[i].nome,
-                alunos[i].avaliacoes[0].ap1,
-                alunos[i].avaliacoes[0].ap2,
-                alunos[i].avaliacoes[0].ap3,
-                alunos[i].avaliacoes[0].np,
-                alunos[i].avaliacoes[1].ap1,
-                alunos[i].avaliacoes[1].ap2,
-                alunos[i].avaliacoes[1].ap3,
-                alunos[i].avaliacoes[1].np,
-                alunos[i].nf,
-                alunos[i].status == 1 ? "Aprovado" : "Reprovado");
-        if (alunos[i].status == 0) {
-            printf(RESET_TEXT);
-        }
-        printf("\n");
+        renderizar_aluno(&r, &alunos[i]);
     }
-    printf("\n");
+    renderizar_rodape(&r);
+    finalizar_renderizador(&r);
 }
 
 //validção das notas
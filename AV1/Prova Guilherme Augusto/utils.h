@@ -5,11 +5,19 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "../comum/mapeamento.h"
+#include "../comum/binario.h"
+#include "../comum/vetor.h"
+#include "../comum/paralelo.h"
+#include "../comum/csv.h"
+#include "../comum/arena.h"
+#include "../comum/tempo.h"
+
 // Definição de cores ANSI (suportado em alguns terminais)
 #define RED_TEXT "\033[31m"
 #define RESET_TEXT "\033[0m"
 
-#define MAX_NOME 50
+#define AVALIACOES_FIXAS 2  // Avaliações guardadas dentro do próprio Aluno (AV1 e AV2)
 
 // Estruturas de dados
 // Estrutura para armazenar as notas de cada avaliação
@@ -22,9 +30,11 @@ typedef struct {
 
 typedef struct {
     int matricula;          // Matrícula do aluno
-    char nome[MAX_NOME];    // Nome do aluno
-    Avaliacao *avaliacoes;  // Ponteiro para o array de avaliações
+    RefTexto nome;          // Nome do aluno na arena_nomes (ver nome_aluno)
+    Avaliacao avaliacoes_fixas[AVALIACOES_FIXAS]; // Avaliações no próprio aluno (sem alocação)
+    Avaliacao *avaliacoes_extras; // Array no heap, usado só com mais de AVALIACOES_FIXAS avaliações
     int num_avaliacoes;     // Número de avaliações
+    int capacidade_avaliacoes; // Espaço alocado em avaliacoes_extras
     float nf;               // Nota final
     int status;             // 0: Reprovado, 1: Aprovado
 } Aluno;
@@ -32,12 +42,20 @@ typedef struct {
 
 // Protótipos das funções em utils.c
 Aluno *carregar_alunos(const char *nome_arquivo, int *num_alunos);
+Aluno *carregar_alunos_mmap(const char *nome_arquivo, int *num_alunos);
+Aluno *carregar_alunos_paralelo(const char *nome_arquivo, int *num_alunos, int num_threads);
+int analisar_linha_aluno(LinhaCSV *linha, ArenaTextos *arena, Aluno *aluno, Avaliacao *avaliacao1, Avaliacao *avaliacao2);
 Aluno *realocar_memoria_aluno(Aluno *alunos, int novo_tamanho);
 Avaliacao* realocar_memoria_avaliacao(Avaliacao *avaliacoes, int novo_tamanho);
 void adicionar_avaliacoes(Aluno *aluno, Avaliacao avaliacao);
+const Avaliacao *avaliacoes_aluno(const Aluno *aluno);
+Avaliacao *avaliacoes_aluno_editaveis(Aluno *aluno);
+const char *nome_aluno(const Aluno *aluno);
 void ordenar_alunos(Aluno *alunos, int num_alunos);
+void ordenar_alunos_bolha(Aluno *alunos, int num_alunos);
 void listar_alunos(const Aluno *alunos, int num_alunos);
 void liberar_memoria(Aluno *alunos, int num_alunos);
 void calcular_notas(Aluno *aluno);
+float ajustar_nota(float nota);
 
 #endif
@@ -0,0 +1,466 @@
+// benchmark.c
+// Mede o tempo de carregamento de clientes e empréstimos
+// Uso: ./benchmark [--json] [--threads N] [--dados DIR] <clientes.csv> <emprestimos.csv> [<clientes.csv> <emprestimos.csv> ...]
+// Com o crescimento geométrico dos arrays, o tempo por linha deve se manter
+// constante quando o tamanho dos arquivos aumenta (carregamento linear)
+// Com --json, cada etapa sai como um objeto JSON por linha, com pico de RSS e alocações
+// Com --dados DIR, também mede o diário de mutações e a recuperação, com os arquivos em DIR
+#include <time.h>
+#define MEDIR_ALOCACOES
+#include "../comum/medicao.c"
+#include "utils.c"
+
+// Compara dois arrays de empréstimos campo a campo (os bytes que sobram depois dos
+// bits de aprovação e estado não têm valor definido, então memcmp não serve)
+static int emprestimos_iguais(const Emprestimo *a, const Emprestimo *b, int n) {
+    for (int i = 0; i < n; i++) {
+        if (a[i].cliente_id != b[i].cliente_id || a[i].num_parcelas != b[i].num_parcelas ||
+            memcmp(&a[i].valor_emprestimo, &b[i].valor_emprestimo, sizeof(float)) != 0 ||
+            memcmp(&a[i].valor_parcela, &b[i].valor_parcela, sizeof(float)) != 0 ||
+            a[i].aprovacao != b[i].aprovacao || a[i].ativo != b[i].ativo) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Compara dois conjuntos de clientes, incluindo o histórico de empréstimos
+// (os registros do histórico são montados com os bits que sobram em 0, então memcmp serve)
+static int clientes_iguais(const Cliente *a, const Cliente *b, int n) {
+    for (int i = 0; i < n; i++) {
+        if (a[i].id != b[i].id || strcmp(nome_cliente(&a[i]), nome_cliente(&b[i])) != 0 ||
+            memcmp(&a[i].salario, &b[i].salario, sizeof(float)) != 0 ||
+            a[i].num_emprestimos != b[i].num_emprestimos ||
+            memcmp(&a[i].parcelas_comprometidas, &b[i].parcelas_comprometidas, sizeof(float)) != 0 ||
+            (a[i].num_emprestimos > 0 &&
+             memcmp(a[i].historico_emprestimos, b[i].historico_emprestimos, a[i].num_emprestimos * sizeof(RegistroHistorico)) != 0)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Soma os empréstimos guardados nos históricos dos clientes
+static int contar_emprestimos(const Cliente *clientes, int num_clientes) {
+    int total = 0;
+    for (int j = 0; j < num_clientes; j++) {
+        total += clientes[j].num_emprestimos;
+    }
+    return total;
+}
+
+// Mede carregar_clientes e carregar_emprestimos (e os paralelos, com --threads) em um par de arquivos
+// Cada etapa é escrita em uma linha JSON na saída padrão
+static void benchmark_json(const char *nome_clientes, const char *nome_emprestimos, int num_threads) {
+    Medicao medicao;
+    for (int paralelo = 0; paralelo <= (num_threads >= 0); paralelo++) {
+        int num_clientes = 0;
+        iniciar_medicao(&medicao, "emprestimos", nome_clientes,
+                        paralelo ? "carregar_clientes_paralelo" : "carregar_clientes");
+        Cliente *clientes = paralelo ? carregar_clientes_paralelo(nome_clientes, &num_clientes, num_threads)
+                                     : carregar_clientes(nome_clientes, &num_clientes);
+        terminar_medicao(&medicao, clientes ? num_clientes : 0);
+        imprimir_medicao_json(stdout, &medicao);
+        if (!clientes) {
+            return;
+        }
+
+        iniciar_medicao(&medicao, "emprestimos", nome_emprestimos,
+                        paralelo ? "carregar_emprestimos_paralelo" : "carregar_emprestimos");
+        Emprestimo *emprestimos = paralelo
+            ? carregar_emprestimos_paralelo(nome_emprestimos, clientes, num_clientes, num_threads)
+            : carregar_emprestimos(nome_emprestimos, clientes, num_clientes);
+        terminar_medicao(&medicao, contar_emprestimos(clientes, num_clientes));
+        imprimir_medicao_json(stdout, &medicao);
+
+        free(emprestimos);
+        liberar_memoria(clientes, num_clientes);
+        liberar_arena(&arena_nomes);
+    }
+
+    // Carga particionada: a etapa inteira e uma linha por partição (para ver o desequilíbrio)
+    if (num_threads >= 0) {
+        int num_clientes = 0;
+        EstatisticasParticoes estatisticas;
+        Cliente *clientes = carregar_clientes_paralelo(nome_clientes, &num_clientes, num_threads);
+        if (!clientes) {
+            return;
+        }
+        iniciar_medicao(&medicao, "emprestimos", nome_emprestimos, "carregar_emprestimos_particionado");
+        Emprestimo *emprestimos = carregar_emprestimos_particionado(nome_emprestimos, clientes, num_clientes, num_threads, &estatisticas);
+        terminar_medicao(&medicao, contar_emprestimos(clientes, num_clientes));
+        imprimir_medicao_json(stdout, &medicao);
+        for (int p = 0; p < estatisticas.num_particoes; p++) {
+            char etapa[32];
+            snprintf(etapa, sizeof(etapa), "particao_%d", p);
+            Medicao particao = medicao;
+            particao.etapa = etapa;
+            particao.linhas = estatisticas.emprestimos_particao[p];
+            particao.segundos = estatisticas.segundos_particao[p];
+            particao.alocacoes = particao.liberacoes = 0;
+            particao.bytes_alocados = 0;
+            imprimir_medicao_json(stdout, &particao);
+        }
+        free(emprestimos);
+        liberar_memoria(clientes, num_clientes);
+        liberar_arena(&arena_nomes);
+    }
+}
+
+// Mede cada fase de carregar_emprestimos_lote (a aprovação sozinha é o custo de reavaliar
+// um arquivo já lido) e confere o resultado com carregar_emprestimos
+static void benchmark_lote_json(const char *nome_clientes, const char *nome_emprestimos) {
+    Medicao medicao;
+    LoteEmprestimos lote;
+    int num_clientes = 0, num_clientes_ref = 0;
+    Cliente *referencia = carregar_clientes(nome_clientes, &num_clientes_ref);
+    Emprestimo *emprestimos_ref = referencia ? carregar_emprestimos(nome_emprestimos, referencia, num_clientes_ref) : NULL;
+    Cliente *clientes = carregar_clientes(nome_clientes, &num_clientes);
+    if (!referencia || !clientes) {
+        liberar_memoria(referencia, num_clientes_ref);
+        liberar_memoria(clientes, num_clientes);
+        return;
+    }
+
+    iniciar_medicao(&medicao, "emprestimos", nome_emprestimos, "lote_ler");
+    int ok = ler_lote_emprestimos(nome_emprestimos, clientes, num_clientes, &lote);
+    terminar_medicao(&medicao, ok ? lote.num_linhas : 0);
+    imprimir_medicao_json(stdout, &medicao);
+    if (ok) {
+        iniciar_medicao(&medicao, "emprestimos", nome_emprestimos, "lote_parcelas");
+        calcular_parcelas_lote(&lote);
+        terminar_medicao(&medicao, lote.num_linhas);
+        imprimir_medicao_json(stdout, &medicao);
+
+        iniciar_medicao(&medicao, "emprestimos", nome_emprestimos, "lote_agrupar");
+        ok = agrupar_lote_por_cliente(&lote);
+        terminar_medicao(&medicao, lote.num_linhas);
+        imprimir_medicao_json(stdout, &medicao);
+    }
+    if (ok) {
+        iniciar_medicao(&medicao, "emprestimos", nome_emprestimos, "lote_aprovar");
+        aprovar_lote(&lote, clientes);
+        terminar_medicao(&medicao, lote.num_linhas);
+        imprimir_medicao_json(stdout, &medicao);
+
+        iniciar_medicao(&medicao, "emprestimos", nome_emprestimos, "lote_historico");
+        Emprestimo *emprestimos = aplicar_lote(&lote, clientes);
+        terminar_medicao(&medicao, lote.num_linhas);
+        imprimir_medicao_json(stdout, &medicao);
+
+        if (!clientes_iguais(referencia, clientes, num_clientes) ||
+            !emprestimos_iguais(emprestimos, emprestimos_ref, lote.num_linhas)) {
+            fprintf(stderr, "Lote diferente de carregar_emprestimos em %s\n", nome_emprestimos);
+        }
+        free(emprestimos);
+    }
+
+    liberar_lote(&lote);
+    free(emprestimos_ref);
+    liberar_memoria(clientes, num_clientes);
+    liberar_memoria(referencia, num_clientes_ref);
+    liberar_arena(&arena_nomes);
+}
+
+// Compara os históricos com realloc e com o pool: carga e liberação de cada um
+static void benchmark_pool_json(const char *nome_clientes, const char *nome_emprestimos) {
+    Medicao medicao;
+    for (int pool = 0; pool <= 1; pool++) {
+        pool_historicos.ativo = pool;
+        int num_clientes = 0;
+        Cliente *clientes = carregar_clientes(nome_clientes, &num_clientes);
+        if (!clientes) {
+            break;
+        }
+        iniciar_medicao(&medicao, "emprestimos", nome_emprestimos,
+                        pool ? "carregar_emprestimos_pool" : "carregar_emprestimos_realloc");
+        Emprestimo *emprestimos = carregar_emprestimos(nome_emprestimos, clientes, num_clientes);
+        terminar_medicao(&medicao, contar_emprestimos(clientes, num_clientes));
+        imprimir_medicao_json(stdout, &medicao);
+        free(emprestimos);
+
+        iniciar_medicao(&medicao, "emprestimos", nome_emprestimos, pool ? "liberar_memoria_pool" : "liberar_memoria_realloc");
+        liberar_memoria(clientes, num_clientes);
+        terminar_medicao(&medicao, num_clientes);
+        imprimir_medicao_json(stdout, &medicao);
+        liberar_arena(&arena_nomes);
+    }
+    pool_historicos.ativo = 0;
+}
+
+// Escreve a etapa medida: em JSON ou em uma linha de texto com a taxa
+static void imprimir_etapa(const Medicao *medicao, int modo_json) {
+    if (modo_json) {
+        imprimir_medicao_json(stdout, medicao);
+    } else {
+        printf("%-26s | %-10ld | %-10.1f ms | %-12.0f por segundo\n", medicao->etapa, medicao->linhas,
+               medicao->segundos * 1e3, medicao->segundos > 0 ? medicao->linhas / medicao->segundos : 0.0);
+    }
+}
+
+// Faz "num_mutacoes" mutações como o menu faria (um cadastro a cada 100, o resto empréstimos),
+// cada uma gravada no diário antes de ser aplicada
+static Cliente *fazer_mutacoes(Cliente *clientes, int *num_clientes, int *capacidade_clientes, int num_mutacoes, int *proximo_id) {
+    for (int k = 0; k < num_mutacoes; k++) {
+        if (k % 100 == 99) {
+            char nome[32];
+            Cliente novo_cliente;
+            memset(&novo_cliente, 0, sizeof(Cliente));
+            novo_cliente.id = (*proximo_id)++;
+            novo_cliente.salario = 3000.0f;
+            int tamanho = snprintf(nome, sizeof(nome), "Cliente %d", novo_cliente.id);
+            Cliente *temp = reservar_cliente(clientes, *num_clientes, capacidade_clientes);
+            if (!temp) {
+                break;
+            }
+            clientes = temp;
+            if (!arena_adicionar(&arena_nomes, nome, (size_t) tamanho, &novo_cliente.nome) ||
+                !registrar_cliente(&diario_mutacoes, &novo_cliente)) {
+                break;
+            }
+            clientes = incluir_cliente(clientes, num_clientes, capacidade_clientes, novo_cliente);
+        } else {
+            Cliente *cliente = &clientes[(int) (((long long) k * 7919) % *num_clientes)];
+            Emprestimo novo_emprestimo;
+            novo_emprestimo.cliente_id = cliente->id;
+            novo_emprestimo.valor_emprestimo = 1000.0f + (float) (k % 5000);
+            novo_emprestimo.num_parcelas = 12 + k % 48;
+            novo_emprestimo.ativo = 1;
+            calcular_valor_parcela(&novo_emprestimo);
+            aprovar_reprovar_emprestimo(cliente, &novo_emprestimo);
+            if (!reservar_historico(&pool_historicos, cliente, cliente->num_emprestimos + 1) ||
+                !registrar_emprestimo(&diario_mutacoes, &novo_emprestimo)) {
+                break;
+            }
+            adicionar_emprestimo_historico(cliente, novo_emprestimo);
+        }
+        manter_diario(&diario_mutacoes, clientes, *num_clientes);
+    }
+    return clientes;
+}
+
+// Fecha o diário sem sincronizar nem gravar snapshot, como se o programa tivesse caído
+static void simular_queda(void) {
+    close(diario_mutacoes.fd);
+    free(diario_mutacoes.buffer);
+    diario_mutacoes.buffer = NULL;
+    diario_mutacoes.fd = -1;
+    diario_mutacoes.ativo = 0;
+}
+
+// Mede o diário de mutações em "diretorio": mutações por segundo com 1, 16 e 256 registros por
+// fsync, a gravação de um snapshot e a recuperação depois de uma queda (snapshot + diário),
+// conferindo que o estado recuperado é igual ao que estava em memória
+static void benchmark_diario(const char *nome_clientes, const char *nome_emprestimos, const char *diretorio, int modo_json) {
+    Medicao medicao;
+    int num_clientes = 0;
+    Cliente *clientes = carregar_clientes(nome_clientes, &num_clientes);
+    if (!clientes || num_clientes == 0) {
+        liberar_memoria(clientes, num_clientes);
+        return;
+    }
+    free(carregar_emprestimos(nome_emprestimos, clientes, num_clientes));
+    int capacidade_clientes = num_clientes;
+    int proximo_id = 1;
+    for (int i = 0; i < num_clientes; i++) {
+        if (clientes[i].id >= proximo_id) {
+            proximo_id = clientes[i].id + 1;
+        }
+    }
+
+    // Diretório vazio: o estado vem dos CSVs e o primeiro snapshot é gravado na recuperação
+    if (!abrir_diario(&diario_mutacoes, diretorio)) {
+        liberar_memoria(clientes, num_clientes);
+        return;
+    }
+    remove(diario_mutacoes.nome_snapshot);
+    remove(diario_mutacoes.nome_diario);
+    if (!recuperar_diario(&diario_mutacoes, &clientes, &num_clientes, &capacidade_clientes)) {
+        liberar_memoria(clientes, num_clientes);
+        return;
+    }
+    diario_mutacoes.snapshot_cada = 0;
+
+    iniciar_medicao(&medicao, "emprestimos", diretorio, "salvar_snapshot");
+    int ok = compactar_diario(&diario_mutacoes, clientes, num_clientes);
+    terminar_medicao(&medicao, num_clientes);
+    imprimir_etapa(&medicao, modo_json);
+
+    const int lotes[] = {1, 16, 256};
+    for (int l = 0; ok && l < 3; l++) {
+        char etapa[32];
+        snprintf(etapa, sizeof(etapa), "diario_fsync_%d", lotes[l]);
+        int num_mutacoes = lotes[l] * 1000 < 100000 ? lotes[l] * 1000 : 100000;
+        diario_mutacoes.registros_por_fsync = lotes[l];
+        uint64_t antes = diario_mutacoes.sequencia;
+        iniciar_medicao(&medicao, "emprestimos", diretorio, etapa);
+        clientes = fazer_mutacoes(clientes, &num_clientes, &capacidade_clientes, num_mutacoes, &proximo_id);
+        ok = sincronizar_diario(&diario_mutacoes);
+        terminar_medicao(&medicao, (long) (diario_mutacoes.sequencia - antes));
+        imprimir_etapa(&medicao, modo_json);
+    }
+
+    // Simula uma queda: o diário fica com todas as mutações depois do snapshot
+    simular_queda();
+    int num_recuperados = 0;
+    int capacidade_recuperados = 0;
+    Cliente *recuperados = NULL;
+    ok = ok && abrir_diario(&diario_mutacoes, diretorio);
+
+    iniciar_medicao(&medicao, "emprestimos", diretorio, "recuperar_snapshot");
+    ok = ok && carregar_snapshot_diario(&diario_mutacoes, &recuperados, &num_recuperados) && recuperados;
+    terminar_medicao(&medicao, num_recuperados);
+    imprimir_etapa(&medicao, modo_json);
+
+    iniciar_medicao(&medicao, "emprestimos", diretorio, "recuperar_diario");
+    capacidade_recuperados = num_recuperados;
+    ok = ok && recuperar_diario(&diario_mutacoes, &recuperados, &num_recuperados, &capacidade_recuperados);
+    terminar_medicao(&medicao, diario_mutacoes.reaplicados);
+    imprimir_etapa(&medicao, modo_json);
+
+    int iguais = ok && num_recuperados == num_clientes && clientes_iguais(clientes, recuperados, num_clientes);
+    if (!iguais) {
+        fprintf(stderr, "Estado recuperado de %s diferente do estado em memória\n", diretorio);
+    } else if (!modo_json) {
+        printf("Recuperação igual ao estado em memória: Sim\n");
+    }
+
+    // Fecha sem gravar outro snapshot e apaga os arquivos do benchmark
+    if (diario_mutacoes.ativo) {
+        simular_queda();
+    }
+    remove(diario_mutacoes.nome_snapshot);
+    remove(diario_mutacoes.nome_diario);
+    liberar_memoria(clientes, num_clientes);
+    liberar_memoria(recuperados, num_recuperados);
+    liberar_arena(&arena_nomes);
+}
+
+int main(int argc, char *argv[]) {
+    // --threads N também mede os carregadores paralelos com N threads (0 = automático)
+    const char *arquivos[64];
+    int num_arquivos = 0;
+    int num_threads = -1;
+    int modo_json = 0;
+    const char *dados = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--json") == 0) {
+            modo_json = 1;
+        } else if (strcmp(argv[i], "--dados") == 0 && i + 1 < argc) {
+            dados = argv[++i];
+        } else if (num_arquivos < 64) {
+            arquivos[num_arquivos++] = argv[i];
+        }
+    }
+    if (num_arquivos < 2 || num_arquivos % 2 != 0) {
+        fprintf(stderr, "Uso: %s [--json] [--threads N] [--dados DIR] <clientes.csv> <emprestimos.csv> [<clientes.csv> <emprestimos.csv> ...]\n", argv[0]);
+        return 1;
+    }
+
+    if (modo_json) {
+        for (int i = 0; i + 1 < num_arquivos; i += 2) {
+            benchmark_json(arquivos[i], arquivos[i + 1], num_threads);
+            benchmark_lote_json(arquivos[i], arquivos[i + 1]);
+            benchmark_pool_json(arquivos[i], arquivos[i + 1]);
+            if (dados) {
+                benchmark_diario(arquivos[i], arquivos[i + 1], dados, 1);
+            }
+        }
+        return 0;
+    }
+
+    printf("%-10s | %-12s | %-16s | %-10s | %-12s | %-16s | %-10s\n",
+           "Carregador", "Clientes", "Clientes/s", "ns/linha", "Emprestimos", "Emprestimos/s", "ns/linha");
+    for (int i = 0; i + 1 < num_arquivos; i += 2) {
+        int num_clientes = 0;
+
+        double t0 = tempo_atual();
+        Cliente *clientes = carregar_clientes(arquivos[i], &num_clientes);
+        double t1 = tempo_atual();
+        if (!clientes) {
+            return 1;
+        }
+        Emprestimo *emprestimos = carregar_emprestimos(arquivos[i + 1], clientes, num_clientes);
+        double t2 = tempo_atual();
+
+        int num_emprestimos = contar_emprestimos(clientes, num_clientes);
+
+        printf("%-10s | %-12d | %-16.0f | %-10.1f | %-12d | %-16.0f | %-10.1f\n", "sequencial",
+               num_clientes, num_clientes / (t1 - t0), (t1 - t0) * 1e9 / num_clientes,
+               num_emprestimos, num_emprestimos / (t2 - t1), num_emprestimos ? (t2 - t1) * 1e9 / num_emprestimos : 0.0);
+
+        // Lote: mesmos clientes, empréstimos aprovados em fases
+        int num_clientes_l = 0;
+        Cliente *clientes_l = carregar_clientes(arquivos[i], &num_clientes_l);
+        t1 = tempo_atual();
+        Emprestimo *emprestimos_l = clientes_l ? carregar_emprestimos_lote(arquivos[i + 1], clientes_l, num_clientes_l) : NULL;
+        t2 = tempo_atual();
+        int iguais_l = clientes_l && num_clientes == num_clientes_l && clientes_iguais(clientes, clientes_l, num_clientes) &&
+                       emprestimos_iguais(emprestimos, emprestimos_l, num_emprestimos);
+        printf("%-10s | %-12s | %-16s | %-10s | %-12d | %-16.0f | %-10.1f | Iguais: %s\n", "lote", "-", "-", "-",
+               num_emprestimos, num_emprestimos / (t2 - t1), num_emprestimos ? (t2 - t1) * 1e9 / num_emprestimos : 0.0,
+               iguais_l ? "Sim" : "Nao");
+        free(emprestimos_l);
+        liberar_memoria(clientes_l, num_clientes_l);
+
+        // Pool: mesma carga sequencial, históricos cortados das áreas do pool
+        imprimir_estatisticas_pool(stdout, &pool_historicos, clientes, num_clientes);
+        pool_historicos.ativo = 1;
+        clientes_l = carregar_clientes(arquivos[i], &num_clientes_l);
+        t1 = tempo_atual();
+        emprestimos_l = clientes_l ? carregar_emprestimos(arquivos[i + 1], clientes_l, num_clientes_l) : NULL;
+        t2 = tempo_atual();
+        iguais_l = clientes_l && num_clientes == num_clientes_l && clientes_iguais(clientes, clientes_l, num_clientes);
+        printf("%-10s | %-12s | %-16s | %-10s | %-12d | %-16.0f | %-10.1f | Iguais: %s\n", "pool", "-", "-", "-",
+               num_emprestimos, num_emprestimos / (t2 - t1), num_emprestimos ? (t2 - t1) * 1e9 / num_emprestimos : 0.0,
+               iguais_l ? "Sim" : "Nao");
+        imprimir_estatisticas_pool(stdout, &pool_historicos, clientes_l, num_clientes_l);
+        free(emprestimos_l);
+        liberar_memoria(clientes_l, num_clientes_l);
+        pool_historicos.ativo = 0;
+
+        if (num_threads >= 0) {
+            int num_clientes_p = 0;
+            t0 = tempo_atual();
+            Cliente *clientes_p = carregar_clientes_paralelo(arquivos[i], &num_clientes_p, num_threads);
+            t1 = tempo_atual();
+            Emprestimo *emprestimos_p = carregar_emprestimos_paralelo(arquivos[i + 1], clientes_p, num_clientes_p, num_threads);
+            t2 = tempo_atual();
+
+            int iguais = num_clientes == num_clientes_p && clientes_iguais(clientes, clientes_p, num_clientes);
+            printf("%-10s | %-12d | %-16.0f | %-10.1f | %-12d | %-16.0f | %-10.1f | Iguais: %s\n", "paralelo",
+                   num_clientes_p, num_clientes_p / (t1 - t0), (t1 - t0) * 1e9 / num_clientes_p,
+                   num_emprestimos, num_emprestimos / (t2 - t1), num_emprestimos ? (t2 - t1) * 1e9 / num_emprestimos : 0.0,
+                   iguais ? "Sim" : "Nao");
+
+            free(emprestimos_p);
+            liberar_memoria(clientes_p, num_clientes_p);
+
+            // Particionado: aprovação dividida entre as threads pelo id do cliente
+            EstatisticasParticoes estatisticas;
+            clientes_p = carregar_clientes_paralelo(arquivos[i], &num_clientes_p, num_threads);
+            t1 = tempo_atual();
+            emprestimos_p = carregar_emprestimos_particionado(arquivos[i + 1], clientes_p, num_clientes_p, num_threads, &estatisticas);
+            t2 = tempo_atual();
+            iguais = num_clientes == num_clientes_p && clientes_iguais(clientes, clientes_p, num_clientes) &&
+                     emprestimos_iguais(emprestimos, emprestimos_p, num_emprestimos);
+            printf("%-10s | %-12s | %-16s | %-10s | %-12d | %-16.0f | %-10.1f | Iguais: %s\n", "particoes", "-", "-", "-",
+                   num_emprestimos, num_emprestimos / (t2 - t1), num_emprestimos ? (t2 - t1) * 1e9 / num_emprestimos : 0.0,
+                   iguais ? "Sim" : "Nao");
+            imprimir_estatisticas_particoes(stdout, &estatisticas);
+
+            free(emprestimos_p);
+            liberar_memoria(clientes_p, num_clientes_p);
+        }
+
+        free(emprestimos);
+        liberar_memoria(clientes, num_clientes);
+        liberar_arena(&arena_nomes);
+        if (dados) {
+            benchmark_diario(arquivos[i], arquivos[i + 1], dados, 0);
+        }
+    }
+    return 0;
+}
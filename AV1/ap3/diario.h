@@ -0,0 +1,126 @@
+#ifndef DIARIO_H
+#define DIARIO_H
+
+#include <stdint.h>
+#include "utils.h"
+#include "snapshot.h"
+
+// Diário de mutações (write-ahead log) e snapshots dos dados em um diretório (--dados)
+// Cada cadastro de cliente, empréstimo solicitado e desativação de empréstimo é gravado no
+// fim do diário antes de mudar os arrays em memória; na abertura, o estado é o último snapshot mais as
+// mutações do diário com sequência maior que a dele
+//
+// Arquivos no diretório:
+//   snapshot.bin   estado completo (snapshot.h), trocado atomicamente (rename)
+//   diario.log     CabecalhoDiario seguido dos registros, só acrescentados no fim
+//
+// Registro: CabecalhoRegistro (24 bytes) + dados completados com zeros até múltiplo de 8
+// O checksum cobre o cabeçalho (com o campo checksum em 0) e os dados; a leitura para no
+// primeiro registro incompleto ou com checksum errado (fim de uma gravação interrompida),
+// e o que vem depois é descartado
+//
+// Group commit: os registros ficam em um buffer e são gravados com um único fsync quando
+// chegam a "registros_por_fsync" ou quando o mais antigo espera mais que "espera_maxima"
+// (verificado a cada mutação); o menu também grava os pendentes antes de esperar a próxima opção
+// Com registros_por_fsync = 1 (padrão) cada mutação está no disco antes de ser confirmada;
+// com N > 1, uma queda pode perder até N - 1 mutações já confirmadas
+//
+// A cada "snapshot_cada" mutações (e ao sair) um snapshot novo é gravado e o diário volta
+// a ter só o cabeçalho; se o programa cair entre as duas coisas, os registros já incluídos
+// no snapshot são reconhecidos pela sequência e ignorados
+
+#define DIARIO_MAGICA "AP3DIARI"
+#define DIARIO_VERSAO 1
+#define DIARIO_ARQUIVO "diario.log"
+#define DIARIO_SNAPSHOT "snapshot.bin"
+#define DIARIO_ESPERA_MAXIMA 0.010          // Segundos que um registro pode esperar pelo fsync
+#define DIARIO_SNAPSHOT_CADA 100000         // Mutações entre snapshots (padrão)
+
+// Tipos de registro
+#define DIARIO_CLIENTE 1
+#define DIARIO_EMPRESTIMO 2
+#define DIARIO_ESTADO 3
+
+typedef struct {
+    char magica[8];             // DIARIO_MAGICA
+    uint32_t versao;            // DIARIO_VERSAO
+    uint32_t ordem_bytes;       // SNAPSHOT_ORDEM_BYTES
+} CabecalhoDiario;
+
+typedef struct {
+    uint32_t tamanho;           // Bytes dos dados depois do cabeçalho (múltiplo de 8)
+    uint32_t tipo;              // DIARIO_CLIENTE ou DIARIO_EMPRESTIMO
+    uint64_t sequencia;         // Número da mutação: cresce de 1 em 1 e continua depois de cada snapshot
+    uint64_t checksum;
+} CabecalhoRegistro;
+
+// Dados de DIARIO_CLIENTE (seguidos do nome, sem '\0')
+typedef struct {
+    int32_t id;
+    float salario;
+    uint32_t tamanho_nome;
+    uint32_t reservado;
+} RegistroCliente;
+
+// Dados de DIARIO_EMPRESTIMO (o empréstimo já com parcela e aprovação)
+typedef struct {
+    int32_t cliente_id;
+    float valor_emprestimo;
+    int32_t num_parcelas;
+    float valor_parcela;
+    uint32_t estado;            // Bit 0: aprovado, bit 1: ativo
+    uint32_t reservado;
+} RegistroEmprestimo;
+
+// Dados de DIARIO_ESTADO (novo estado de um empréstimo já no histórico)
+typedef struct {
+    int32_t cliente_id;
+    int32_t posicao;            // Posição no histórico do cliente (a partir de 0)
+    uint32_t estado;            // Bit 0: aprovado, bit 1: ativo
+    uint32_t reservado;
+} RegistroEstado;
+
+typedef struct {
+    int ativo;                  // 1: mutações gravadas no diário (--dados)
+    int fd;                     // Diário aberto para acrescentar (-1 antes da recuperação)
+    char nome_diario[FILENAME_MAX];
+    char nome_snapshot[FILENAME_MAX];
+    char diretorio[FILENAME_MAX];
+    char *buffer;               // Registros ainda não gravados
+    int usado;
+    int capacidade;
+    int pendentes;              // Registros no buffer
+    double inicio_pendentes;    // Quando o registro mais antigo do buffer foi criado
+    uint64_t tamanho_arquivo;   // Bytes válidos no diário (para desfazer uma gravação que falhou)
+    uint64_t sequencia;         // Última mutação registrada
+    uint64_t sequencia_snapshot;// Última mutação incluída no snapshot
+    int tem_snapshot;           // 1 se o estado da abertura veio de um snapshot (0: dos CSVs)
+    int registros_por_fsync;    // Group commit (1 = fsync a cada mutação)
+    double espera_maxima;
+    long snapshot_cada;         // Mutações entre snapshots (0 = só ao sair)
+    // Estatísticas
+    long registros;             // Mutações registradas nesta execução
+    long fsyncs;
+    long snapshots;
+    long reaplicados;           // Mutações do diário reaplicadas na recuperação
+    double segundos_snapshot;   // Carga do snapshot na abertura
+    double segundos_recuperacao;// Leitura e reaplicação do diário na abertura
+} DiarioMutacoes;
+
+// Diário do programa (ativo com --dados)
+extern DiarioMutacoes diario_mutacoes;
+
+// Protótipos das funções em diario.c
+int abrir_diario(DiarioMutacoes *diario, const char *diretorio);
+int carregar_snapshot_diario(DiarioMutacoes *diario, Cliente **clientes, int *num_clientes);
+int recuperar_diario(DiarioMutacoes *diario, Cliente **clientes, int *num_clientes, int *capacidade_clientes);
+int registrar_cliente(DiarioMutacoes *diario, const Cliente *cliente);
+int registrar_emprestimo(DiarioMutacoes *diario, const Emprestimo *emprestimo);
+int registrar_estado_emprestimo(DiarioMutacoes *diario, int cliente_id, int posicao, int aprovacao, int ativo);
+int sincronizar_diario(DiarioMutacoes *diario);
+int compactar_diario(DiarioMutacoes *diario, const Cliente *clientes, int num_clientes);
+void manter_diario(DiarioMutacoes *diario, const Cliente *clientes, int num_clientes);
+void fechar_diario(DiarioMutacoes *diario, const Cliente *clientes, int num_clientes);
+void imprimir_estatisticas_diario(FILE *saida, const DiarioMutacoes *diario);
+
+#endif
@@ -0,0 +1,214 @@
+#include "historicos.h"
+
+PoolHistoricos pool_historicos;
+
+// Os dados de cada área começam depois do cabeçalho, alinhados em 16 bytes
+#define POOL_CABECALHO ((sizeof(AreaPool) + 15) & ~(size_t) 15)
+
+// Classe do menor bloco com pelo menos "necessario" empréstimos (-1 se passar da maior classe)
+static int classe_pool(long long necessario) {
+    int k = 0;
+    while ((8LL << k) < necessario) {
+        k++;
+        if (k >= POOL_CLASSES) {
+            return -1;
+        }
+    }
+    return k;
+}
+
+static size_t bytes_classe(int k) {
+    return ((size_t) 8 << k) * sizeof(RegistroHistorico);
+}
+
+// Coloca o bloco da classe k na lista de livres
+static void empilhar_livre(PoolHistoricos *pool, void *bloco, int k) {
+    *(void**) bloco = pool->livres[k];
+    pool->livres[k] = bloco;
+    pool->bytes_livres += bytes_classe(k);
+}
+
+// Retira um bloco da classe k das listas de livres; sem bloco da classe k, um livre
+// maior é dividido ao meio até chegar na classe k (as metades que sobram ficam livres)
+static void *retirar_livre(PoolHistoricos *pool, int k) {
+    int j = k;
+    while (j < POOL_CLASSES && !pool->livres[j]) {
+        j++;
+    }
+    if (j == POOL_CLASSES) {
+        return NULL;
+    }
+    char *bloco = (char*) pool->livres[j];
+    pool->livres[j] = *(void**) bloco;
+    pool->bytes_livres -= bytes_classe(j);
+    while (j > k) {
+        j--;
+        empilhar_livre(pool, bloco + bytes_classe(j), j);
+    }
+    return bloco;
+}
+
+// Entrega um bloco da classe k: das listas de livres ou cortado da área atual
+// Quando a área atual não tem espaço, o que sobrou nela vira blocos livres e uma nova
+// área é pedida ao sistema
+static void *cortar_bloco(PoolHistoricos *pool, int k) {
+    size_t tamanho = bytes_classe(k);
+    void *livre = retirar_livre(pool, k);
+    if (livre) {
+        pool->blocos_entregues++;
+        pool->blocos_reaproveitados++;
+        return livre;
+    }
+
+    AreaPool *area = pool->areas;
+    if (!area || area->tamanho - area->usado < tamanho) {
+        // Fim da área atual em blocos livres, dos maiores para os menores
+        for (int j = k - 1; area && j >= 0; j--) {
+            while (area->tamanho - area->usado >= bytes_classe(j)) {
+                empilhar_livre(pool, (char*) area + POOL_CABECALHO + area->usado, j);
+                area->usado += bytes_classe(j);
+                pool->bytes_cortados += bytes_classe(j);
+            }
+        }
+        size_t tamanho_area = tamanho > POOL_TAMANHO_AREA ? tamanho : POOL_TAMANHO_AREA;
+        area = (AreaPool*) malloc(POOL_CABECALHO + tamanho_area);
+        if (!area) {
+            return NULL;
+        }
+        area->proxima = pool->areas;
+        area->tamanho = tamanho_area;
+        area->usado = 0;
+        pool->areas = area;
+        pool->num_areas++;
+        pool->bytes_reservados += tamanho_area;
+    }
+    void *bloco = (char*) area + POOL_CABECALHO + area->usado;
+    area->usado += tamanho;
+    pool->bytes_cortados += tamanho;
+    pool->blocos_entregues++;
+    return bloco;
+}
+
+// Coloca o bloco (de "capacidade" empréstimos) na lista de livres da sua classe
+static void devolver_bloco(PoolHistoricos *pool, void *bloco, int capacidade) {
+    int k = classe_pool(capacidade);
+    if (k >= 0) {
+        empilhar_livre(pool, bloco, k);
+    }
+}
+
+// Garante espaço para "necessario" empréstimos no histórico do cliente, como VETOR_RESERVAR
+// (a capacidade dobra a partir de 8). Retorna o histórico (já guardado no cliente) ou NULL
+// em caso de falha, com o histórico antigo ainda válido
+RegistroHistorico *reservar_historico(PoolHistoricos *pool, Cliente *cliente, int necessario) {
+    if (!pool->ativo) {
+        RegistroHistorico *temp = VETOR_RESERVAR(cliente->historico_emprestimos, cliente->capacidade_emprestimos, necessario);
+        if (temp) {
+            cliente->historico_emprestimos = temp;
+        }
+        return temp;
+    }
+    if (cliente->historico_emprestimos && necessario <= cliente->capacidade_emprestimos) {
+        return cliente->historico_emprestimos;
+    }
+
+    int k = classe_pool(necessario);
+    RegistroHistorico *novo = k >= 0 ? (RegistroHistorico*) cortar_bloco(pool, k) : NULL;
+    if (!novo) {
+        return NULL;
+    }
+    if (cliente->historico_emprestimos) {
+        memcpy(novo, cliente->historico_emprestimos, (size_t) cliente->num_emprestimos * sizeof(RegistroHistorico));
+        devolver_bloco(pool, cliente->historico_emprestimos, cliente->capacidade_emprestimos);
+    }
+    cliente->historico_emprestimos = novo;
+    cliente->capacidade_emprestimos = 8 << k;
+    return novo;
+}
+
+// Libera o histórico de um cliente (com o pool, o bloco volta para a lista de livres)
+void liberar_historico(PoolHistoricos *pool, Cliente *cliente) {
+    if (!pool->ativo) {
+        free(cliente->historico_emprestimos);
+    } else if (cliente->historico_emprestimos) {
+        devolver_bloco(pool, cliente->historico_emprestimos, cliente->capacidade_emprestimos);
+    }
+    cliente->historico_emprestimos = NULL;
+    cliente->num_emprestimos = 0;
+    cliente->capacidade_emprestimos = 0;
+}
+
+// Passa as áreas e os blocos livres de "origem" para "destino" (origem fica vazio)
+// A área atual de "destino" continua sendo a primeira, para os próximos cortes
+void juntar_pool_historicos(PoolHistoricos *destino, PoolHistoricos *origem) {
+    if (origem->areas) {
+        AreaPool **fim = destino->areas ? &destino->areas->proxima : &destino->areas;
+        AreaPool *ultima = origem->areas;
+        while (ultima->proxima) {
+            ultima = ultima->proxima;
+        }
+        ultima->proxima = *fim;
+        *fim = origem->areas;
+    }
+    for (int k = 0; k < POOL_CLASSES; k++) {
+        if (origem->livres[k]) {
+            void *ultimo = origem->livres[k];
+            while (*(void**) ultimo) {
+                ultimo = *(void**) ultimo;
+            }
+            *(void**) ultimo = destino->livres[k];
+            destino->livres[k] = origem->livres[k];
+        }
+    }
+    destino->num_areas += origem->num_areas;
+    destino->bytes_reservados += origem->bytes_reservados;
+    destino->bytes_cortados += origem->bytes_cortados;
+    destino->bytes_livres += origem->bytes_livres;
+    destino->blocos_entregues += origem->blocos_entregues;
+    destino->blocos_reaproveitados += origem->blocos_reaproveitados;
+
+    int ativo = origem->ativo;
+    memset(origem, 0, sizeof(PoolHistoricos));
+    origem->ativo = ativo;
+}
+
+// Libera todos os históricos do pool de uma vez (só as áreas são devolvidas ao sistema)
+// Os clientes que apontavam para o pool ficam com ponteiros inválidos
+void liberar_pool_historicos(PoolHistoricos *pool) {
+    AreaPool *area = pool->areas;
+    while (area) {
+        AreaPool *proxima = area->proxima;
+        free(area);
+        area = proxima;
+    }
+    int ativo = pool->ativo;
+    memset(pool, 0, sizeof(PoolHistoricos));
+    pool->ativo = ativo;
+}
+
+// Imprime o uso de memória dos históricos: com o pool, as áreas, os blocos e a folga;
+// sem ele, a capacidade alocada com realloc e a folga no fim de cada array
+void imprimir_estatisticas_pool(FILE *saida, const PoolHistoricos *pool, const Cliente *clientes, int num_clientes) {
+    const double mib = 1024.0 * 1024.0;
+    size_t capacidade = 0, usado = 0, num_emprestimos = 0;
+    for (int i = 0; i < num_clientes; i++) {
+        capacidade += (size_t) clientes[i].capacidade_emprestimos * sizeof(RegistroHistorico);
+        usado += (size_t) clientes[i].num_emprestimos * sizeof(RegistroHistorico);
+        num_emprestimos += clientes[i].num_emprestimos;
+    }
+    if (!pool->ativo) {
+        fprintf(saida, "Históricos com realloc: %.1f MiB alocados, %.1f MiB de empréstimos, folga %.1f MiB "
+                       "(%.1f bytes por empréstimo, registro de %zu bytes)\n",
+                capacidade / mib, usado / mib, (capacidade - usado) / mib,
+                num_emprestimos ? (double) capacidade / num_emprestimos : 0.0, sizeof(RegistroHistorico));
+        return;
+    }
+    fprintf(saida, "Pool de históricos: %d áreas, %.1f MiB reservados, %ld blocos entregues (%ld reaproveitados), "
+                   "%.1f bytes por empréstimo\n",
+            pool->num_areas, pool->bytes_reservados / mib, pool->blocos_entregues, pool->blocos_reaproveitados,
+            num_emprestimos ? (double) pool->bytes_reservados / num_emprestimos : 0.0);
+    fprintf(saida, "  Em uso %.1f MiB (empréstimos %.1f MiB, folga nos blocos %.1f MiB), livres %.1f MiB, "
+                   "fim das áreas sem uso %.1f MiB\n",
+            capacidade / mib, usado / mib, (capacidade - usado) / mib, pool->bytes_livres / mib,
+            (pool->bytes_reservados - pool->bytes_cortados) / mib);
+}
@@ -0,0 +1,50 @@
+#ifndef HISTORICOS_H
+#define HISTORICOS_H
+
+#include "utils.h"
+
+// Pool de memória para os históricos de empréstimos dos clientes
+// Sem o pool (padrão), cada histórico é um array próprio que cresce com realloc dobrando
+// e liberar_memoria faz um free por cliente. Com o pool ativo (--pool), os históricos
+// continuam contíguos e com as mesmas capacidades (8, 16, 32, ... empréstimos), mas os
+// blocos são cortados de áreas grandes da arena (bump allocation):
+//  - um histórico que cresce vai para um bloco da classe seguinte e o antigo fica em uma
+//    lista de livres da sua classe, para ser reaproveitado por outro cliente
+//  - todos os históricos são liberados de uma vez, devolvendo só as áreas da arena
+// O pool não é thread-safe: cada thread que cria históricos usa o seu e depois eles são
+// juntados (ver carregar_emprestimos_particionado)
+
+#define POOL_CLASSES 28                 // Classe k: blocos de 8 << k empréstimos
+#define POOL_TAMANHO_AREA (1 << 20)     // Tamanho mínimo de cada área pedida ao sistema (1 MiB)
+
+// Área grande pedida ao sistema, de onde os blocos são cortados
+typedef struct AreaPool {
+    struct AreaPool *proxima;
+    size_t tamanho;                     // Bytes de dados da área
+    size_t usado;                       // Bytes já cortados
+} AreaPool;
+
+typedef struct {
+    int ativo;                          // 1: históricos no pool, 0: realloc/free (padrão)
+    AreaPool *areas;                    // Área atual primeiro
+    void *livres[POOL_CLASSES];         // Listas de blocos livres de cada classe
+    // Estatísticas
+    int num_areas;
+    size_t bytes_reservados;            // Bytes pedidos ao sistema (áreas)
+    size_t bytes_cortados;              // Bytes entregues como blocos (novos)
+    size_t bytes_livres;                // Bytes nas listas de livres
+    long blocos_entregues;              // Blocos entregues (novos e reaproveitados)
+    long blocos_reaproveitados;         // Blocos entregues a partir das listas de livres
+} PoolHistoricos;
+
+// Pool dos históricos do programa
+extern PoolHistoricos pool_historicos;
+
+// Protótipos das funções em historicos.c
+RegistroHistorico *reservar_historico(PoolHistoricos *pool, Cliente *cliente, int necessario);
+void liberar_historico(PoolHistoricos *pool, Cliente *cliente);
+void juntar_pool_historicos(PoolHistoricos *destino, PoolHistoricos *origem);
+void liberar_pool_historicos(PoolHistoricos *pool);
+void imprimir_estatisticas_pool(FILE *saida, const PoolHistoricos *pool, const Cliente *clientes, int num_clientes);
+
+#endif
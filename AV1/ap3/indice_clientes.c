@@ -0,0 +1,206 @@
+#include "indice_clientes.h"
+
+IndiceClientes indice_clientes;
+
+#define INDICE_FOLGA_DENSO 16   // Ids a mais aceitos na tabela direta além de 2x o número de clientes
+
+// Espalha os bits do id (ids costumam ser sequenciais)
+static unsigned int hash_id_cliente(int id) {
+    unsigned int h = (unsigned int) id * 2654435769u;
+    return h ^ (h >> 16);
+}
+
+// A faixa de ids [minimo, maximo] cabe na tabela direta para "num_itens" clientes?
+static int faixa_densa(long long minimo, long long maximo, int num_itens) {
+    return maximo - minimo + 1 <= 2LL * num_itens + INDICE_FOLGA_DENSO;
+}
+
+static void zerar_indice(IndiceClientes *indice) {
+    memset(indice, 0, sizeof(IndiceClientes));
+}
+
+// Procura o id no hash; retorna a posição da entrada com o id ou da primeira vazia
+static unsigned int procurar_id(const EntradaIndiceCliente *entradas, int capacidade, int id) {
+    unsigned int mascara = (unsigned int) capacidade - 1;
+    unsigned int i = hash_id_cliente(id) & mascara;
+    while (entradas[i].posicao != INDICE_CLIENTE_VAZIO && entradas[i].id != id) {
+        i = (i + 1) & mascara;
+    }
+    return i;
+}
+
+// Aloca um hash vazio com espaço para "num_itens" ids sem crescer
+static EntradaIndiceCliente *alocar_hash(int num_itens, int *capacidade) {
+    int c = 16;
+    while (c < 2 * num_itens + 2) {
+        c *= 2;
+    }
+    EntradaIndiceCliente *entradas = (EntradaIndiceCliente*) malloc((size_t) c * sizeof(EntradaIndiceCliente));
+    if (!entradas) {
+        return NULL;
+    }
+    for (int i = 0; i < c; i++) {
+        entradas[i].id = 0;
+        entradas[i].posicao = INDICE_CLIENTE_VAZIO;
+    }
+    *capacidade = c;
+    return entradas;
+}
+
+// Passa o índice para o formato hash com espaço para "num_itens" ids
+// (usado quando um id novo sai da faixa da tabela direta, ou para crescer o hash)
+static int reconstruir_hash(IndiceClientes *indice, int num_itens) {
+    int capacidade;
+    EntradaIndiceCliente *entradas = alocar_hash(num_itens, &capacidade);
+    if (!entradas) {
+        return 0;
+    }
+    if (indice->denso) {
+        for (int i = 0; i < indice->capacidade; i++) {
+            if (indice->posicoes[i] != INDICE_CLIENTE_VAZIO) {
+                int id = indice->id_minimo + i;
+                unsigned int j = procurar_id(entradas, capacidade, id);
+                entradas[j].id = id;
+                entradas[j].posicao = indice->posicoes[i];
+            }
+        }
+        free(indice->posicoes);
+        indice->posicoes = NULL;
+    } else {
+        for (int i = 0; i < indice->capacidade; i++) {
+            if (indice->entradas[i].posicao != INDICE_CLIENTE_VAZIO) {
+                unsigned int j = procurar_id(entradas, capacidade, indice->entradas[i].id);
+                entradas[j] = indice->entradas[i];
+            }
+        }
+        free(indice->entradas);
+    }
+    indice->entradas = entradas;
+    indice->capacidade = capacidade;
+    indice->denso = 0;
+    return 1;
+}
+
+// Associa o id à posição no array de clientes
+// Retorna 1 se inseriu, 0 se o id já existe (vale a primeira posição) e -1 se faltar memória
+int indice_clientes_inserir(IndiceClientes *indice, int id, int posicao) {
+    if (indice->denso) {
+        long long deslocamento = (long long) id - indice->id_minimo;
+        if (deslocamento >= 0 && deslocamento < indice->capacidade) {
+            if (indice->posicoes[deslocamento] != INDICE_CLIENTE_VAZIO) {
+                return 0;
+            }
+            indice->posicoes[deslocamento] = posicao;
+        } else if (deslocamento >= 0 && faixa_densa(indice->id_minimo, id, indice->num_itens + 1)) {
+            // Id logo depois da faixa (ex.: cliente novo com o maior id + 1): a tabela cresce dobrando
+            long long nova = 2LL * indice->capacidade;
+            if (nova < deslocamento + 1) {
+                nova = deslocamento + 1;
+            }
+            if (nova > INT32_MAX / 2) {
+                nova = deslocamento + 1;
+            }
+            int *posicoes = (int*) realloc(indice->posicoes, (size_t) nova * sizeof(int));
+            if (!posicoes) {
+                return -1;
+            }
+            for (long long i = indice->capacidade; i < nova; i++) {
+                posicoes[i] = INDICE_CLIENTE_VAZIO;
+            }
+            posicoes[deslocamento] = posicao;
+            indice->posicoes = posicoes;
+            indice->capacidade = (int) nova;
+        } else {
+            // Fora da faixa: a tabela direta ficaria esparsa demais
+            if (!reconstruir_hash(indice, indice->num_itens + 1)) {
+                return -1;
+            }
+            return indice_clientes_inserir(indice, id, posicao);
+        }
+    } else {
+        if (2 * (indice->num_itens + 1) > indice->capacidade && !reconstruir_hash(indice, 2 * (indice->num_itens + 1))) {
+            return -1;
+        }
+        unsigned int i = procurar_id(indice->entradas, indice->capacidade, id);
+        if (indice->entradas[i].posicao != INDICE_CLIENTE_VAZIO) {
+            return 0;
+        }
+        indice->entradas[i].id = id;
+        indice->entradas[i].posicao = posicao;
+    }
+
+    if (indice->num_itens == 0 || id > indice->id_maximo) {
+        indice->id_maximo = id;
+    }
+    indice->num_itens++;
+    return 1;
+}
+
+// Retorna a posição do cliente com o id no array, ou -1 se não existir
+int indice_clientes_buscar(const IndiceClientes *indice, int id) {
+    if (indice->denso) {
+        long long deslocamento = (long long) id - indice->id_minimo;
+        return (deslocamento >= 0 && deslocamento < indice->capacidade) ? indice->posicoes[deslocamento] : -1;
+    }
+    if (indice->capacidade == 0) {
+        return -1;
+    }
+    unsigned int i = procurar_id(indice->entradas, indice->capacidade, id);
+    return indice->entradas[i].posicao;
+}
+
+// Cria o índice do array de clientes, escolhendo a tabela direta se os ids forem compactos
+// Retorna 1 em caso de sucesso e 0 se faltar memória (o índice fica vazio e inválido)
+int construir_indice_clientes(IndiceClientes *indice, const Cliente *clientes, int num_clientes) {
+    zerar_indice(indice);
+    long long minimo = 0, maximo = -1;
+    for (int i = 0; i < num_clientes; i++) {
+        if (i == 0 || clientes[i].id < minimo) {
+            minimo = clientes[i].id;
+        }
+        if (i == 0 || clientes[i].id > maximo) {
+            maximo = clientes[i].id;
+        }
+    }
+
+    if (num_clientes > 0 && faixa_densa(minimo, maximo, num_clientes)) {
+        int capacidade = (int) (maximo - minimo + 1);
+        indice->posicoes = (int*) malloc((size_t) capacidade * sizeof(int));
+        if (!indice->posicoes) {
+            return 0;
+        }
+        for (int i = 0; i < capacidade; i++) {
+            indice->posicoes[i] = INDICE_CLIENTE_VAZIO;
+        }
+        indice->denso = 1;
+        indice->id_minimo = (int) minimo;
+        indice->capacidade = capacidade;
+    } else {
+        indice->entradas = alocar_hash(num_clientes, &indice->capacidade);
+        if (!indice->entradas) {
+            return 0;
+        }
+    }
+
+    for (int i = 0; i < num_clientes; i++) {
+        if (indice_clientes_inserir(indice, clientes[i].id, i) < 0) {
+            liberar_indice_clientes(indice);
+            return 0;
+        }
+    }
+    indice->clientes = clientes;
+    indice->num_clientes = num_clientes;
+    return 1;
+}
+
+// Libera a memória do índice (que deixa de valer para qualquer array)
+void liberar_indice_clientes(IndiceClientes *indice) {
+    free(indice->posicoes);
+    free(indice->entradas);
+    zerar_indice(indice);
+}
+
+// O índice foi criado para este array (mesmo ponteiro e mesmo número de clientes)?
+int indice_clientes_valido(const IndiceClientes *indice, const Cliente *clientes, int num_clientes) {
+    return indice->clientes != NULL && indice->clientes == clientes && indice->num_clientes == num_clientes;
+}
@@ -0,0 +1,43 @@
+#ifndef INDICE_CLIENTES_H
+#define INDICE_CLIENTES_H
+
+#include "utils.h"
+
+// Índice de id do cliente para a posição no array de clientes, para que cada linha
+// de empréstimo encontre o seu cliente em O(1) em vez de percorrer o array
+// Dois formatos, escolhidos pela distribuição dos ids:
+// - denso: ids compactos (faixa até ~2x o número de clientes) usam uma tabela direta,
+//   posicoes[id - id_minimo], sem hash nem sondagem
+// - hash: ids espalhados usam endereçamento aberto com sondagem linear (ocupação abaixo de 1/2)
+// Ids repetidos ficam com a primeira ocorrência, como na busca linear
+
+#define INDICE_CLIENTE_VAZIO (-1)
+
+typedef struct {
+    int id;
+    int posicao;        // Posição no array de clientes ou INDICE_CLIENTE_VAZIO
+} EntradaIndiceCliente;
+
+typedef struct {
+    int denso;                      // 1: tabela direta, 0: hash
+    int id_minimo;                  // Denso: id da posição 0 de "posicoes"
+    int *posicoes;                  // Denso: posição do cliente de cada id (ou INDICE_CLIENTE_VAZIO)
+    EntradaIndiceCliente *entradas; // Hash
+    int capacidade;                 // Tamanho de "posicoes" ou de "entradas" (potência de 2 no hash)
+    int num_itens;
+    int id_maximo;                  // Maior id indexado (para gerar o próximo id sem percorrer o array)
+    const Cliente *clientes;        // Array indexado: o índice só vale para ele
+    int num_clientes;
+} IndiceClientes;
+
+// Índice do array de clientes do programa (criado pelos carregadores de clientes)
+extern IndiceClientes indice_clientes;
+
+// Protótipos das funções em indice_clientes.c
+int construir_indice_clientes(IndiceClientes *indice, const Cliente *clientes, int num_clientes);
+void liberar_indice_clientes(IndiceClientes *indice);
+int indice_clientes_inserir(IndiceClientes *indice, int id, int posicao);
+int indice_clientes_buscar(const IndiceClientes *indice, int id);
+int indice_clientes_valido(const IndiceClientes *indice, const Cliente *clientes, int num_clientes);
+
+#endif
@@ -0,0 +1,257 @@
+#include "lote.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Fase 1: lê o arquivo de empréstimos para as colunas do lote (e reserva as colunas das outras fases)
+// Linhas inválidas e empréstimos de clientes inexistentes são avisados em stderr (na ordem
+// do arquivo, com as mesmas mensagens de carregar_emprestimos) e ficam fora do lote
+// Retorna 1 em caso de sucesso e 0 se o arquivo não pôde ser lido ou faltou memória
+int ler_lote_emprestimos(const char *nome_arquivo, Cliente *clientes, int num_clientes, LoteEmprestimos *lote) {
+    memset(lote, 0, sizeof(LoteEmprestimos));
+    lote->num_clientes = num_clientes;
+
+    ArquivoMapeado arquivo;
+    if (!mapear_arquivo(nome_arquivo, &arquivo)) {
+        perror("Erro ao abrir arquivo de emprestimos");
+        return 0;
+    }
+    const char *fim_arquivo = arquivo.dados + arquivo.tamanho;
+    const char *p = memchr(arquivo.dados, '\n', arquivo.tamanho);
+    p = p ? p + 1 : fim_arquivo;    // Pula o cabeçalho
+
+    // O número de quebras de linha limita o número de empréstimos: as colunas são alocadas uma vez só
+    size_t max_linhas = 1;
+    for (const char *q = p; (q = memchr(q, '\n', (size_t) (fim_arquivo - q))) != NULL; q++) {
+        max_linhas++;
+    }
+    lote->cliente_id = (int*) malloc(max_linhas * sizeof(int));
+    lote->valor_emprestimo = (float*) malloc(max_linhas * sizeof(float));
+    lote->num_parcelas = (int*) malloc(max_linhas * sizeof(int));
+    lote->posicao_cliente = (int*) malloc(max_linhas * sizeof(int));
+    lote->valor_parcela = (float*) malloc(max_linhas * sizeof(float));
+    lote->aprovacao = (unsigned char*) malloc(max_linhas);
+    if (!lote->cliente_id || !lote->valor_emprestimo || !lote->num_parcelas || !lote->posicao_cliente ||
+        !lote->valor_parcela || !lote->aprovacao) {
+        perror("Erro ao alocar memória para o lote de emprestimos");
+        liberar_lote(lote);
+        desmapear_arquivo(&arquivo);
+        return 0;
+    }
+
+    int numero_linha = 1;
+    while (p < fim_arquivo) {
+        const char *fim = csv_fim_linha(p, fim_arquivo);
+        numero_linha++;
+
+        Emprestimo novo_emprestimo;
+        LinhaCSV campos;
+        iniciar_linha_csv(&campos, p, fim);
+        if (analisar_linha_emprestimo(&campos, &novo_emprestimo)) {
+            Cliente *cliente = buscar_cliente_por_id(clientes, num_clientes, novo_emprestimo.cliente_id);
+            if (cliente) {
+                int n = lote->num_linhas++;
+                lote->cliente_id[n] = novo_emprestimo.cliente_id;
+                lote->valor_emprestimo[n] = novo_emprestimo.valor_emprestimo;
+                lote->num_parcelas[n] = novo_emprestimo.num_parcelas;
+                lote->posicao_cliente[n] = (int) (cliente - clientes);
+            } else {
+                fprintf(stderr, "Aviso: Cliente com ID %d não encontrado para o empréstimo.\n", novo_emprestimo.cliente_id);
+            }
+        } else {
+            reportar_erro_csv("emprestimos", numero_linha, &campos);
+        }
+        p = fim < fim_arquivo ? fim + 1 : fim_arquivo;
+    }
+
+    desmapear_arquivo(&arquivo);
+    return 1;
+}
+
+// Fase 2: valor_parcela = (valor + valor * TAXA_JUROS) / num_parcelas, como em calcular_valor_parcela
+// O juro é calculado em double e o total arredondado para float antes da divisão, como no código escalar
+// (com FMA disponível o compilador junta a multiplicação e a soma do código escalar; aqui também)
+void calcular_parcelas_lote(LoteEmprestimos *lote) {
+    int n = lote->num_linhas;
+    const float *valor = lote->valor_emprestimo;
+    const int *parcelas = lote->num_parcelas;
+    float *resultado = lote->valor_parcela;
+    int i = 0;
+
+#if defined(__AVX2__)
+    // 8 empréstimos por instrução
+    const __m256d juros = _mm256_set1_pd(TAXA_JUROS);
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(valor + i);
+        __m256d baixo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+        __m256d alto = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+#if defined(__FMA__)
+        baixo = _mm256_fmadd_pd(baixo, juros, baixo);
+        alto = _mm256_fmadd_pd(alto, juros, alto);
+#else
+        baixo = _mm256_add_pd(baixo, _mm256_mul_pd(baixo, juros));
+        alto = _mm256_add_pd(alto, _mm256_mul_pd(alto, juros));
+#endif
+        __m256 total = _mm256_set_m128(_mm256_cvtpd_ps(alto), _mm256_cvtpd_ps(baixo));
+        __m256 divisor = _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i*) (parcelas + i)));
+        _mm256_storeu_ps(resultado + i, _mm256_div_ps(total, divisor));
+    }
+#elif defined(__SSE2__)
+    // 4 empréstimos por instrução
+    const __m128d juros = _mm_set1_pd(TAXA_JUROS);
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(valor + i);
+        __m128d baixo = _mm_cvtps_pd(v);
+        __m128d alto = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+        baixo = _mm_add_pd(baixo, _mm_mul_pd(baixo, juros));
+        alto = _mm_add_pd(alto, _mm_mul_pd(alto, juros));
+        __m128 total = _mm_movelh_ps(_mm_cvtpd_ps(baixo), _mm_cvtpd_ps(alto));
+        __m128 divisor = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) (parcelas + i)));
+        _mm_storeu_ps(resultado + i, _mm_div_ps(total, divisor));
+    }
+#endif
+
+    // Restante (ou tudo, sem SIMD)
+    for (; i < n; i++) {
+        float valor_total = valor[i] + (valor[i] * TAXA_JUROS);
+        resultado[i] = valor_total / parcelas[i];
+    }
+}
+
+// Fase 3: agrupa as linhas por cliente com um counting sort estável pela posição do cliente
+// (um radix sort de um dígito só: a faixa de chaves é o número de clientes, e a contagem
+// de cada chave já dá o início do grupo de cada cliente)
+// Retorna 1 em caso de sucesso e 0 se faltar memória
+int agrupar_lote_por_cliente(LoteEmprestimos *lote) {
+    int n = lote->num_linhas;
+    int num_clientes = lote->num_clientes;
+    lote->inicio_cliente = (int*) calloc((size_t) num_clientes + 1, sizeof(int));
+    lote->ordem = (int*) malloc(((size_t) n + 1) * sizeof(int));
+    lote->parcela_agrupada = (float*) malloc(((size_t) n + 1) * sizeof(float));
+    if (!lote->inicio_cliente || !lote->ordem || !lote->parcela_agrupada) {
+        return 0;
+    }
+
+    int *inicio = lote->inicio_cliente;
+    for (int i = 0; i < n; i++) {
+        inicio[lote->posicao_cliente[i] + 1]++;
+    }
+    for (int c = 0; c < num_clientes; c++) {
+        inicio[c + 1] += inicio[c];
+    }
+    // Cada linha vai para o próximo lugar livre do grupo do seu cliente; no fim, inicio[c]
+    // aponta para o fim do grupo c (= início do grupo c + 1) e é deslocado de volta
+    for (int i = 0; i < n; i++) {
+        int k = inicio[lote->posicao_cliente[i]]++;
+        lote->ordem[k] = i;
+        lote->parcela_agrupada[k] = lote->valor_parcela[i];
+    }
+    memmove(inicio + 1, inicio, (size_t) num_clientes * sizeof(int));
+    inicio[0] = 0;
+    return 1;
+}
+
+// Fase 4: aprova ou reprova cada empréstimo, como em aprovar_reprovar_emprestimo
+// Por cliente, o total comprometido é uma soma acumulada das parcelas aprovadas até ali,
+// a partir das parcelas que o cliente já tinha no histórico
+void aprovar_lote(LoteEmprestimos *lote, const Cliente *clientes) {
+    for (int c = 0; c < lote->num_clientes; c++) {
+        int fim = lote->inicio_cliente[c + 1];
+        float total_parcelas_ativas = clientes[c].parcelas_comprometidas;
+        float salario = clientes[c].salario;
+        for (int k = lote->inicio_cliente[c]; k < fim; k++) {
+            float parcela = lote->parcela_agrupada[k];
+            float porcentagem_comprometida = (total_parcelas_ativas + parcela) / salario;
+            int aprovado = !(porcentagem_comprometida > LIMITE_PARCELA);
+            lote->aprovacao[lote->ordem[k]] = (unsigned char) aprovado;
+            if (aprovado) {
+                total_parcelas_ativas += parcela;
+            }
+        }
+    }
+}
+
+// Monta o empréstimo "i" (ordem do arquivo) do lote
+static Emprestimo emprestimo_do_lote(const LoteEmprestimos *lote, int i) {
+    Emprestimo emprestimo;
+    emprestimo.cliente_id = lote->cliente_id[i];
+    emprestimo.valor_emprestimo = lote->valor_emprestimo[i];
+    emprestimo.num_parcelas = lote->num_parcelas[i];
+    emprestimo.valor_parcela = lote->valor_parcela[i];
+    emprestimo.aprovacao = lote->aprovacao[i];
+    emprestimo.ativo = 1;
+    return emprestimo;
+}
+
+// Fase 5: acrescenta os empréstimos aos históricos dos clientes (uma reserva por cliente)
+// Retorna o array com todos os empréstimos na ordem do arquivo, como carregar_emprestimos
+// (NULL se o lote estiver vazio ou faltar memória para ele)
+Emprestimo *aplicar_lote(const LoteEmprestimos *lote, Cliente *clientes) {
+    for (int c = 0; c < lote->num_clientes; c++) {
+        int inicio = lote->inicio_cliente[c];
+        int fim = lote->inicio_cliente[c + 1];
+        if (inicio == fim) {
+            continue;
+        }
+        Cliente *cliente = &clientes[c];
+        if (!reservar_historico(&pool_historicos, cliente, cliente->num_emprestimos + (fim - inicio))) {
+            perror("Erro ao alocar memória para histórico de empréstimos");
+            continue;
+        }
+        for (int k = inicio; k < fim; k++) {
+            Emprestimo emprestimo = emprestimo_do_lote(lote, lote->ordem[k]);
+            cliente->historico_emprestimos[cliente->num_emprestimos++] = registro_do_emprestimo(emprestimo);
+            if (emprestimo.aprovacao) {
+                cliente->parcelas_comprometidas += emprestimo.valor_parcela;
+            }
+        }
+    }
+
+    if (lote->num_linhas == 0) {
+        return NULL;
+    }
+    Emprestimo *todos_emprestimos = realocar_memoria_emprestimo(NULL, lote->num_linhas);
+    if (!todos_emprestimos) {
+        perror("Erro ao alocar memória para todos os emprestimos");
+        return NULL;
+    }
+    for (int i = 0; i < lote->num_linhas; i++) {
+        todos_emprestimos[i] = emprestimo_do_lote(lote, i);
+    }
+    return todos_emprestimos;
+}
+
+void liberar_lote(LoteEmprestimos *lote) {
+    free(lote->cliente_id);
+    free(lote->valor_emprestimo);
+    free(lote->num_parcelas);
+    free(lote->posicao_cliente);
+    free(lote->valor_parcela);
+    free(lote->ordem);
+    free(lote->inicio_cliente);
+    free(lote->parcela_agrupada);
+    free(lote->aprovacao);
+    memset(lote, 0, sizeof(LoteEmprestimos));
+}
+
+// Carrega os empréstimos do arquivo com as fases do lote
+// Mesmo resultado (históricos, aprovações e array devolvido) de carregar_emprestimos
+Emprestimo *carregar_emprestimos_lote(const char *nome_arquivo, Cliente *clientes, int num_clientes) {
+    LoteEmprestimos lote;
+    if (!ler_lote_emprestimos(nome_arquivo, clientes, num_clientes, &lote)) {
+        return NULL;
+    }
+    Emprestimo *todos_emprestimos = NULL;
+    calcular_parcelas_lote(&lote);
+    if (!agrupar_lote_por_cliente(&lote)) {
+        perror("Erro ao alocar memória para o lote de emprestimos");
+    } else {
+        aprovar_lote(&lote, clientes);
+        todos_emprestimos = aplicar_lote(&lote, clientes);
+    }
+    liberar_lote(&lote);
+    return todos_emprestimos;
+}
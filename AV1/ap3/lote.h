@@ -0,0 +1,38 @@
+#ifndef LOTE_H
+#define LOTE_H
+
+#include "utils.h"
+
+// Aprovação em lote de um arquivo de empréstimos inteiro, em fases sobre colunas:
+//  1. leitura do CSV para arrays separados (id do cliente, valor, parcelas) e busca do cliente
+//  2. cálculo das parcelas com SIMD
+//  3. agrupamento das linhas por cliente (counting sort estável pela posição do cliente)
+//  4. aprovação: uma soma acumulada por cliente, na ordem do arquivo dentro de cada grupo
+//  5. inclusão nos históricos (uma reserva por cliente) e array de empréstimos na ordem do arquivo
+// O resultado é o mesmo de carregar_emprestimos: cada empréstimo vê as parcelas dos empréstimos
+// aprovados antes dele do mesmo cliente, e as somas em float seguem a mesma ordem
+
+typedef struct {
+    int num_linhas;             // Empréstimos lidos (só os de clientes encontrados)
+    int num_clientes;           // Tamanho do array de clientes usado na leitura
+    int *cliente_id;
+    float *valor_emprestimo;
+    int *num_parcelas;
+    int *posicao_cliente;       // Posição do cliente no array de clientes
+    float *valor_parcela;       // Fase 2
+    int *ordem;                 // Fase 3: linhas agrupadas por cliente (na ordem do arquivo dentro do grupo)
+    int *inicio_cliente;        // Fase 3: grupo do cliente c = ordem[inicio_cliente[c] .. inicio_cliente[c + 1] - 1]
+    float *parcela_agrupada;    // Fase 3: valor_parcela na ordem de "ordem"
+    unsigned char *aprovacao;   // Fase 4: 1 aprovado, 0 reprovado (ordem do arquivo)
+} LoteEmprestimos;
+
+// Protótipos das funções em lote.c
+int ler_lote_emprestimos(const char *nome_arquivo, Cliente *clientes, int num_clientes, LoteEmprestimos *lote);
+void calcular_parcelas_lote(LoteEmprestimos *lote);
+int agrupar_lote_por_cliente(LoteEmprestimos *lote);
+void aprovar_lote(LoteEmprestimos *lote, const Cliente *clientes);
+Emprestimo *aplicar_lote(const LoteEmprestimos *lote, Cliente *clientes);
+void liberar_lote(LoteEmprestimos *lote);
+Emprestimo *carregar_emprestimos_lote(const char *nome_arquivo, Cliente *clientes, int num_clientes);
+
+#endif
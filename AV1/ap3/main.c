@@ -1,32 +1,137 @@
 // main.c
 #include "utils.c"
 
+// Confere os totais de parcelas guardados nos clientes (--verificar) e avisa em stderr se houver diferença
+static int conferir_clientes(const Cliente *clientes, int num_clientes, const char *etapa) {
+    int divergentes = verificar_parcelas_comprometidas(clientes, num_clientes);
+    if (divergentes > 0) {
+        fprintf(stderr, "Verificação (%s): %d cliente(s) com total de parcelas divergente\n", etapa, divergentes);
+    }
+    return divergentes;
+}
+
 int main(int argc, char *argv[]) {
-    if (argc != 3) {
-        fprintf(stderr, "Uso: %s <clientes.csv> <emprestimos.csv>\n", argv[0]);
+    // --threads N carrega os arquivos com N threads (0 = número de processadores)
+    // --internar guarda uma vez só os nomes repetidos na arena de nomes
+    // --lote aprova os empréstimos do arquivo em fases sobre colunas (lote.c), com o mesmo resultado
+    // --particionado divide a aprovação dos empréstimos entre as threads pelo id do cliente
+    //   (com --threads N, N partições) e mostra em stderr o tempo de cada partição
+    // --pool guarda os históricos de empréstimos no pool (historicos.c) e mostra o uso de memória em stderr
+    // --verificar confere, depois da carga e de cada operação, o total de parcelas guardado em cada cliente
+    // --dados DIR grava cada cadastro e empréstimo no diário de DIR (diario.c) e, na abertura, carrega o
+    //   último snapshot de DIR e reaplica o diário (os CSVs só são lidos quando DIR ainda não tem snapshot)
+    // --fsync-lote N grava até N mutações do diário por fsync (padrão 1: cada mutação no disco antes de confirmada)
+    // --snapshot-cada N grava um snapshot novo a cada N mutações (0: só ao sair)
+    const char *arquivos[2] = {NULL, NULL};
+    int num_arquivos = 0;
+    int num_threads = -1;
+    int verificar = 0;
+    int lote = 0;
+    int particionado = 0;
+    const char *dados = NULL;
+    int registros_por_fsync = 1;
+    long snapshot_cada = DIARIO_SNAPSHOT_CADA;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--internar") == 0) {
+            arena_nomes.internar = 1;
+        } else if (strcmp(argv[i], "--particionado") == 0) {
+            particionado = 1;
+        } else if (strcmp(argv[i], "--pool") == 0) {
+            pool_historicos.ativo = 1;
+        } else if (strcmp(argv[i], "--lote") == 0) {
+            lote = 1;
+        } else if (strcmp(argv[i], "--verificar") == 0) {
+            verificar = 1;
+        } else if (strcmp(argv[i], "--dados") == 0 && i + 1 < argc) {
+            dados = argv[++i];
+        } else if (strcmp(argv[i], "--fsync-lote") == 0 && i + 1 < argc) {
+            registros_por_fsync = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--snapshot-cada") == 0 && i + 1 < argc) {
+            snapshot_cada = atol(argv[++i]);
+        } else if (num_arquivos < 2 && argv[i][0] != '-') {
+            arquivos[num_arquivos++] = argv[i];
+        } else {
+            num_arquivos = 0;
+            break;
+        }
+    }
+    if (num_arquivos != 2) {
+        fprintf(stderr, "Uso: %s <clientes.csv> <emprestimos.csv> [--threads N] [--internar] [--lote] [--particionado] [--pool] [--verificar]"
+                        " [--dados DIR] [--fsync-lote N] [--snapshot-cada N]\n", argv[0]);
         return 1;
     }
 
-    const char *nome_arquivo_clientes = argv[1];
-    const char *nome_arquivo_emprestimos = argv[2];
+    const char *nome_arquivo_clientes = arquivos[0];
+    const char *nome_arquivo_emprestimos = arquivos[1];
 
     int num_clientes = 0;
-    Cliente *clientes = carregar_clientes(nome_arquivo_clientes, &num_clientes);
+    int capacidade_clientes = 0;    // Espaço alocado no array de clientes (cresce no cadastro)
+    Cliente *clientes = NULL;
+
+    // Com --dados, o estado salvo (snapshot) substitui a leitura dos CSVs
+    if (dados) {
+        if (!abrir_diario(&diario_mutacoes, dados) || !carregar_snapshot_diario(&diario_mutacoes, &clientes, &num_clientes)) {
+            return 1;
+        }
+        diario_mutacoes.registros_por_fsync = registros_por_fsync > 0 ? registros_por_fsync : 1;
+        diario_mutacoes.snapshot_cada = snapshot_cada;
+    }
+
     if (!clientes) {
-        return 1;
+        if (num_threads >= 0) {
+            clientes = carregar_clientes_paralelo(nome_arquivo_clientes, &num_clientes, num_threads);
+        } else {
+            clientes = carregar_clientes(nome_arquivo_clientes, &num_clientes);
+        }
+        if (!clientes) {
+            return 1;
+        }
+
+        // Os empréstimos são carregados e adicionados ao histórico dos clientes
+        if (lote) {
+            carregar_emprestimos_lote(nome_arquivo_emprestimos, clientes, num_clientes);
+        } else if (particionado) {
+            EstatisticasParticoes estatisticas;
+            carregar_emprestimos_particionado(nome_arquivo_emprestimos, clientes, num_clientes,
+                                              num_threads >= 0 ? num_threads : 0, &estatisticas);
+            imprimir_estatisticas_particoes(stderr, &estatisticas);
+        } else if (num_threads >= 0) {
+            carregar_emprestimos_paralelo(nome_arquivo_emprestimos, clientes, num_clientes, num_threads);
+        } else {
+            carregar_emprestimos(nome_arquivo_emprestimos, clientes, num_clientes);
+        }
     }
 
-    // Os empréstimos são carregados e adicionados ao histórico dos clientes
-    carregar_emprestimos(nome_arquivo_emprestimos, clientes, num_clientes);
+    // Os carregadores e o snapshot devolvem o array sem folga
+    capacidade_clientes = num_clientes;
+
+    // As mutações gravadas depois do snapshot (ou desde o início, sem snapshot) são reaplicadas
+    if (dados) {
+        if (!recuperar_diario(&diario_mutacoes, &clientes, &num_clientes, &capacidade_clientes)) {
+            liberar_memoria(clientes, num_clientes);
+            return 1;
+        }
+        imprimir_estatisticas_diario(stderr, &diario_mutacoes);
+    }
+    if (pool_historicos.ativo) {
+        imprimir_estatisticas_pool(stderr, &pool_historicos, clientes, num_clientes);
+    }
+    int divergentes = verificar ? conferir_clientes(clientes, num_clientes, "carga") : 0;
 
     int opcao;
     Cliente *temp_clientes = NULL; // Declaração movida para fora do switch
     do {
+        // O menu pode ficar parado esperando o usuário: os registros pendentes do diário vão
+        // para o disco antes, senão poderiam esperar muito mais que espera_maxima
+        sincronizar_diario(&diario_mutacoes);
         printf("\n----------------Entrada------------------------------\n");
         printf("1 - Cadastrar Novo Cliente\n");
         printf("2 - Solicitar Novo Emprestimo\n");
         printf("3 - Listar Clientes e seus Emprestimos\n");
         printf("4 - Listar todos os Emprestimos Carregados\n");
+        printf("5 - Desativar Emprestimo\n");
         printf("0 - Sair\n");
         printf("-------------------------------------------------------\n");
         printf("Digite a opcao desejada: ");
@@ -35,7 +140,7 @@ int main(int argc, char *argv[]) {
 
         switch (opcao) {
             case 1:
-                temp_clientes = cadastrar_novo_cliente(clientes, &num_clientes);
+                temp_clientes = cadastrar_novo_cliente(clientes, &num_clientes, &capacidade_clientes);
                 if (temp_clientes) {
                     clientes = temp_clientes;
                 } else {
@@ -51,15 +156,27 @@ int main(int argc, char *argv[]) {
             case 4:
                 listar_emprestimos(clientes, num_clientes);
                 break;
+            case 5:
+                desativar_emprestimo(clientes, num_clientes);
+                break;
             case 0:
                 printf("Saindo...\n");
                 break;
             default:
                 printf("Opcao invalida. Tente novamente.\n");
         }
+        if (verificar && (opcao == 1 || opcao == 2 || opcao == 5)) {
+            divergentes += conferir_clientes(clientes, num_clientes,
+                                             opcao == 1 ? "cadastro" : opcao == 2 ? "emprestimo" : "desativacao");
+        }
+        if (opcao == 1 || opcao == 2 || opcao == 5) {
+            manter_diario(&diario_mutacoes, clientes, num_clientes);
+        }
     } while (opcao != 0);
 
+    fechar_diario(&diario_mutacoes, clientes, num_clientes);
     liberar_memoria(clientes, num_clientes);
+    liberar_arena(&arena_nomes);
 
-    return 0;
+    return divergentes > 0 ? 1 : 0;
 }
\ No newline at end of file
@@ -0,0 +1,259 @@
+#include "snapshot.h"
+
+#include <limits.h>
+
+// Posição de cada seção dentro do arquivo
+typedef struct {
+    size_t id;
+    size_t salario;
+    size_t parcelas_comprometidas;
+    size_t num_emprestimos;
+    size_t deslocamento_nome;
+    size_t tamanho_nome;
+    size_t nomes;
+    size_t valor_emprestimo;
+    size_t num_parcelas;
+    size_t valor_parcela;
+    size_t estado;
+    size_t total;
+} SecoesSnapshot;
+
+// Calcula onde começa cada seção para "n" clientes, "m" empréstimos e "tamanho_nomes" bytes de nomes
+static void calcular_secoes(size_t n, size_t m, size_t tamanho_nomes, SecoesSnapshot *secoes) {
+    size_t pos = sizeof(CabecalhoSnapshot);
+    secoes->id = pos;                      pos += alinhar_secao(n * sizeof(int32_t));
+    secoes->salario = pos;                 pos += alinhar_secao(n * sizeof(float));
+    secoes->parcelas_comprometidas = pos;  pos += alinhar_secao(n * sizeof(float));
+    secoes->num_emprestimos = pos;         pos += alinhar_secao(n * sizeof(int32_t));
+    secoes->deslocamento_nome = pos;       pos += alinhar_secao(n * sizeof(uint32_t));
+    secoes->tamanho_nome = pos;            pos += alinhar_secao(n * sizeof(uint32_t));
+    secoes->nomes = pos;                   pos += alinhar_secao(tamanho_nomes);
+    secoes->valor_emprestimo = pos;        pos += alinhar_secao(m * sizeof(float));
+    secoes->num_parcelas = pos;            pos += alinhar_secao(m * sizeof(int32_t));
+    secoes->valor_parcela = pos;           pos += alinhar_secao(m * sizeof(float));
+    secoes->estado = pos;                  pos += alinhar_secao(m);
+    secoes->total = pos;
+}
+
+// Grava os clientes e os históricos em "nome_snapshot", marcando a última mutação do diário
+// incluída ("sequencia")
+// O arquivo é gravado de forma atômica (substituir_arquivo), então um snapshot pela metade
+// nunca é usado
+// Retorna 1 em caso de sucesso e 0 em caso de erro
+int salvar_snapshot(const char *nome_snapshot, const Cliente *clientes, int num_clientes, uint64_t sequencia) {
+    size_t n = (size_t) num_clientes;
+    size_t m = 0;
+    for (size_t i = 0; i < n; i++) {
+        m += (size_t) clientes[i].num_emprestimos;
+    }
+
+    CabecalhoSnapshot cabecalho;
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.magica, SNAPSHOT_MAGICA, sizeof(cabecalho.magica));
+    cabecalho.versao = SNAPSHOT_VERSAO;
+    cabecalho.ordem_bytes = SNAPSHOT_ORDEM_BYTES;
+    cabecalho.num_clientes = (uint64_t) n;
+    cabecalho.num_emprestimos = (uint64_t) m;
+    cabecalho.tamanho_nomes = (uint64_t) arena_nomes.tamanho;
+    cabecalho.sequencia = sequencia;
+
+    // Um buffer serve para todas as colunas de até 4 bytes; os nomes têm o seu
+    size_t tamanho_nomes = arena_nomes.tamanho;
+    char *coluna = (char*) malloc(alinhar_secao((n > m ? n : m) * 4) + SNAPSHOT_ALINHAMENTO);
+    char *nomes = (char*) malloc(alinhar_secao(tamanho_nomes) + SNAPSHOT_ALINHAMENTO);
+    char nome_temporario[FILENAME_MAX];
+    FILE *fp = (coluna && nomes) ? abrir_arquivo_temporario(nome_snapshot, nome_temporario, sizeof(nome_temporario)) : NULL;
+    if (!fp) {
+        free(coluna);
+        free(nomes);
+        return 0;
+    }
+
+    // O cabeçalho é gravado de novo no final, com o checksum
+    uint64_t checksum = CHECKSUM_INICIAL;
+    int ok = fwrite(&cabecalho, sizeof(cabecalho), 1, fp) == 1;
+
+    int32_t *inteiros = (int32_t*) coluna;
+    float *reais = (float*) coluna;
+    uint32_t *posicoes = (uint32_t*) coluna;
+    uint8_t *bytes = (uint8_t*) coluna;
+
+    for (size_t i = 0; i < n; i++) {
+        inteiros[i] = clientes[i].id;
+    }
+    ok = ok && escrever_secao(fp, coluna, n * sizeof(int32_t), &checksum);
+    for (size_t i = 0; i < n; i++) {
+        reais[i] = clientes[i].salario;
+    }
+    ok = ok && escrever_secao(fp, coluna, n * sizeof(float), &checksum);
+    for (size_t i = 0; i < n; i++) {
+        reais[i] = clientes[i].parcelas_comprometidas;
+    }
+    ok = ok && escrever_secao(fp, coluna, n * sizeof(float), &checksum);
+    for (size_t i = 0; i < n; i++) {
+        inteiros[i] = clientes[i].num_emprestimos;
+    }
+    ok = ok && escrever_secao(fp, coluna, n * sizeof(int32_t), &checksum);
+    for (size_t i = 0; i < n; i++) {
+        posicoes[i] = clientes[i].nome.deslocamento;
+    }
+    ok = ok && escrever_secao(fp, coluna, n * sizeof(uint32_t), &checksum);
+    for (size_t i = 0; i < n; i++) {
+        posicoes[i] = clientes[i].nome.tamanho;
+    }
+    ok = ok && escrever_secao(fp, coluna, n * sizeof(uint32_t), &checksum);
+    if (tamanho_nomes > 0) {
+        memcpy(nomes, arena_nomes.dados, tamanho_nomes);
+    }
+    ok = ok && escrever_secao(fp, nomes, tamanho_nomes, &checksum);
+
+    // Colunas dos empréstimos: os históricos na ordem dos clientes
+    size_t k = 0;
+    for (size_t i = 0; i < n; i++) {
+        for (int j = 0; j < clientes[i].num_emprestimos; j++) {
+            reais[k++] = clientes[i].historico_emprestimos[j].valor_emprestimo;
+        }
+    }
+    ok = ok && escrever_secao(fp, coluna, m * sizeof(float), &checksum);
+    k = 0;
+    for (size_t i = 0; i < n; i++) {
+        for (int j = 0; j < clientes[i].num_emprestimos; j++) {
+            inteiros[k++] = clientes[i].historico_emprestimos[j].num_parcelas;
+        }
+    }
+    ok = ok && escrever_secao(fp, coluna, m * sizeof(int32_t), &checksum);
+    k = 0;
+    for (size_t i = 0; i < n; i++) {
+        for (int j = 0; j < clientes[i].num_emprestimos; j++) {
+            reais[k++] = clientes[i].historico_emprestimos[j].valor_parcela;
+        }
+    }
+    ok = ok && escrever_secao(fp, coluna, m * sizeof(float), &checksum);
+    k = 0;
+    for (size_t i = 0; i < n; i++) {
+        for (int j = 0; j < clientes[i].num_emprestimos; j++) {
+            const RegistroHistorico *registro = &clientes[i].historico_emprestimos[j];
+            bytes[k++] = (uint8_t) (registro->aprovacao | (registro->ativo << 1));
+        }
+    }
+    ok = ok && escrever_secao(fp, coluna, m, &checksum);
+
+    cabecalho.checksum = checksum;
+    ok = ok && fseek(fp, 0, SEEK_SET) == 0 && fwrite(&cabecalho, sizeof(cabecalho), 1, fp) == 1;
+    free(coluna);
+    free(nomes);
+    return substituir_arquivo(fp, nome_temporario, nome_snapshot, ok);
+}
+
+// Monta os clientes e os históricos a partir do snapshot "nome_snapshot"
+// Os nomes vão para a arena_nomes, os históricos para o pool_historicos (se ativo) e o
+// índice de clientes é criado, como nos carregadores de CSV
+// Retorna NULL sem mensagem se o snapshot não existir, e com uma mensagem se ele estiver
+// corrompido; "sequencia" recebe a última mutação do diário incluída no snapshot
+Cliente *carregar_snapshot(const char *nome_snapshot, int *num_clientes, uint64_t *sequencia) {
+    ArquivoMapeado arquivo;
+    if (!mapear_arquivo_binario(nome_snapshot, &arquivo)) {
+        return NULL;
+    }
+
+    CabecalhoSnapshot cabecalho;
+    if (arquivo.tamanho < sizeof(cabecalho)) {
+        fprintf(stderr, "Snapshot %s corrompido\n", nome_snapshot);
+        desmapear_arquivo(&arquivo);
+        return NULL;
+    }
+    memcpy(&cabecalho, arquivo.dados, sizeof(cabecalho));
+    if (memcmp(cabecalho.magica, SNAPSHOT_MAGICA, sizeof(cabecalho.magica)) != 0 ||
+        cabecalho.versao != SNAPSHOT_VERSAO || cabecalho.ordem_bytes != SNAPSHOT_ORDEM_BYTES ||
+        cabecalho.num_clientes > INT_MAX || cabecalho.num_emprestimos > (uint64_t) arquivo.tamanho ||
+        cabecalho.tamanho_nomes > (uint64_t) arquivo.tamanho) {
+        fprintf(stderr, "Snapshot %s inválido ou de outra versão\n", nome_snapshot);
+        desmapear_arquivo(&arquivo);
+        return NULL;
+    }
+
+    size_t n = (size_t) cabecalho.num_clientes;
+    size_t m = (size_t) cabecalho.num_emprestimos;
+    size_t tamanho_nomes = (size_t) cabecalho.tamanho_nomes;
+    SecoesSnapshot secoes;
+    calcular_secoes(n, m, tamanho_nomes, &secoes);
+    const char *dados = arquivo.dados;
+    if (secoes.total != arquivo.tamanho ||
+        atualizar_checksum(CHECKSUM_INICIAL, dados + sizeof(cabecalho), secoes.total - sizeof(cabecalho)) != cabecalho.checksum) {
+        fprintf(stderr, "Snapshot %s corrompido\n", nome_snapshot);
+        desmapear_arquivo(&arquivo);
+        return NULL;
+    }
+
+    // As colunas são lidas direto do mapeamento (todas alinhadas em 64 bytes)
+    const int32_t *ids = (const int32_t*) (dados + secoes.id);
+    const float *salarios = (const float*) (dados + secoes.salario);
+    const float *parcelas_comprometidas = (const float*) (dados + secoes.parcelas_comprometidas);
+    const int32_t *num_emprestimos = (const int32_t*) (dados + secoes.num_emprestimos);
+    const uint32_t *deslocamentos = (const uint32_t*) (dados + secoes.deslocamento_nome);
+    const uint32_t *tamanhos = (const uint32_t*) (dados + secoes.tamanho_nome);
+    const char *nomes = dados + secoes.nomes;
+    const float *valores = (const float*) (dados + secoes.valor_emprestimo);
+    const int32_t *parcelas = (const int32_t*) (dados + secoes.num_parcelas);
+    const float *valores_parcela = (const float*) (dados + secoes.valor_parcela);
+    const uint8_t *estados = (const uint8_t*) (dados + secoes.estado);
+
+    // Os históricos precisam somar exatamente as colunas de empréstimos
+    size_t soma = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (num_emprestimos[i] < 0) {
+            soma = m + 1;
+            break;
+        }
+        soma += (size_t) num_emprestimos[i];
+    }
+    Cliente *clientes = soma == m ? (Cliente*) malloc((n > 0 ? n : 1) * sizeof(Cliente)) : NULL;
+    if (!clientes) {
+        if (soma != m) {
+            fprintf(stderr, "Snapshot %s corrompido\n", nome_snapshot);
+        } else {
+            perror("Erro ao alocar memória para clientes");
+        }
+        desmapear_arquivo(&arquivo);
+        return NULL;
+    }
+
+    size_t k = 0;
+    for (size_t i = 0; i < n; i++) {
+        Cliente *cliente = &clientes[i];
+        cliente->id = ids[i];
+        cliente->salario = salarios[i];
+        cliente->historico_emprestimos = NULL;
+        cliente->num_emprestimos = 0;
+        cliente->capacidade_emprestimos = 0;
+        cliente->parcelas_comprometidas = parcelas_comprometidas[i];
+
+        // Um nome fora da tabela vira nome vazio
+        int nome_ok = (size_t) deslocamentos[i] + tamanhos[i] <= tamanho_nomes;
+        if (!arena_adicionar(&arena_nomes, nome_ok ? nomes + deslocamentos[i] : "", nome_ok ? tamanhos[i] : 0, &cliente->nome) ||
+            (num_emprestimos[i] > 0 && !reservar_historico(&pool_historicos, cliente, num_emprestimos[i]))) {
+            perror("Erro ao alocar memória para o snapshot");
+            liberar_memoria(clientes, (int) i + 1);
+            desmapear_arquivo(&arquivo);
+            return NULL;
+        }
+
+        for (int j = 0; j < num_emprestimos[i]; j++, k++) {
+            Emprestimo emprestimo;
+            emprestimo.cliente_id = cliente->id;
+            emprestimo.valor_emprestimo = valores[k];
+            emprestimo.num_parcelas = parcelas[k];
+            emprestimo.valor_parcela = valores_parcela[k];
+            emprestimo.aprovacao = estados[k] & 1;
+            emprestimo.ativo = (estados[k] >> 1) & 1;
+            cliente->historico_emprestimos[j] = registro_do_emprestimo(emprestimo);
+        }
+        cliente->num_emprestimos = num_emprestimos[i];
+    }
+
+    desmapear_arquivo(&arquivo);
+    indexar_clientes(clientes, (int) n);
+    *num_clientes = (int) n;
+    *sequencia = cabecalho.sequencia;
+    return clientes;
+}
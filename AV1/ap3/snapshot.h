@@ -0,0 +1,46 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+#include "utils.h"
+
+// Snapshot binário dos clientes e dos seus históricos de empréstimos (formato em colunas)
+// Guarda o estado depois de todas as mutações do diário até "sequencia" (ver diario.h):
+// na recuperação, o snapshot é carregado e só as mutações seguintes são reaplicadas
+//
+// Layout (na ordem de bytes da máquina, cada seção começa em múltiplo de 64 bytes):
+//   CabecalhoSnapshot (64 bytes)
+//   id                      int32[n]
+//   salario                 float[n]
+//   parcelas_comprometidas  float[n]
+//   num_emprestimos         int32[n]   (empréstimos de cada cliente, na ordem dos clientes)
+//   deslocamento_nome       uint32[n]  (posição do nome na tabela de nomes)
+//   tamanho_nome            uint32[n]
+//   tabela de nomes         bytes da arena_nomes
+//   valor_emprestimo        float[m]   (históricos de todos os clientes, um depois do outro)
+//   num_parcelas            int32[m]
+//   valor_parcela           float[m]
+//   estado                  uint8[m]   (bit 0: aprovado, bit 1: ativo)
+
+#define SNAPSHOT_MAGICA "AP3SNAPS"
+#define SNAPSHOT_VERSAO 1
+#define SNAPSHOT_ORDEM_BYTES BINARIO_ORDEM_BYTES
+#define SNAPSHOT_ALINHAMENTO BINARIO_ALINHAMENTO
+
+typedef struct {
+    char magica[8];             // SNAPSHOT_MAGICA
+    uint32_t versao;            // SNAPSHOT_VERSAO
+    uint32_t ordem_bytes;       // SNAPSHOT_ORDEM_BYTES, para detectar outra arquitetura
+    uint64_t num_clientes;      // Linhas das colunas de clientes
+    uint64_t num_emprestimos;   // Linhas das colunas de empréstimos (soma dos históricos)
+    uint64_t tamanho_nomes;     // Bytes da tabela de nomes
+    uint64_t sequencia;         // Última mutação do diário incluída no snapshot
+    uint64_t checksum;          // Checksum de tudo o que vem depois do cabeçalho
+    uint64_t reservado;
+} CabecalhoSnapshot;
+
+// Protótipos das funções em snapshot.c
+int salvar_snapshot(const char *nome_snapshot, const Cliente *clientes, int num_clientes, uint64_t sequencia);
+Cliente *carregar_snapshot(const char *nome_snapshot, int *num_clientes, uint64_t *sequencia);
+
+#endif
@@ -1,7 +1,16 @@
 #include "utils.h"
-
-#define TAXA_JUROS 0.05
-#define LIMITE_PARCELA 0.20
+#include "../comum/mapeamento.c"
+#include "../comum/binario.c"
+#include "../comum/vetor.c"
+#include "../comum/paralelo.c"
+#include "../comum/csv.c"
+#include "../comum/arena.c"
+#include "../comum/tempo.c"
+#include "indice_clientes.c"
+#include "historicos.c"
+#include "lote.c"
+#include "snapshot.c"
+#include "diario.c"
 
 
 // Definição de macros para limpar a tela
@@ -50,14 +59,21 @@ Emprestimo* realocar_memoria_emprestimo(Emprestimo *emprestimos, int novo_tamanh
 */
 
 // Cadastra um novo cliente e adiciona ao array de clientes
-Cliente *cadastrar_novo_cliente(Cliente *clientes, int *num_clientes) {
+Cliente *cadastrar_novo_cliente(Cliente *clientes, int *num_clientes, int *capacidade_clientes) {
     Cliente novo_cliente;
     
     // Gera um ID único para o novo cliente (maior ID atual + 1)
+    // Com o índice válido o maior ID já está guardado nele; sem ele, percorre o array
     int maior_id = 0;
-    for (int i = 0; i < *num_clientes; i++) {
-        if (clientes[i].id > maior_id) {
-            maior_id = clientes[i].id;
+    if (indice_clientes_valido(&indice_clientes, clientes, *num_clientes)) {
+        if (indice_clientes.num_itens > 0 && indice_clientes.id_maximo > maior_id) {
+            maior_id = indice_clientes.id_maximo;
+        }
+    } else {
+        for (int i = 0; i < *num_clientes; i++) {
+            if (clientes[i].id > maior_id) {
+                maior_id = clientes[i].id;
+            }
         }
     }
     novo_cliente.id = maior_id + 1;
@@ -65,12 +81,22 @@ Cliente *cadastrar_novo_cliente(Cliente *clientes, int *num_clientes) {
     // Solicita informações do cliente
     printf("\n--- Cadastro de Novo Cliente ---\n");
     printf("Nome: ");
-    fgets(novo_cliente.nome, MAX_NOME, stdin);
-    // Remove o caractere de nova linha do final do nome
-    novo_cliente.nome[strcspn(novo_cliente.nome, "\n")] = '\0';
+    // Lê a linha inteira (sem limite de tamanho) e guarda o nome, sem o '\n', na arena
+    size_t marca = arena_marca(&arena_nomes);
+    char *nome = NULL;
+    int capacidade_nome = 0;
+    long tamanho_nome = ler_linha(stdin, &nome, &capacidade_nome);
+    int nome_ok = arena_adicionar(&arena_nomes, nome ? nome : "", tamanho_nome > 0 ? (size_t) tamanho_nome : 0,
+                                  &novo_cliente.nome);
+    free(nome);
+    if (!nome_ok) {
+        perror("Erro ao alocar memória para o nome");
+        return clientes;
+    }
     
     printf("Salario: ");
     if (scanf("%f", &novo_cliente.salario) != 1) {
+        arena_descartar(&arena_nomes, marca);
         msg_erro("Erro: Salario invalido.\n");
         limpar_buffer();
         return clientes;
@@ -80,19 +106,67 @@ Cliente *cadastrar_novo_cliente(Cliente *clientes, int *num_clientes) {
     // Inicializa o histórico de empréstimos
     novo_cliente.historico_emprestimos = NULL;
     novo_cliente.num_emprestimos = 0;
+    novo_cliente.capacidade_emprestimos = 0;
+    novo_cliente.parcelas_comprometidas = 0.0;
     
-    // Realoca memória para adicionar o novo cliente
-    Cliente *temp = realocar_memoria_cliente(clientes, (*num_clientes + 1));
+    // Reserva o espaço no array antes do diário: depois de gravado, o cadastro não pode falhar
+    Cliente *temp = reservar_cliente(clientes, *num_clientes, capacidade_clientes);
     if (!temp) {
+        arena_descartar(&arena_nomes, marca);
         msg_erro("Erro: Falha ao alocar memória para o novo cliente.\n");
         return clientes;
     }
+    clientes = temp;
     
-    // Adiciona o novo cliente ao array
-    temp[*num_clientes] = novo_cliente;
-    (*num_clientes)++;
+    // Com --dados, o cadastro vai para o diário antes de entrar no array
+    if (!registrar_cliente(&diario_mutacoes, &novo_cliente)) {
+        arena_descartar(&arena_nomes, marca);
+        msg_erro("Erro: Falha ao gravar o cadastro no diario.\n");
+        return clientes;
+    }
+    
+    // Adiciona o novo cliente ao array (no espaço já reservado)
+    clientes = incluir_cliente(clientes, num_clientes, capacidade_clientes, novo_cliente);
     
     printf("\nCliente cadastrado com sucesso! ID: %d\n", novo_cliente.id);
+    return clientes;
+}
+
+// Garante espaço para mais um cliente no fim do array (a capacidade cresce dobrando)
+// "capacidade_clientes" é o espaço alocado no array (os carregadores devolvem arrays sem
+// folga: depois da carga, é o número de clientes) e é atualizada se o array crescer
+// Retorna o array, talvez em outro endereço (o índice passa a valer para ele), ou NULL se
+// faltar memória (o array antigo continua válido)
+Cliente *reservar_cliente(Cliente *clientes, int num_clientes, int *capacidade_clientes) {
+    int indice_ok = indice_clientes_valido(&indice_clientes, clientes, num_clientes);
+    Cliente *temp = VETOR_RESERVAR(clientes, *capacidade_clientes, (num_clientes + 1));
+    if (!temp) {
+        return NULL;
+    }
+    if (indice_ok) {
+        indice_clientes.clientes = temp;
+    }
+    return temp;
+}
+
+// Acrescenta o cliente ao fim do array e ao índice (que passa a valer para o array realocado)
+// Retorna o novo array ou NULL se faltar memória (o array antigo continua válido)
+// Depois de reservar_cliente com a mesma capacidade, não falha
+Cliente *incluir_cliente(Cliente *clientes, int *num_clientes, int *capacidade_clientes, Cliente novo_cliente) {
+    Cliente *temp = reservar_cliente(clientes, *num_clientes, capacidade_clientes);
+    if (!temp) {
+        return NULL;
+    }
+    int indice_ok = indice_clientes_valido(&indice_clientes, temp, *num_clientes);
+    temp[*num_clientes] = novo_cliente;
+    if (indice_ok && indice_clientes_inserir(&indice_clientes, novo_cliente.id, *num_clientes) >= 0) {
+        indice_clientes.clientes = temp;
+        indice_clientes.num_clientes = *num_clientes + 1;
+    } else if (indice_ok) {
+        // Sem memória para o índice: as buscas voltam a percorrer o array
+        liberar_indice_clientes(&indice_clientes);
+    }
+    (*num_clientes)++;
     return temp;
 }
 
@@ -149,7 +223,19 @@ void solicitar_novo_emprestimo(Cliente *clientes, int num_clientes) {
     // Verifica se o empréstimo pode ser aprovado
     aprovar_reprovar_emprestimo(cliente, &novo_emprestimo);
     
-    // Adiciona o empréstimo ao histórico do cliente
+    // Reserva o espaço no histórico antes do diário: depois de gravado, o empréstimo não pode falhar
+    if (!reservar_historico(&pool_historicos, cliente, cliente->num_emprestimos + 1)) {
+        msg_erro("Erro: Falha ao alocar memória para o histórico de emprestimos.\n");
+        return;
+    }
+    
+    // Com --dados, o empréstimo vai para o diário antes de entrar no histórico
+    if (!registrar_emprestimo(&diario_mutacoes, &novo_emprestimo)) {
+        msg_erro("Erro: Falha ao gravar o emprestimo no diario.\n");
+        return;
+    }
+    
+    // Adiciona o empréstimo ao histórico do cliente (no espaço já reservado)
     adicionar_emprestimo_historico(cliente, novo_emprestimo);
     
     // Exibe o resultado da solicitação
@@ -181,15 +267,9 @@ void calcular_valor_parcela(Emprestimo *emprestimo) {
 
 // Aprova ou reprova o empréstimo com base no salário do cliente
 void aprovar_reprovar_emprestimo(Cliente *cliente, Emprestimo *novo_emprestimo) {
-    // Calcula o valor total das parcelas de empréstimos ativos
-    float total_parcelas_ativas = 0.0;
-    
-    // Verifica se o cliente tem empréstimos ativos e soma suas parcelas
-    for (int i = 0; i < cliente->num_emprestimos; i++) {
-        if (cliente->historico_emprestimos[i].ativo && cliente->historico_emprestimos[i].aprovacao) {
-            total_parcelas_ativas += cliente->historico_emprestimos[i].valor_parcela;
-        }
-    }
+    // O valor total das parcelas de empréstimos ativos e aprovados já está guardado no cliente
+    // (somado na ordem do histórico: o mesmo valor que a soma percorrendo o histórico daria)
+    float total_parcelas_ativas = cliente->parcelas_comprometidas;
     
     // Adiciona a parcela do novo empréstimo
     float total_comprometido = total_parcelas_ativas + novo_emprestimo->valor_parcela;
@@ -208,6 +288,15 @@ void aprovar_reprovar_emprestimo(Cliente *cliente, Emprestimo *novo_emprestimo)
 
 
 
+// Cria o índice_clientes do array recém-carregado (substituindo o anterior)
+// Se faltar memória, as buscas por ID continuam funcionando, só que percorrendo o array
+void indexar_clientes(const Cliente *clientes, int num_clientes) {
+    liberar_indice_clientes(&indice_clientes);
+    if (clientes && !construir_indice_clientes(&indice_clientes, clientes, num_clientes)) {
+        perror("Erro ao alocar memória para o índice de clientes");
+    }
+}
+
 // Carrega os clientes do arquivo CSV e retorna um array de clientes
 // O número de clientes é retornado através do ponteiro num_clientes
 // O arquivo deve ter o formato: id,nome,salario
@@ -221,44 +310,58 @@ Cliente *carregar_clientes(const char *nome_arquivo, int *num_clientes) {
     }
 
     Cliente *clientes = NULL;   // Inicializa o ponteiro para clientes
+    int capacidade = 0;         // Espaço alocado no array de clientes
     *num_clientes = 0;          // Inicializa o número de clientes   
-    char linha[256];            // Buffer para ler cada linha do arquivo
-    fgets(linha, sizeof(linha), arquivo); // Ler e descartar o cabeçalho
+    char *linha = NULL;         // Buffer para ler cada linha do arquivo (cresce se preciso)
+    int capacidade_linha = 0;
+    long tamanho_linha;
+    int numero_linha = 1;       // Número da linha no arquivo (para as mensagens de erro)
+    ler_linha(arquivo, &linha, &capacidade_linha); // Ler e descartar o cabeçalho
 
-    while (fgets(linha, sizeof(linha), arquivo)) { // Lê cada linha do arquivo
+    while ((tamanho_linha = ler_linha(arquivo, &linha, &capacidade_linha)) >= 0) { // Lê cada linha do arquivo
         Cliente novo_cliente; // Inicializa um novo cliente
+        numero_linha++;
         // Lê os dados do cliente da linha e armazena em novo_cliente
         // O formato esperado é: id,nome,salario
         // Exemplo: 1,João,3000.00
-        // O sscanf retorna o número de itens lidos com sucesso
-        if (sscanf(linha, "%d,%[^,],%f", &novo_cliente.id, novo_cliente.nome, &novo_cliente.salario) == 3) {
+        // Os campos são lidos pelo leitor de CSV (comum/csv.c) e o nome vai para a arena_nomes
+        LinhaCSV campos;
+        iniciar_linha_csv(&campos, linha, linha + tamanho_linha);
+        if (analisar_linha_cliente(&campos, &arena_nomes, &novo_cliente)) {
 
             /* 
                 ATENÇÃO: A função "realocar_memoria_cliente" deve ser implementada pelo aluno 
             */
 
-            // Realoca memória para mais um cliente
-            clientes = realocar_memoria_cliente(clientes, (*num_clientes + 1));
+            // Garante espaço para mais um cliente (a capacidade cresce dobrando)
+            clientes = VETOR_RESERVAR(clientes, capacidade, (*num_clientes + 1));
 
             // Verifica se a realocação foi bem-sucedida
             if (!clientes) {
                 perror("Erro ao alocar memória para clientes");
+                free(linha);
                 fclose(arquivo);
                 return NULL;
             }
             // Adiciona o novo cliente ao array
             novo_cliente.historico_emprestimos = NULL; // Inicializa o histórico de empréstimos
             novo_cliente.num_emprestimos = 0; // Inicializa o número de empréstimos
+            novo_cliente.capacidade_emprestimos = 0;
+            novo_cliente.parcelas_comprometidas = 0.0;
             // Adiciona o novo cliente ao array de clientes
             // O ponteiro clientes é atualizado para apontar para o novo array
             clientes[*num_clientes] = novo_cliente;
             (*num_clientes)++; // Incrementa o número de clientes
         } else { // Se a leitura falhar, imprime uma mensagem de erro
-            fprintf(stderr, "Erro ao ler linha do arquivo de clientes: %s", linha);
+            reportar_erro_csv("clientes", numero_linha, &campos);
         }
     }
 
+    free(linha);
     fclose(arquivo);
+    // Devolve a capacidade que sobrou no fim do array
+    clientes = VETOR_AJUSTAR(clientes, capacidade, *num_clientes);
+    indexar_clientes(clientes, *num_clientes);
     return clientes;
 }
 
@@ -276,16 +379,23 @@ Emprestimo *carregar_emprestimos(const char *nome_arquivo, Cliente *clientes, in
 
     Emprestimo *todos_emprestimos = NULL;   // Inicializa o ponteiro para todos os empréstimos
     int num_emprestimos_total = 0;          // Inicializa o número total de empréstimos
-    char linha[256];                        // Buffer para ler cada linha do arquivo
-    fgets(linha, sizeof(linha), arquivo);   // Ler e descartar o cabeçalho
+    int capacidade = 0;                     // Espaço alocado no array de empréstimos
+    char *linha = NULL;                     // Buffer para ler cada linha do arquivo (cresce se preciso)
+    int capacidade_linha = 0;
+    long tamanho_linha;
+    int numero_linha = 1;                   // Número da linha no arquivo (para as mensagens de erro)
+    ler_linha(arquivo, &linha, &capacidade_linha); // Ler e descartar o cabeçalho
 
-    while (fgets(linha, sizeof(linha), arquivo)) { // Lê cada linha do arquivo
+    while ((tamanho_linha = ler_linha(arquivo, &linha, &capacidade_linha)) >= 0) { // Lê cada linha do arquivo
         Emprestimo novo_emprestimo; // Inicializa um novo empréstimo
+        numero_linha++;
         // Lê os dados do empréstimo da linha e armazena em novo_emprestimo
         // O formato esperado é: cliente_id,valor_emprestimo,num_parcelas
         // Exemplo: 1,1000.00,12
-        // O sscanf retorna o número de itens lidos com sucesso
-        if (sscanf(linha, "%d,%f,%d", &novo_emprestimo.cliente_id, &novo_emprestimo.valor_emprestimo, &novo_emprestimo.num_parcelas) == 3) {
+        // Os campos são lidos pelo leitor de CSV (comum/csv.c)
+        LinhaCSV campos;
+        iniciar_linha_csv(&campos, linha, linha + tamanho_linha);
+        if (analisar_linha_emprestimo(&campos, &novo_emprestimo)) {
 
             /* 
                 ATENÇÃO: A função "calcular_valor_parcela" deve ser implementada pelo aluno 
@@ -314,10 +424,11 @@ Emprestimo *carregar_emprestimos(const char *nome_arquivo, Cliente *clientes, in
                 /* 
                     ATENÇÃO: A função "realocar_memoria_emprestimo" deve ser implementada pelo aluno 
                 */
-                todos_emprestimos = realocar_memoria_emprestimo(todos_emprestimos, (num_emprestimos_total + 1));
+                todos_emprestimos = VETOR_RESERVAR(todos_emprestimos, capacidade, (num_emprestimos_total + 1));
 
                 if (!todos_emprestimos) {
                     perror("Erro ao alocar memória para todos os emprestimos");
+                    free(linha);
                     fclose(arquivo);
                     return NULL;
                 }
@@ -327,44 +438,619 @@ Emprestimo *carregar_emprestimos(const char *nome_arquivo, Cliente *clientes, in
                 fprintf(stderr, "Aviso: Cliente com ID %d não encontrado para o empréstimo.\n", novo_emprestimo.cliente_id);
             }
         } else {
-            fprintf(stderr, "Erro ao ler linha do arquivo de emprestimos: %s", linha);
+            reportar_erro_csv("emprestimos", numero_linha, &campos);
         }
     }
 
+    free(linha);
     fclose(arquivo);
+    return VETOR_AJUSTAR(todos_emprestimos, capacidade, num_emprestimos_total);
+}
+
+
+// Lê uma linha do CSV de clientes, com as regras de "%d,%[^,],%f"
+// O nome é guardado inteiro em "arena" (sem limite de tamanho)
+// Retorna 1 se os 3 campos foram lidos e 0 caso contrário (o campo com erro fica em "linha")
+int analisar_linha_cliente(LinhaCSV *linha, ArenaTextos *arena, Cliente *cliente) {
+    const char *nome;
+    size_t tamanho_nome;
+    if (!csv_ler_int(linha, &cliente->id) || !csv_separador(linha) ||
+        !csv_ler_campo(linha, &nome, &tamanho_nome)) {
+        return 0;
+    }
+    int coluna_nome = linha->coluna;
+    if (!csv_separador(linha) || !csv_ler_float(linha, &cliente->salario)) {
+        return 0;
+    }
+    // O nome só vai para a arena depois que a linha inteira foi aceita
+    if (!arena_adicionar(arena, nome, tamanho_nome, &cliente->nome)) {
+        return csv_erro_campo(linha, coluna_nome, "sem memória");
+    }
+    return 1;
+}
+
+// Lê uma linha do CSV de empréstimos, com as regras de "%d,%f,%d"
+// Retorna 1 se os 3 campos foram lidos e 0 caso contrário (o campo com erro fica em "linha")
+int analisar_linha_emprestimo(LinhaCSV *linha, Emprestimo *emprestimo) {
+    return csv_ler_int(linha, &emprestimo->cliente_id) && csv_separador(linha) &&
+           csv_ler_float(linha, &emprestimo->valor_emprestimo) && csv_separador(linha) &&
+           csv_ler_int(linha, &emprestimo->num_parcelas);
+}
+
+// Analisa as linhas de um pedaço do arquivo de clientes (executada em uma thread)
+static void analisar_pedaco_clientes(PedacoArquivo *pedaco) {
+    Cliente *clientes = NULL;
+    const char *p = pedaco->inicio;
+
+    while (p < pedaco->fim) {
+        const char *fim = csv_fim_linha(p, pedaco->fim);
+
+        Cliente novo_cliente;
+        Cliente *temp = NULL;
+        LinhaCSV campos;
+        iniciar_linha_csv(&campos, p, fim);
+        if (analisar_linha_cliente(&campos, &pedaco->textos, &novo_cliente) &&
+            (temp = VETOR_RESERVAR(clientes, pedaco->capacidade_resultados, pedaco->num_resultados + 1))) {
+            clientes = temp;
+            novo_cliente.historico_emprestimos = NULL;
+            novo_cliente.num_emprestimos = 0;
+            novo_cliente.capacidade_emprestimos = 0;
+            novo_cliente.parcelas_comprometidas = 0.0;
+            clientes[pedaco->num_resultados++] = novo_cliente;
+        } else {
+            // Sem campo com erro, a linha foi lida mas faltou memória para guardá-la
+            registrar_erro_linha(pedaco, pedaco->num_linhas, p, fim, campos.coluna_erro,
+                                 campos.coluna_erro ? campos.erro : "sem memória");
+        }
+
+        pedaco->num_linhas++;
+        p = fim < pedaco->fim ? fim + 1 : pedaco->fim;
+    }
+    pedaco->resultado = clientes;
+}
+
+// Analisa as linhas de um pedaço do arquivo de empréstimos (executada em uma thread)
+// Só a leitura e o cálculo da parcela são feitos aqui; a aprovação depende da ordem
+// do arquivo e é feita depois, em sequência
+static void analisar_pedaco_emprestimos(PedacoArquivo *pedaco) {
+    Emprestimo *emprestimos = NULL;
+    const char *p = pedaco->inicio;
+
+    while (p < pedaco->fim) {
+        const char *fim = csv_fim_linha(p, pedaco->fim);
+
+        Emprestimo novo_emprestimo;
+        Emprestimo *temp = NULL;
+        LinhaCSV campos;
+        iniciar_linha_csv(&campos, p, fim);
+        if (analisar_linha_emprestimo(&campos, &novo_emprestimo) &&
+            (temp = VETOR_RESERVAR(emprestimos, pedaco->capacidade_resultados, pedaco->num_resultados + 1))) {
+            emprestimos = temp;
+            calcular_valor_parcela(&novo_emprestimo);
+            novo_emprestimo.ativo = 1;
+            emprestimos[pedaco->num_resultados++] = novo_emprestimo;
+        } else {
+            // Sem campo com erro, a linha foi lida mas faltou memória para guardá-la
+            registrar_erro_linha(pedaco, pedaco->num_linhas, p, fim, campos.coluna_erro,
+                                 campos.coluna_erro ? campos.erro : "sem memória");
+        }
+
+        pedaco->num_linhas++;
+        p = fim < pedaco->fim ? fim + 1 : pedaco->fim;
+    }
+    pedaco->resultado = emprestimos;
+}
+
+// Mapeia o arquivo, pula o cabeçalho e analisa o restante em paralelo
+// Os erros de leitura ficam nos pedaços para o carregador reportar (reportar_erros_pedacos)
+// Retorna o número de pedaços processados ou -1 se o arquivo não pôde ser aberto
+static int processar_arquivo_paralelo(const char *nome_arquivo, ArquivoMapeado *arquivo, PedacoArquivo *pedacos,
+                                      int num_threads, FuncaoPedaco funcao) {
+    if (!mapear_arquivo(nome_arquivo, arquivo)) {
+        return -1;
+    }
+    const char *fim_arquivo = arquivo->dados + arquivo->tamanho;
+    const char *p = memchr(arquivo->dados, '\n', arquivo->tamanho);
+    p = p ? p + 1 : fim_arquivo;
+
+    int num_pedacos = dividir_em_pedacos(p, fim_arquivo, numero_threads(num_threads), pedacos);
+    processar_pedacos(pedacos, num_pedacos, funcao);
+    return num_pedacos;
+}
+
+// Carrega os clientes do arquivo CSV usando várias threads (0 = número de processadores)
+// O resultado é o mesmo de carregar_clientes, na mesma ordem do arquivo
+Cliente *carregar_clientes_paralelo(const char *nome_arquivo, int *num_clientes, int num_threads) {
+    ArquivoMapeado arquivo;
+    PedacoArquivo pedacos[MAX_THREADS];
+    *num_clientes = 0;
+
+    int num_pedacos = processar_arquivo_paralelo(nome_arquivo, &arquivo, pedacos, num_threads,
+                                                 analisar_pedaco_clientes);
+    if (num_pedacos < 0) {
+        perror("Erro ao abrir arquivo de clientes");
+        return NULL;
+    }
+    reportar_erros_pedacos(pedacos, num_pedacos, 2, "clientes");
+
+    // Junta os arrays de cada pedaço na ordem do arquivo
+    int total = 0;
+    for (int i = 0; i < num_pedacos; i++) {
+        total += pedacos[i].num_resultados;
+    }
+
+    Cliente *clientes = NULL;
+    if (total > 0) {
+        clientes = realocar_memoria_cliente(NULL, total);
+        if (!clientes) {
+            perror("Erro ao alocar memória para clientes");
+        } else {
+            // Os nomes de cada pedaço passam para a arena global e as referências são corrigidas
+            for (int i = 0; i < num_pedacos; i++) {
+                Cliente *destino = clientes + *num_clientes;
+                memcpy(destino, pedacos[i].resultado, pedacos[i].num_resultados * sizeof(Cliente));
+                if (pedacos[i].num_resultados > 0 &&
+                    !arena_transferir(&arena_nomes, &pedacos[i].textos, &destino->nome,
+                                      (size_t) pedacos[i].num_resultados, sizeof(Cliente))) {
+                    perror("Erro ao alocar memória para os nomes");
+                    free(clientes);
+                    clientes = NULL;
+                    *num_clientes = 0;
+                    break;
+                }
+                *num_clientes += pedacos[i].num_resultados;
+            }
+        }
+    }
+
+    liberar_pedacos(pedacos, num_pedacos);
+    desmapear_arquivo(&arquivo);
+    indexar_clientes(clientes, *num_clientes);
+    return clientes;
+}
+
+// Carrega os empréstimos do arquivo usando várias threads para a leitura
+// A aprovação e a inclusão no histórico seguem a ordem do arquivo, como em carregar_emprestimos,
+// e os erros de leitura e os avisos saem intercalados na mesma ordem da carga sequencial
+Emprestimo *carregar_emprestimos_paralelo(const char *nome_arquivo, Cliente *clientes, int num_clientes, int num_threads) {
+    ArquivoMapeado arquivo;
+    PedacoArquivo pedacos[MAX_THREADS];
+
+    int num_pedacos = processar_arquivo_paralelo(nome_arquivo, &arquivo, pedacos, num_threads,
+                                                 analisar_pedaco_emprestimos);
+    if (num_pedacos < 0) {
+        perror("Erro ao abrir arquivo de emprestimos");
+        return NULL;
+    }
+
+    int total = 0;
+    for (int i = 0; i < num_pedacos; i++) {
+        total += pedacos[i].num_resultados;
+    }
+
+    Emprestimo *todos_emprestimos = total > 0 ? realocar_memoria_emprestimo(NULL, total) : NULL;
+    int num_emprestimos_total = 0;
+    int num_aprovar = num_pedacos;
+    if (total > 0 && !todos_emprestimos) {
+        perror("Erro ao alocar memória para todos os emprestimos");
+        num_aprovar = 0;
+    }
+
+    // Aprova os empréstimos na ordem do arquivo (cada um vê os anteriores do mesmo cliente)
+    int base = 2;
+    for (int i = 0; i < num_pedacos; i++) {
+        Emprestimo *emprestimos = (Emprestimo*) pedacos[i].resultado;
+        int erro = 0;
+        for (int j = 0; i < num_aprovar && j < pedacos[i].num_resultados; j++) {
+            erro = reportar_erros_antes(&pedacos[i], erro, j, base, "emprestimos");
+            Emprestimo novo_emprestimo = emprestimos[j];
+            Cliente *cliente = buscar_cliente_por_id(clientes, num_clientes, novo_emprestimo.cliente_id);
+            if (cliente) {
+                aprovar_reprovar_emprestimo(cliente, &novo_emprestimo);
+                adicionar_emprestimo_historico(cliente, novo_emprestimo);
+                todos_emprestimos[num_emprestimos_total++] = novo_emprestimo;
+            } else {
+                fprintf(stderr, "Aviso: Cliente com ID %d não encontrado para o empréstimo.\n", novo_emprestimo.cliente_id);
+            }
+        }
+        reportar_erros_antes(&pedacos[i], erro, pedacos[i].num_linhas, base, "emprestimos");
+        base += pedacos[i].num_linhas;
+    }
+
+    liberar_pedacos(pedacos, num_pedacos);
+    desmapear_arquivo(&arquivo);
+    if (num_emprestimos_total == 0) {
+        free(todos_emprestimos);
+        return NULL;
+    }
     return todos_emprestimos;
 }
 
+// Carga particionada: os empréstimos são divididos entre as threads pelo hash do id do cliente
+// Cada partição é dona dos históricos (e do total de parcelas) dos seus clientes, então as
+// threads aprovam e incluem empréstimos sem travas; dentro da partição as linhas seguem a
+// ordem do arquivo, e com isso cada cliente vê os seus empréstimos na mesma ordem da carga sequencial
+
+static void incluir_no_historico(PoolHistoricos *pool, Cliente *cliente, Emprestimo emprestimo);
+
+// Dados compartilhados (só de leitura) pelas threads da carga particionada
+typedef struct {
+    const PedacoArquivo *pedacos;   // Pedaços lidos (empréstimos com a parcela calculada)
+    int num_pedacos;
+    int num_particoes;
+    Cliente *clientes;              // Cada partição só altera os clientes que são seus
+    int num_clientes;
+} ContextoParticoes;
+
+// Linhas de um pedaço agrupadas por partição (resultado da divisão)
+typedef struct {
+    const PedacoArquivo *pedaco;    // Pedaço lido a dividir
+    int *ordem;                     // Índices das linhas, partição por partição, na ordem do pedaço
+    int inicio[MAX_THREADS + 1];    // Linhas da partição p: ordem[inicio[p] .. inicio[p + 1] - 1]
+} DivisaoPedaco;
+
+// Trabalho de uma partição
+// A saída é só da partição (sem escritas intercaladas com as outras threads no mesmo array);
+// a ordem do arquivo é refeita depois com as divisões de cada pedaço
+typedef struct {
+    const DivisaoPedaco *divisoes;  // Divisão de cada pedaço
+    int particao;
+    Emprestimo *saida;              // Empréstimos da partição já aprovados, na ordem do arquivo
+    unsigned char *encontrado;      // 1 se o cliente do empréstimo existe
+    PoolHistoricos pool;            // Históricos criados pela thread (juntados ao pool_historicos no final)
+    double segundos;
+    int num_emprestimos;            // Empréstimos de clientes encontrados
+} TrabalhoParticao;
+
+static int particao_do_cliente(int cliente_id, int num_particoes) {
+    return (int) (hash_id_cliente(cliente_id) % (unsigned int) num_particoes);
+}
+
+// Divide as linhas de um pedaço entre as partições (counting sort estável pela partição)
+// "tarefa->contexto" é o ContextoParticoes e "tarefa->resultado" a DivisaoPedaco
+static void dividir_pedaco_emprestimos(PedacoArquivo *tarefa) {
+    const ContextoParticoes *contexto = (const ContextoParticoes*) tarefa->contexto;
+    DivisaoPedaco *divisao = (DivisaoPedaco*) tarefa->resultado;
+    const PedacoArquivo *pedaco = divisao->pedaco;
+    const Emprestimo *emprestimos = (const Emprestimo*) pedaco->resultado;
+    int n = pedaco->num_resultados;
+
+    memset(divisao->inicio, 0, sizeof(divisao->inicio));
+    divisao->ordem = (int*) malloc(((size_t) n + 1) * sizeof(int));
+    if (!divisao->ordem) {
+        return;
+    }
+    for (int j = 0; j < n; j++) {
+        divisao->inicio[particao_do_cliente(emprestimos[j].cliente_id, contexto->num_particoes) + 1]++;
+    }
+    for (int p = 0; p < contexto->num_particoes; p++) {
+        divisao->inicio[p + 1] += divisao->inicio[p];
+    }
+    int proximo[MAX_THREADS];
+    memcpy(proximo, divisao->inicio, sizeof(proximo));
+    for (int j = 0; j < n; j++) {
+        divisao->ordem[proximo[particao_do_cliente(emprestimos[j].cliente_id, contexto->num_particoes)]++] = j;
+    }
+}
+
+// Aprova e inclui nos históricos os empréstimos de uma partição, pedaço por pedaço
+// "tarefa->contexto" é o ContextoParticoes e "tarefa->resultado" o TrabalhoParticao
+static void processar_particao_emprestimos(PedacoArquivo *tarefa) {
+    const ContextoParticoes *contexto = (const ContextoParticoes*) tarefa->contexto;
+    TrabalhoParticao *trabalho = (TrabalhoParticao*) tarefa->resultado;
+    const DivisaoPedaco *divisoes = trabalho->divisoes;
+    int p = trabalho->particao;
+    double inicio = tempo_atual();
+
+    int total = 0;
+    for (int i = 0; i < contexto->num_pedacos; i++) {
+        total += divisoes[i].inicio[p + 1] - divisoes[i].inicio[p];
+    }
+    trabalho->saida = (Emprestimo*) malloc(((size_t) total + 1) * sizeof(Emprestimo));
+    trabalho->encontrado = (unsigned char*) malloc((size_t) total + 1);
+    if (!trabalho->saida || !trabalho->encontrado) {
+        return;
+    }
+
+    int n = 0;
+    for (int i = 0; i < contexto->num_pedacos; i++) {
+        const Emprestimo *emprestimos = (const Emprestimo*) contexto->pedacos[i].resultado;
+        for (int k = divisoes[i].inicio[p]; k < divisoes[i].inicio[p + 1]; k++, n++) {
+            Emprestimo novo_emprestimo = emprestimos[divisoes[i].ordem[k]];
+            Cliente *cliente = buscar_cliente_por_id(contexto->clientes, contexto->num_clientes, novo_emprestimo.cliente_id);
+            trabalho->encontrado[n] = cliente != NULL;
+            if (cliente) {
+                aprovar_reprovar_emprestimo(cliente, &novo_emprestimo);
+                incluir_no_historico(&trabalho->pool, cliente, novo_emprestimo);
+                trabalho->num_emprestimos++;
+            }
+            trabalho->saida[n] = novo_emprestimo;
+        }
+    }
+    trabalho->segundos = tempo_atual() - inicio;
+}
+
+// Carrega os empréstimos com a leitura em paralelo e a aprovação particionada por cliente
+// (num_threads threads, 0 = número de processadores); o resultado é o mesmo de carregar_emprestimos
+// Se "estatisticas" não for NULL, recebe o tempo de cada fase e de cada partição
+Emprestimo *carregar_emprestimos_particionado(const char *nome_arquivo, Cliente *clientes, int num_clientes, int num_threads,
+                                              EstatisticasParticoes *estatisticas) {
+    ArquivoMapeado arquivo;
+    PedacoArquivo pedacos[MAX_THREADS];
+    PedacoArquivo tarefas[MAX_THREADS];
+    DivisaoPedaco divisoes[MAX_THREADS];
+    TrabalhoParticao trabalhos[MAX_THREADS];
+    EstatisticasParticoes local;
+    if (!estatisticas) {
+        estatisticas = &local;
+    }
+    memset(estatisticas, 0, sizeof(EstatisticasParticoes));
+
+    double t0 = tempo_atual();
+    int num_pedacos = processar_arquivo_paralelo(nome_arquivo, &arquivo, pedacos, num_threads,
+                                                 analisar_pedaco_emprestimos);
+    if (num_pedacos < 0) {
+        perror("Erro ao abrir arquivo de emprestimos");
+        return NULL;
+    }
+    double t1 = tempo_atual();
+
+    int total = 0;
+    for (int i = 0; i < num_pedacos; i++) {
+        total += pedacos[i].num_resultados;
+    }
+
+    ContextoParticoes contexto;
+    contexto.pedacos = pedacos;
+    contexto.num_pedacos = num_pedacos;
+    contexto.num_particoes = numero_threads(num_threads);
+    contexto.clientes = clientes;
+    contexto.num_clientes = num_clientes;
+
+    // Divide cada pedaço entre as partições (uma thread por pedaço)
+    for (int i = 0; i < num_pedacos; i++) {
+        memset(&tarefas[i], 0, sizeof(PedacoArquivo));
+        divisoes[i].pedaco = &pedacos[i];
+        divisoes[i].ordem = NULL;
+        tarefas[i].contexto = &contexto;
+        tarefas[i].resultado = &divisoes[i];
+    }
+    processar_pedacos(tarefas, num_pedacos, dividir_pedaco_emprestimos);
+    int ok = 1;
+    for (int i = 0; i < num_pedacos; i++) {
+        ok = ok && (divisoes[i].ordem != NULL);
+    }
+    double t2 = tempo_atual();
+
+    // Aprova cada partição em uma thread
+    for (int p = 0; p < contexto.num_particoes; p++) {
+        memset(&tarefas[p], 0, sizeof(PedacoArquivo));
+        memset(&trabalhos[p], 0, sizeof(TrabalhoParticao));
+        trabalhos[p].divisoes = divisoes;
+        trabalhos[p].particao = p;
+        trabalhos[p].pool.ativo = pool_historicos.ativo;
+        tarefas[p].contexto = &contexto;
+        tarefas[p].resultado = &trabalhos[p];
+    }
+    if (ok) {
+        processar_pedacos(tarefas, contexto.num_particoes, processar_particao_emprestimos);
+        for (int p = 0; p < contexto.num_particoes; p++) {
+            ok = ok && trabalhos[p].saida && trabalhos[p].encontrado;
+            juntar_pool_historicos(&pool_historicos, &trabalhos[p].pool);
+        }
+    }
+    double t3 = tempo_atual();
+
+    // Junta as saídas das partições na ordem do arquivo: dentro de cada pedaço, a linha j
+    // é a próxima da sua partição. Os erros de leitura e os avisos dos clientes não
+    // encontrados saem nessa ordem, intercalados como na carga sequencial
+    Emprestimo *todos_emprestimos = ok && total > 0 ? realocar_memoria_emprestimo(NULL, total) : NULL;
+    int num_emprestimos_total = 0;
+    if (todos_emprestimos) {
+        int proximo[MAX_THREADS] = {0};
+        int base = 2;
+        for (int i = 0; i < num_pedacos; i++) {
+            const Emprestimo *emprestimos = (const Emprestimo*) pedacos[i].resultado;
+            int erro = 0;
+            for (int j = 0; j < pedacos[i].num_resultados; j++) {
+                erro = reportar_erros_antes(&pedacos[i], erro, j, base, "emprestimos");
+                TrabalhoParticao *trabalho = &trabalhos[particao_do_cliente(emprestimos[j].cliente_id, contexto.num_particoes)];
+                int k = proximo[trabalho->particao]++;
+                if (trabalho->encontrado[k]) {
+                    todos_emprestimos[num_emprestimos_total++] = trabalho->saida[k];
+                } else {
+                    fprintf(stderr, "Aviso: Cliente com ID %d não encontrado para o empréstimo.\n", emprestimos[j].cliente_id);
+                }
+            }
+            reportar_erros_antes(&pedacos[i], erro, pedacos[i].num_linhas, base, "emprestimos");
+            base += pedacos[i].num_linhas;
+        }
+    } else {
+        if (total > 0) {
+            perror("Erro ao alocar memória para todos os emprestimos");
+        }
+        reportar_erros_pedacos(pedacos, num_pedacos, 2, "emprestimos");
+    }
+
+    estatisticas->num_pedacos = num_pedacos;
+    estatisticas->num_particoes = contexto.num_particoes;
+    estatisticas->segundos_leitura = t1 - t0;
+    estatisticas->segundos_divisao = t2 - t1;
+    estatisticas->segundos_aprovacao = t3 - t2;
+    for (int p = 0; p < estatisticas->num_particoes; p++) {
+        estatisticas->segundos_particao[p] = trabalhos[p].segundos;
+        estatisticas->emprestimos_particao[p] = trabalhos[p].num_emprestimos;
+    }
+
+    for (int i = 0; i < num_pedacos; i++) {
+        free(divisoes[i].ordem);
+    }
+    for (int p = 0; p < contexto.num_particoes; p++) {
+        free(trabalhos[p].saida);
+        free(trabalhos[p].encontrado);
+    }
+    liberar_pedacos(pedacos, num_pedacos);
+    desmapear_arquivo(&arquivo);
+    if (num_emprestimos_total == 0) {
+        free(todos_emprestimos);
+        return NULL;
+    }
+    return VETOR_AJUSTAR(todos_emprestimos, total, num_emprestimos_total);
+}
+
+// Imprime o tempo de cada fase e de cada partição da carga particionada
+// O desequilíbrio é o tempo da partição mais lenta dividido pela média
+void imprimir_estatisticas_particoes(FILE *saida, const EstatisticasParticoes *estatisticas) {
+    fprintf(saida, "Carga particionada: leitura %.1f ms (%d pedaços), divisão %.1f ms, aprovação %.1f ms (%d partições)\n",
+            estatisticas->segundos_leitura * 1e3, estatisticas->num_pedacos, estatisticas->segundos_divisao * 1e3,
+            estatisticas->segundos_aprovacao * 1e3, estatisticas->num_particoes);
+    double soma = 0.0, maior = 0.0;
+    for (int p = 0; p < estatisticas->num_particoes; p++) {
+        fprintf(saida, "  Partição %2d: %10d empréstimos, %8.1f ms\n", p,
+                estatisticas->emprestimos_particao[p], estatisticas->segundos_particao[p] * 1e3);
+        soma += estatisticas->segundos_particao[p];
+        if (estatisticas->segundos_particao[p] > maior) {
+            maior = estatisticas->segundos_particao[p];
+        }
+    }
+    if (estatisticas->num_particoes > 0 && soma > 0) {
+        fprintf(saida, "  Desequilíbrio (mais lenta / média): %.2f\n", maior / (soma / estatisticas->num_particoes));
+    }
+}
 
 // Adiciona um novo empréstimo ao histórico do cliente
 void adicionar_emprestimo_historico(Cliente *cliente, Emprestimo emprestimo) {
+    incluir_no_historico(&pool_historicos, cliente, emprestimo);
+}
 
-    /* 
-        ATENÇÃO: A função "realocar_memoria_emprestimo" deve ser implementada pelo aluno
-    */
-    cliente->historico_emprestimos = realocar_memoria_emprestimo(cliente->historico_emprestimos, cliente->num_emprestimos + 1);
+// Monta o registro do histórico de um empréstimo (o id fica de fora: é o do cliente)
+RegistroHistorico registro_do_emprestimo(Emprestimo emprestimo) {
+    RegistroHistorico registro;
+    memset(&registro, 0, sizeof(RegistroHistorico));
+    registro.valor_emprestimo = emprestimo.valor_emprestimo;
+    registro.num_parcelas = emprestimo.num_parcelas;
+    registro.valor_parcela = emprestimo.valor_parcela;
+    registro.aprovacao = emprestimo.aprovacao;
+    registro.ativo = emprestimo.ativo;
+    return registro;
+}
+
+// Adiciona o empréstimo ao histórico, com a memória do histórico vinda de "pool"
+// (o pool_historicos, ou o de uma thread da carga particionada)
+static void incluir_no_historico(PoolHistoricos *pool, Cliente *cliente, Emprestimo emprestimo) {
+
+    // Garante espaço para mais um empréstimo (a capacidade cresce dobrando)
+    RegistroHistorico *temp = reservar_historico(pool, cliente, cliente->num_emprestimos + 1);
 
     // Verifica se a realocação foi bem-sucedida
-    if (!cliente->historico_emprestimos) { // Se a realocação falhar, imprime uma mensagem de erro
+    if (!temp) { // Se a realocação falhar, o histórico antigo continua válido
         perror("Erro ao alocar memória para histórico de empréstimos");
-        if (!cliente->historico_emprestimos) { // Se o histórico de empréstimos for NULL
-            // Tenta alocar memória para o primeiro empréstimo
-            perror("Erro ao alocar memória para histórico de empréstimos");
-            if (cliente->num_emprestimos == 0) { // Se não houver empréstimos
-                // Aloca memória para o primeiro empréstimo
-                cliente->historico_emprestimos = malloc(sizeof(Emprestimo));
-                if (!cliente->historico_emprestimos) {
-                    perror("Erro crítico ao alocar memória para o primeiro empréstimo");
-                    return;
-                }
-            } else {
-                return; // Já existe memória alocada, erro ao realocar
-            } 
-        }       
+        return;
     }
+
     // Adiciona o novo empréstimo ao histórico
-    cliente->historico_emprestimos[cliente->num_emprestimos] = emprestimo;
+    cliente->historico_emprestimos[cliente->num_emprestimos] = registro_do_emprestimo(emprestimo);
     cliente->num_emprestimos++;
+    if (emprestimo.ativo && emprestimo.aprovacao) {
+        cliente->parcelas_comprometidas += emprestimo.valor_parcela;
+    }
+}
+
+// Soma as parcelas dos empréstimos ativos e aprovados do histórico, na ordem do histórico
+// É a mesma conta que os acréscimos de adicionar_emprestimo_historico fazem, então o total
+// guardado no cliente tem que ser exatamente igual a ela
+static float somar_parcelas_comprometidas(const Cliente *cliente) {
+    float soma = 0.0;
+    for (int j = 0; j < cliente->num_emprestimos; j++) {
+        if (cliente->historico_emprestimos[j].ativo && cliente->historico_emprestimos[j].aprovacao) {
+            soma += cliente->historico_emprestimos[j].valor_parcela;
+        }
+    }
+    return soma;
+}
+
+// Muda a aprovação e o estado (ativo) de um empréstimo do histórico
+// As mudanças devem passar por aqui para manter parcelas_comprometidas em dia
+// Quando o empréstimo passa a contar ou deixa de contar, o total é somado de novo pelo
+// histórico (O(empréstimos do cliente)): subtrair a parcela daria um float diferente da
+// soma sem ela. Os acréscimos, que são o caso comum, continuam O(1)
+void alterar_estado_emprestimo(Cliente *cliente, int posicao, int aprovacao, int ativo) {
+    RegistroHistorico *emprestimo = &cliente->historico_emprestimos[posicao];
+    int contava = emprestimo->ativo && emprestimo->aprovacao;
+    int conta = ativo && aprovacao;
+    emprestimo->aprovacao = aprovacao != 0;
+    emprestimo->ativo = ativo != 0;
+    if (contava != conta) {
+        cliente->parcelas_comprometidas = somar_parcelas_comprometidas(cliente);
+    }
+}
+
+// Desativa (quita) um empréstimo do histórico de um cliente, que deixa de contar nas parcelas comprometidas
+void desativar_emprestimo(Cliente *clientes, int num_clientes) {
+    int cliente_id;
+    int numero;
+    
+    printf("\n--- Desativacao de Emprestimo ---\n");
+    printf("ID do Cliente: ");
+    if (scanf("%d", &cliente_id) != 1) {
+        msg_erro("Erro: ID invalido.\n");
+        limpar_buffer();
+        return;
+    }
+    limpar_buffer();
+    
+    Cliente *cliente = buscar_cliente_por_id(clientes, num_clientes, cliente_id);
+    if (!cliente) {
+        msg_erro("Erro: Cliente nao encontrado.\n");
+        return;
+    }
+    if (cliente->num_emprestimos == 0) {
+        msg_erro("Erro: Cliente sem emprestimos.\n");
+        return;
+    }
+    
+    printf("Numero do Emprestimo (1 a %d): ", cliente->num_emprestimos);
+    if (scanf("%d", &numero) != 1 || numero < 1 || numero > cliente->num_emprestimos) {
+        msg_erro("Erro: Numero de emprestimo invalido.\n");
+        limpar_buffer();
+        return;
+    }
+    limpar_buffer();
+    
+    RegistroHistorico *emprestimo = &cliente->historico_emprestimos[numero - 1];
+    if (!emprestimo->ativo) {
+        msg_erro("Erro: Emprestimo ja esta inativo.\n");
+        return;
+    }
+    
+    // Com --dados, a mudança vai para o diário antes de ser aplicada
+    if (!registrar_estado_emprestimo(&diario_mutacoes, cliente->id, numero - 1, emprestimo->aprovacao, 0)) {
+        msg_erro("Erro: Falha ao gravar a desativacao no diario.\n");
+        return;
+    }
+    alterar_estado_emprestimo(cliente, numero - 1, emprestimo->aprovacao, 0);
+    
+    printf("\nEmprestimo desativado.\n");
+    printf("Parcelas comprometidas: R$ %.2f\n", cliente->parcelas_comprometidas);
+    
+    printf("\nPressione ENTER para continuar...");
+    getchar();
+}
+
+// Confere o total guardado em cada cliente contra a soma das parcelas do histórico
+// Retorna o número de clientes com diferença (cada um é impresso em stderr)
+// A comparação é exata: o total é sempre a mesma soma, na mesma ordem (ver alterar_estado_emprestimo)
+int verificar_parcelas_comprometidas(const Cliente *clientes, int num_clientes) {
+    int divergentes = 0;
+    for (int i = 0; i < num_clientes; i++) {
+        float soma = somar_parcelas_comprometidas(&clientes[i]);
+        if (soma != clientes[i].parcelas_comprometidas) {
+            fprintf(stderr, "Cliente %d: parcelas comprometidas %.2f, soma do histórico %.2f\n",
+                    clientes[i].id, clientes[i].parcelas_comprometidas, soma);
+            divergentes++;
+        }
+    }
+    return divergentes;
 }
 
 // Lista todos os clientes e seus empréstimos
@@ -374,12 +1060,12 @@ void listar_clientes(const Cliente *clientes, int num_clientes) {
     for (int i = 0; i < num_clientes; i++) { 
 
         printf("ID: %d, Nome: %s, Salario: %.2f, Emprestimos: %d\n",
-               clientes[i].id, clientes[i].nome, clientes[i].salario, clientes[i].num_emprestimos);
+               clientes[i].id, nome_cliente(&clientes[i]), clientes[i].salario, clientes[i].num_emprestimos);
         if (clientes[i].historico_emprestimos && clientes[i].num_emprestimos > 0) {
             printf("  Historico de Emprestimos:\n");
             for (int j = 0; j < clientes[i].num_emprestimos; j++) {
                 printf("    ID Cliente: %d, Valor: %.2f, Parcelas: %d, Parcela: %.2f, Status: ",
-                       clientes[i].historico_emprestimos[j].cliente_id,
+                       clientes[i].id,
                        clientes[i].historico_emprestimos[j].valor_emprestimo,
                        clientes[i].historico_emprestimos[j].num_parcelas,
                        clientes[i].historico_emprestimos[j].valor_parcela);
@@ -409,7 +1095,7 @@ void listar_emprestimos(const Cliente *clientes, int num_clientes) {
         if (clientes[i].historico_emprestimos) {
             for (int j = 0; j < clientes[i].num_emprestimos; j++) {
                 printf("Cliente ID: %d, Valor: %.2f, Parcelas: %d, Parcela: %.2f, Status: ",
-                       clientes[i].historico_emprestimos[j].cliente_id,
+                       clientes[i].id,
                        clientes[i].historico_emprestimos[j].valor_emprestimo,
                        clientes[i].historico_emprestimos[j].num_parcelas,
                        clientes[i].historico_emprestimos[j].valor_parcela);
@@ -428,7 +1114,12 @@ void listar_emprestimos(const Cliente *clientes, int num_clientes) {
 }
 
 // Busca um cliente pelo ID
+// Usa o índice_clientes quando ele foi criado para este array; senão percorre o array
 Cliente *buscar_cliente_por_id(Cliente *clientes, int num_clientes, int id) {
+    if (indice_clientes_valido(&indice_clientes, clientes, num_clientes)) {
+        int posicao = indice_clientes_buscar(&indice_clientes, id);
+        return posicao >= 0 ? &clientes[posicao] : NULL;
+    }
     for (int i = 0; i < num_clientes; i++) {
         if (clientes[i].id == id) {
             return &clientes[i];
@@ -437,11 +1128,24 @@ Cliente *buscar_cliente_por_id(Cliente *clientes, int num_clientes, int id) {
     return NULL;
 }
 
+// Nome do cliente (guardado na arena_nomes); o ponteiro vale até o próximo nome inserido
+const char *nome_cliente(const Cliente *cliente) {
+    return texto_arena(&arena_nomes, cliente->nome);
+}
+
 // Libera a memória alocada para os clientes e seus históricos de empréstimos
 void liberar_memoria(Cliente *clientes, int num_clientes) {
+    if (indice_clientes_valido(&indice_clientes, clientes, num_clientes)) {
+        liberar_indice_clientes(&indice_clientes);
+    }
     if (clientes) {
-        for (int i = 0; i < num_clientes; i++) {
-            free(clientes[i].historico_emprestimos);
+        // Com o pool, os históricos de todos os clientes são liberados de uma vez
+        if (pool_historicos.ativo) {
+            liberar_pool_historicos(&pool_historicos);
+        } else {
+            for (int i = 0; i < num_clientes; i++) {
+                free(clientes[i].historico_emprestimos);
+            }
         }
         free(clientes);
     }
@@ -4,6 +4,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+
+#include "../comum/mapeamento.h"
+#include "../comum/binario.h"
+#include "../comum/vetor.h"
+#include "../comum/paralelo.h"
+#include "../comum/csv.h"
+#include "../comum/arena.h"
+#include "../comum/tempo.h"
 
 #ifdef _WIN32
     #define LIMPAR_TELA "cls"
@@ -11,29 +20,55 @@
     #define LIMPAR_TELA "clear"
 #endif
 
+#define TAXA_JUROS 0.05
+#define LIMITE_PARCELA 0.20
+
 // Definição de cores ANSI (suportado em alguns terminais)
 #define COR_VERMELHO "\033[31m"
 #define COR_RESET "\033[0m"
 
-#define MAX_NOME 50
-
 typedef struct Emprestimo {
     int cliente_id;
     float valor_emprestimo;
     int num_parcelas;
     float valor_parcela;
-    int aprovacao;          // 1 para "Aprovado". 0 para "Reprovado"
-    int ativo;              // 1 para "Ativo", 0 para "Inativo"
+    unsigned char aprovacao : 1;    // 1 para "Aprovado". 0 para "Reprovado"
+    unsigned char ativo : 1;        // 1 para "Ativo", 0 para "Inativo"
 } Emprestimo;
 
+// Empréstimo guardado no histórico de um cliente: sem o id (é o do próprio cliente) e
+// com a aprovação e o estado em bits, sem alinhamento: 13 bytes por empréstimo
+// Os registros são montados só por registro_do_emprestimo (os bits que sobram ficam em 0)
+typedef struct __attribute__((packed)) RegistroHistorico {
+    float valor_emprestimo;
+    int num_parcelas;
+    float valor_parcela;
+    unsigned char aprovacao : 1;    // 1 para "Aprovado". 0 para "Reprovado"
+    unsigned char ativo : 1;        // 1 para "Ativo", 0 para "Inativo"
+} RegistroHistorico;
+
 typedef struct Cliente {
     int id;
-    char nome[MAX_NOME];
+    RefTexto nome;          // Nome do cliente na arena_nomes (ver nome_cliente)
     float salario;
-    Emprestimo *historico_emprestimos;
+    RegistroHistorico *historico_emprestimos;
     int num_emprestimos;
+    int capacidade_emprestimos; // Espaço alocado no histórico de empréstimos
+    float parcelas_comprometidas; // Soma das parcelas dos empréstimos ativos e aprovados do histórico
+                                  // (mantida a cada inclusão ou mudança de estado; ver verificar_parcelas_comprometidas)
 } Cliente;
 
+// Tempos e tamanhos de cada partição de carregar_emprestimos_particionado (para ver o desequilíbrio)
+typedef struct {
+    int num_pedacos;                            // Pedaços do arquivo lidos em paralelo
+    int num_particoes;                          // Partições (uma thread cada)
+    double segundos_leitura;                    // Leitura dos pedaços e cálculo das parcelas
+    double segundos_divisao;                    // Divisão das linhas de cada pedaço entre as partições
+    double segundos_aprovacao;                  // Todas as partições (a mais lenta define o tempo)
+    double segundos_particao[MAX_THREADS];      // Aprovação e históricos de cada partição
+    int emprestimos_particao[MAX_THREADS];      // Empréstimos de clientes encontrados em cada partição
+} EstatisticasParticoes;
+
 // Protótipos das funções em utils.c
 
 // Funções já implementadas
@@ -42,10 +77,26 @@ void msg_erro(char *msg);
 Cliente *carregar_clientes(const char *nome_arquivo, int *num_clientes);
 Emprestimo *carregar_emprestimos(const char *nome_arquivo, Cliente *clientes, int num_clientes);
 void adicionar_emprestimo_historico(Cliente *cliente, Emprestimo emprestimo);
+RegistroHistorico registro_do_emprestimo(Emprestimo emprestimo);
 void listar_clientes(const Cliente *clientes, int num_clientes);
 void listar_emprestimos(const Cliente *clientes, int num_clientes);
 Cliente *buscar_cliente_por_id(Cliente *clientes, int num_clientes, int id);
 void liberar_memoria(Cliente *clientes, int num_clientes);
+const char *nome_cliente(const Cliente *cliente);
+void alterar_estado_emprestimo(Cliente *cliente, int posicao, int aprovacao, int ativo);
+int verificar_parcelas_comprometidas(const Cliente *clientes, int num_clientes);
+void indexar_clientes(const Cliente *clientes, int num_clientes);
+Cliente *reservar_cliente(Cliente *clientes, int num_clientes, int *capacidade_clientes);
+Cliente *incluir_cliente(Cliente *clientes, int *num_clientes, int *capacidade_clientes, Cliente novo_cliente);
+
+// Carregamento em paralelo (várias threads, arquivo dividido nas quebras de linha)
+int analisar_linha_cliente(LinhaCSV *linha, ArenaTextos *arena, Cliente *cliente);
+int analisar_linha_emprestimo(LinhaCSV *linha, Emprestimo *emprestimo);
+Cliente *carregar_clientes_paralelo(const char *nome_arquivo, int *num_clientes, int num_threads);
+Emprestimo *carregar_emprestimos_paralelo(const char *nome_arquivo, Cliente *clientes, int num_clientes, int num_threads);
+Emprestimo *carregar_emprestimos_particionado(const char *nome_arquivo, Cliente *clientes, int num_clientes, int num_threads,
+                                              EstatisticasParticoes *estatisticas);
+void imprimir_estatisticas_particoes(FILE *saida, const EstatisticasParticoes *estatisticas);
 
 
 // ATENÇÃO: As funções abaixo devem ser implementadas pelo aluno
@@ -61,8 +112,9 @@ Emprestimo* realocar_memoria_emprestimo(Emprestimo *emprestimos, int novo_tamanh
     ATENÇÃO: As funções "cadastrar_novo_cliente" e "solicitar_novo_emprestimo" devem ser implementadas pelo aluno
     Essas funções devem permitir o cadastro de novos clientes e a solicitação de novos empréstimos, respectivamente.
 */
-Cliente *cadastrar_novo_cliente(Cliente *clientes, int *num_clientes);
+Cliente *cadastrar_novo_cliente(Cliente *clientes, int *num_clientes, int *capacidade_clientes);
 void solicitar_novo_emprestimo(Cliente *clientes, int num_clientes);
+void desativar_emprestimo(Cliente *clientes, int num_clientes);
 
 /* 
     ATENÇÃO: A função "calcular_valor_parcela" e "aprovar_reprovar_emprestimo" devem ser implementadas pelo aluno
@@ -0,0 +1,216 @@
+#include "arena.h"
+
+ArenaTextos arena_nomes;
+
+void iniciar_arena(ArenaTextos *arena, int internar) {
+    arena->dados = NULL;
+    arena->tamanho = 0;
+    arena->capacidade = 0;
+    arena->internar = internar;
+    arena->tabela = NULL;
+    arena->capacidade_tabela = 0;
+    arena->num_entradas = 0;
+    arena->repetidos = 0;
+}
+
+// Libera o buffer e a tabela (a arena continua utilizável, vazia)
+void liberar_arena(ArenaTextos *arena) {
+    free(arena->dados);
+    free(arena->tabela);
+    iniciar_arena(arena, arena->internar);
+}
+
+// Hash FNV-1a do texto
+static uint32_t hash_texto(const char *texto, size_t tamanho) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < tamanho; i++) {
+        h ^= (unsigned char) texto[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Garante espaço para mais "extra" bytes no buffer (a capacidade dobra)
+static int reservar_arena(ArenaTextos *arena, size_t extra) {
+    if (extra > ARENA_LIMITE - arena->tamanho) {
+        return 0;
+    }
+    size_t necessario = arena->tamanho + extra;
+    if (necessario <= arena->capacidade) {
+        return 1;
+    }
+    size_t nova = arena->capacidade > 0 ? arena->capacidade : ARENA_CAPACIDADE_INICIAL;
+    while (nova < necessario) {
+        nova *= 2;
+    }
+    char *temp = (char*) realloc(arena->dados, nova);
+    if (!temp) {
+        return 0;
+    }
+    arena->dados = temp;
+    arena->capacidade = nova;
+    return 1;
+}
+
+// Procura o texto na tabela; retorna a posição da entrada igual ou da primeira livre
+static size_t procurar_texto(const ArenaTextos *arena, const char *texto, size_t tamanho, uint32_t hash) {
+    size_t mascara = arena->capacidade_tabela - 1;
+    size_t i = hash & mascara;
+    while (arena->tabela[i].ocupada) {
+        const EntradaArena *e = &arena->tabela[i];
+        if (e->hash == hash && e->tamanho == tamanho &&
+            memcmp(arena->dados + e->deslocamento, texto, tamanho) == 0) {
+            return i;
+        }
+        i = (i + 1) & mascara;
+    }
+    return i;
+}
+
+// Dobra a tabela (carga máxima de 1/2) e reinsere as entradas
+static int crescer_tabela_textos(ArenaTextos *arena) {
+    size_t nova = arena->capacidade_tabela > 0 ? arena->capacidade_tabela * 2 : 1024;
+    EntradaArena *tabela = (EntradaArena*) calloc(nova, sizeof(EntradaArena));
+    if (!tabela) {
+        return 0;
+    }
+    for (size_t i = 0; i < arena->capacidade_tabela; i++) {
+        if (arena->tabela[i].ocupada) {
+            size_t j = arena->tabela[i].hash & (nova - 1);
+            while (tabela[j].ocupada) {
+                j = (j + 1) & (nova - 1);
+            }
+            tabela[j] = arena->tabela[i];
+        }
+    }
+    free(arena->tabela);
+    arena->tabela = tabela;
+    arena->capacidade_tabela = nova;
+    return 1;
+}
+
+// Guarda "tamanho" bytes de "texto" (mais um '\0') e preenche "ref"
+// Com a arena internando, um texto igual já guardado é reaproveitado
+// Retorna 1 em caso de sucesso e 0 se faltar memória ou a arena passar de 4 GB
+int arena_adicionar(ArenaTextos *arena, const char *texto, size_t tamanho, RefTexto *ref) {
+    uint32_t hash = 0;
+    size_t posicao = 0;
+    if (arena->internar) {
+        if ((arena->num_entradas + 1) * 2 > arena->capacidade_tabela && !crescer_tabela_textos(arena)) {
+            return 0;
+        }
+        hash = hash_texto(texto, tamanho);
+        posicao = procurar_texto(arena, texto, tamanho, hash);
+        if (arena->tabela[posicao].ocupada) {
+            ref->deslocamento = arena->tabela[posicao].deslocamento;
+            ref->tamanho = arena->tabela[posicao].tamanho;
+            arena->repetidos++;
+            return 1;
+        }
+    }
+
+    if (!reservar_arena(arena, tamanho + 1)) {
+        return 0;
+    }
+    ref->deslocamento = (uint32_t) arena->tamanho;
+    ref->tamanho = (uint32_t) tamanho;
+    memcpy(arena->dados + arena->tamanho, texto, tamanho);
+    arena->dados[arena->tamanho + tamanho] = '\0';
+    arena->tamanho += tamanho + 1;
+
+    if (arena->internar) {
+        EntradaArena *e = &arena->tabela[posicao];
+        e->hash = hash;
+        e->deslocamento = ref->deslocamento;
+        e->tamanho = ref->tamanho;
+        e->ocupada = 1;
+        arena->num_entradas++;
+    }
+    return 1;
+}
+
+// Texto terminado em '\0' de uma referência (válido até a próxima inserção)
+const char *texto_arena(const ArenaTextos *arena, RefTexto ref) {
+    return arena->dados ? arena->dados + ref.deslocamento : "";
+}
+
+// Posição atual do fim da arena, para descartar depois o que for inserido a partir daqui
+size_t arena_marca(const ArenaTextos *arena) {
+    return arena->tamanho;
+}
+
+// Tira a entrada i da tabela, puxando as seguintes do mesmo grupo (sem lápides)
+static void remover_texto(ArenaTextos *arena, size_t i) {
+    size_t mascara = arena->capacidade_tabela - 1;
+    size_t j = i;
+    while (1) {
+        arena->tabela[i].ocupada = 0;
+        while (1) {
+            j = (j + 1) & mascara;
+            if (!arena->tabela[j].ocupada) {
+                arena->num_entradas--;
+                return;
+            }
+            // A entrada j pode ir para i se a sua posição ideal não está entre i e j
+            size_t ideal = arena->tabela[j].hash & mascara;
+            if (i <= j ? (ideal <= i || ideal > j) : (ideal <= i && ideal > j)) {
+                break;
+            }
+        }
+        arena->tabela[i] = arena->tabela[j];
+        i = j;
+    }
+}
+
+// Descarta todos os textos inseridos depois de "marca" (e as suas entradas na tabela)
+// Usado para reaproveitar a arena em processamentos por bloco ou por linha
+void arena_descartar(ArenaTextos *arena, size_t marca) {
+    if (marca >= arena->tamanho) {
+        return;
+    }
+    if (arena->internar && arena->num_entradas > 0) {
+        size_t p = marca;
+        while (p < arena->tamanho) {
+            size_t tamanho = strlen(arena->dados + p);
+            uint32_t hash = hash_texto(arena->dados + p, tamanho);
+            size_t i = procurar_texto(arena, arena->dados + p, tamanho, hash);
+            if (arena->tabela[i].ocupada && arena->tabela[i].deslocamento == p) {
+                remover_texto(arena, i);
+            }
+            p += tamanho + 1;
+        }
+    }
+    arena->tamanho = marca;
+}
+
+// Passa para "destino" os textos de "origem" referenciados por "refs" e corrige as referências
+// "refs" aponta para o primeiro RefTexto e "passo" é a distância em bytes entre eles
+// (ex.: &alunos[0].nome com passo sizeof(Aluno)), para corrigir um array de registros no lugar
+// Sem internar, o buffer de origem é copiado de uma vez; internando, texto por texto
+// Retorna 1 em caso de sucesso e 0 se faltar memória
+int arena_transferir(ArenaTextos *destino, const ArenaTextos *origem, RefTexto *refs, size_t num_refs, size_t passo) {
+    if (!destino->internar) {
+        if (origem->tamanho == 0) {
+            return 1;
+        }
+        if (!reservar_arena(destino, origem->tamanho)) {
+            return 0;
+        }
+        uint32_t base = (uint32_t) destino->tamanho;
+        memcpy(destino->dados + destino->tamanho, origem->dados, origem->tamanho);
+        destino->tamanho += origem->tamanho;
+        for (size_t i = 0; i < num_refs; i++) {
+            RefTexto *ref = (RefTexto*) ((char*) refs + i * passo);
+            ref->deslocamento += base;
+        }
+        return 1;
+    }
+
+    for (size_t i = 0; i < num_refs; i++) {
+        RefTexto *ref = (RefTexto*) ((char*) refs + i * passo);
+        if (!arena_adicionar(destino, texto_arena(origem, *ref), ref->tamanho, ref)) {
+            return 0;
+        }
+    }
+    return 1;
+}
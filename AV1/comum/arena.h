@@ -0,0 +1,59 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Arena de textos: os nomes ficam um depois do outro em um único buffer, cada um
+// terminado em '\0', e os registros guardam só a posição e o tamanho (RefTexto, 8 bytes)
+// Assim ordenar ou realocar um array de registros não copia os nomes, e não há
+// limite de tamanho para um nome (só o total da arena, até 4 GB)
+//
+// Com "internar" ligado, um texto repetido é guardado uma vez só: uma tabela hash
+// (endereçamento aberto, sondagem linear) encontra o texto igual já guardado
+//
+// O buffer pode mudar de lugar a cada inserção: o ponteiro de texto_arena só vale
+// até a próxima chamada de arena_adicionar na mesma arena
+
+#define ARENA_CAPACIDADE_INICIAL 4096
+#define ARENA_LIMITE UINT32_MAX
+
+typedef struct {
+    uint32_t deslocamento;  // Posição do primeiro caractere na arena
+    uint32_t tamanho;       // Número de caracteres, sem o '\0'
+} RefTexto;
+
+// Entrada da tabela de textos internados
+typedef struct {
+    uint32_t hash;
+    uint32_t deslocamento;
+    uint32_t tamanho;
+    uint32_t ocupada;       // 0 = livre
+} EntradaArena;
+
+typedef struct {
+    char *dados;
+    size_t tamanho;         // Bytes usados (todos os textos com os seus '\0')
+    size_t capacidade;
+    int internar;           // 1 = textos repetidos são guardados uma vez só
+    EntradaArena *tabela;
+    size_t capacidade_tabela;   // Potência de 2 (0 = sem tabela)
+    size_t num_entradas;
+    size_t repetidos;       // Inserções resolvidas pela tabela (texto já guardado)
+} ArenaTextos;
+
+// Arena dos nomes (alunos ou clientes) do programa
+extern ArenaTextos arena_nomes;
+
+// Protótipos das funções em arena.c
+void iniciar_arena(ArenaTextos *arena, int internar);
+void liberar_arena(ArenaTextos *arena);
+int arena_adicionar(ArenaTextos *arena, const char *texto, size_t tamanho, RefTexto *ref);
+const char *texto_arena(const ArenaTextos *arena, RefTexto ref);
+size_t arena_marca(const ArenaTextos *arena);
+void arena_descartar(ArenaTextos *arena, size_t marca);
+int arena_transferir(ArenaTextos *destino, const ArenaTextos *origem, RefTexto *refs, size_t num_refs, size_t passo);
+
+#endif
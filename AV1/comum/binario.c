@@ -0,0 +1,58 @@
+#include "binario.h"
+
+#ifdef _WIN32
+#include <io.h>
+#define fsync _commit
+#else
+#include <unistd.h>
+#endif
+
+// Arredonda para o próximo múltiplo de BINARIO_ALINHAMENTO
+size_t alinhar_secao(size_t tamanho) {
+    return (tamanho + BINARIO_ALINHAMENTO - 1) / BINARIO_ALINHAMENTO * BINARIO_ALINHAMENTO;
+}
+
+// Checksum (FNV-1a sobre palavras de 8 bytes); "tamanho" é sempre múltiplo de 8
+uint64_t atualizar_checksum(uint64_t checksum, const void *dados, size_t tamanho) {
+    const unsigned char *p = (const unsigned char*) dados;
+    for (size_t i = 0; i < tamanho; i += 8) {
+        uint64_t palavra;
+        memcpy(&palavra, p + i, 8);
+        checksum = (checksum ^ palavra) * 0x100000001b3ull;
+    }
+    return checksum;
+}
+
+// Completa a seção com zeros até o alinhamento, grava e atualiza o checksum
+// "buffer" precisa ter espaço para alinhar_secao(tamanho) bytes
+int escrever_secao(FILE *fp, char *buffer, size_t tamanho, uint64_t *checksum) {
+    size_t completo = alinhar_secao(tamanho);
+    memset(buffer + tamanho, 0, completo - tamanho);
+    *checksum = atualizar_checksum(*checksum, buffer, completo);
+    return fwrite(buffer, 1, completo, fp) == completo;
+}
+
+// Abre "<nome>.tmp" para gravação; o nome usado fica em "nome_temporario"
+// Retorna NULL em caso de erro
+FILE *abrir_arquivo_temporario(const char *nome, char *nome_temporario, size_t tamanho_nome) {
+    snprintf(nome_temporario, tamanho_nome, "%s.tmp", nome);
+    return fopen(nome_temporario, "wb");
+}
+
+// Termina a gravação de abrir_arquivo_temporario: se tudo deu certo até aqui ("ok"),
+// sincroniza com o disco, fecha e renomeia para "nome"; senão, fecha e apaga o temporário
+// Retorna 1 se o arquivo novo substituiu o anterior e 0 em caso de erro
+int substituir_arquivo(FILE *fp, const char *nome_temporario, const char *nome, int ok) {
+    ok = ok && fflush(fp) == 0 && fsync(fileno(fp)) == 0;
+    ok = (fclose(fp) == 0) && ok;
+    if (ok) {
+#ifdef _WIN32
+        remove(nome); // rename não substitui um arquivo existente no Windows
+#endif
+        ok = rename(nome_temporario, nome) == 0;
+    }
+    if (!ok) {
+        remove(nome_temporario);
+    }
+    return ok;
+}
@@ -0,0 +1,25 @@
+#ifndef BINARIO_H
+#define BINARIO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Arquivos binários em seções (snapshots): cada seção é completada com zeros até um
+// múltiplo de BINARIO_ALINHAMENTO bytes e entra no checksum do arquivo
+// A gravação é atômica: o arquivo é escrito em "<nome>.tmp", sincronizado com o disco
+// (fsync) e renomeado por cima do anterior, então um arquivo pela metade nunca é lido
+
+#define BINARIO_ALINHAMENTO 64
+#define BINARIO_ORDEM_BYTES 0x01020304u     // Gravado no cabeçalho para detectar outra arquitetura
+#define CHECKSUM_INICIAL 0xcbf29ce484222325ull
+
+// Protótipos das funções em binario.c
+size_t alinhar_secao(size_t tamanho);
+uint64_t atualizar_checksum(uint64_t checksum, const void *dados, size_t tamanho);
+int escrever_secao(FILE *fp, char *buffer, size_t tamanho, uint64_t *checksum);
+FILE *abrir_arquivo_temporario(const char *nome, char *nome_temporario, size_t tamanho_nome);
+int substituir_arquivo(FILE *fp, const char *nome_temporario, const char *nome, int ok);
+
+#endif
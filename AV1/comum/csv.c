@@ -0,0 +1,274 @@
+#include "csv.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Mantissas até 2^24 cabem exatas em um float; dividir por uma potência de 10 exata
+// (até 10^10) dá o mesmo valor arredondado que strtof, já que as duas operações
+// arredondam uma vez só para o float mais próximo
+#define CSV_MAX_MANTISSA (1u << 24)
+#define CSV_MAX_CASAS 10
+#define CSV_MAX_DIGITOS_INT 9   // Até 999999999 cabe em um int sem estouro
+
+static const float potencias_dez[CSV_MAX_CASAS + 1] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+// Procura o primeiro byte igual a "a" ou "b" em [p, fim)
+// Retorna "fim" se nenhum for encontrado
+static const char *procurar_bytes(const char *p, const char *fim, char a, char b) {
+#if defined(__AVX2__)
+    const __m256i va = _mm256_set1_epi8(a);
+    const __m256i vb = _mm256_set1_epi8(b);
+    while (fim - p >= 64) {
+        __m256i x = _mm256_loadu_si256((const __m256i*) p);
+        __m256i y = _mm256_loadu_si256((const __m256i*) (p + 32));
+        unsigned mx = (unsigned) _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(x, va), _mm256_cmpeq_epi8(x, vb)));
+        unsigned my = (unsigned) _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(y, va), _mm256_cmpeq_epi8(y, vb)));
+        if (mx | my) {
+            return mx ? p + __builtin_ctz(mx) : p + 32 + __builtin_ctz(my);
+        }
+        p += 64;
+    }
+    if (fim - p >= 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*) p);
+        unsigned mx = (unsigned) _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(x, va), _mm256_cmpeq_epi8(x, vb)));
+        if (mx) {
+            return p + __builtin_ctz(mx);
+        }
+        p += 32;
+    }
+#elif defined(__SSE2__)
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    while (fim - p >= 32) {
+        __m128i x = _mm_loadu_si128((const __m128i*) p);
+        __m128i y = _mm_loadu_si128((const __m128i*) (p + 16));
+        unsigned mx = (unsigned) _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(x, va), _mm_cmpeq_epi8(x, vb)));
+        unsigned my = (unsigned) _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(y, va), _mm_cmpeq_epi8(y, vb)));
+        if (mx | my) {
+            return mx ? p + __builtin_ctz(mx) : p + 16 + __builtin_ctz(my);
+        }
+        p += 32;
+    }
+#endif
+    // Resto (ou tudo, sem SIMD)
+    while (p < fim && *p != a && *p != b) {
+        p++;
+    }
+    return p;
+}
+
+// Fim da linha que começa em "p" (o '\n' ou "fim")
+const char *csv_fim_linha(const char *p, const char *fim) {
+    return procurar_bytes(p, fim, '\n', '\n');
+}
+
+// Próxima vírgula ou '\n' a partir de "p" (ou "fim")
+const char *csv_proximo_delimitador(const char *p, const char *fim) {
+    return procurar_bytes(p, fim, ',', '\n');
+}
+
+// Prepara a leitura dos campos da linha [inicio, fim)
+void iniciar_linha_csv(LinhaCSV *linha, const char *inicio, const char *fim) {
+    linha->inicio = inicio;
+    linha->atual = inicio;
+    linha->fim = fim;
+    linha->coluna = 1;
+    linha->coluna_erro = 0;
+    linha->erro = NULL;
+}
+
+// Marca o erro no campo atual e retorna 0 (para ser usada no return das leituras)
+static int falhar(LinhaCSV *linha, const char *erro) {
+    if (!linha->coluna_erro) {
+        linha->coluna_erro = linha->coluna;
+        linha->erro = erro;
+    }
+    return 0;
+}
+
+// Os mesmos espaços que strtol/strtof ignoram
+static const char *pular_espacos(const char *p, const char *fim) {
+    while (p < fim && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\v' || *p == '\f')) {
+        p++;
+    }
+    return p;
+}
+
+// Lê um inteiro (mesmo resultado de strtol convertido para int)
+int csv_ler_int(LinhaCSV *linha, int *valor) {
+    const char *inicio = pular_espacos(linha->atual, linha->fim);
+    if (inicio >= linha->fim) {
+        return falhar(linha, "campo vazio");
+    }
+
+    const char *p = inicio;
+    int negativo = 0;
+    if (*p == '+' || *p == '-') {
+        negativo = *p == '-';
+        p++;
+    }
+    const char *digitos = p;
+    unsigned int acumulado = 0;
+    while (p < linha->fim && (unsigned) (*p - '0') < 10 && p - digitos < CSV_MAX_DIGITOS_INT) {
+        acumulado = acumulado * 10 + (unsigned) (*p - '0');
+        p++;
+    }
+    if (p == digitos) {
+        return falhar(linha, "inteiro inválido");
+    }
+    if (p < linha->fim && (unsigned) (*p - '0') < 10) {
+        // Mais dígitos do que o caminho rápido aceita: strtol decide (e satura)
+        char *final;
+        *valor = (int) strtol(inicio, &final, 10);
+        linha->atual = final;
+        return 1;
+    }
+
+    *valor = negativo ? -(int) acumulado : (int) acumulado;
+    linha->atual = p;
+    return 1;
+}
+
+// Lê um número decimal (mesmo resultado de strtof)
+int csv_ler_float(LinhaCSV *linha, float *valor) {
+    const char *inicio = pular_espacos(linha->atual, linha->fim);
+    if (inicio >= linha->fim) {
+        return falhar(linha, "campo vazio");
+    }
+
+    const char *p = inicio;
+    int negativo = 0;
+    if (*p == '+' || *p == '-') {
+        negativo = *p == '-';
+        p++;
+    }
+    unsigned long long mantissa = 0;
+    int num_digitos = 0;
+    int casas = 0;
+    int exato = 1;
+    while (p < linha->fim && (unsigned) (*p - '0') < 10) {
+        mantissa = mantissa * 10 + (unsigned) (*p - '0');
+        exato &= mantissa <= CSV_MAX_MANTISSA;
+        mantissa = exato ? mantissa : 0;
+        num_digitos++;
+        p++;
+    }
+    if (p < linha->fim && *p == '.') {
+        p++;
+        while (p < linha->fim && (unsigned) (*p - '0') < 10) {
+            mantissa = mantissa * 10 + (unsigned) (*p - '0');
+            exato &= mantissa <= CSV_MAX_MANTISSA;
+            mantissa = exato ? mantissa : 0;
+            num_digitos++;
+            casas++;
+            p++;
+        }
+    }
+
+    // Expoente, hexadecimal, inf/nan ou precisão demais: strtof decide
+    int especial = p < linha->fim && (*p == 'e' || *p == 'E' || *p == 'x' || *p == 'X');
+    if (num_digitos == 0 || especial || !exato || casas > CSV_MAX_CASAS) {
+        char *final;
+        float lido = strtof(inicio, &final);
+        if (final == inicio) {
+            return falhar(linha, "número inválido");
+        }
+        *valor = lido;
+        linha->atual = final;
+        return 1;
+    }
+
+    float lido = (float) mantissa / potencias_dez[casas];
+    *valor = negativo ? -lido : lido;
+    linha->atual = p;
+    return 1;
+}
+
+// Lê um campo de texto sem copiar: "texto" aponta para a linha e "tamanho" é o número de caracteres
+// O campo precisa ter pelo menos um caractere e terminar em vírgula
+int csv_ler_campo(LinhaCSV *linha, const char **texto, size_t *tamanho) {
+    const char *virgula = csv_proximo_delimitador(linha->atual, linha->fim);
+    if (virgula >= linha->fim || *virgula != ',') {
+        return falhar(linha, "vírgula esperada");
+    }
+    if (virgula == linha->atual) {
+        return falhar(linha, "campo vazio");
+    }
+    *texto = linha->atual;
+    *tamanho = (size_t) (virgula - linha->atual);
+    linha->atual = virgula;
+    return 1;
+}
+
+// Copia o texto até a próxima vírgula (truncado em tamanho_destino - 1 caracteres)
+int csv_ler_texto(LinhaCSV *linha, char *destino, size_t tamanho_destino) {
+    const char *texto;
+    size_t tamanho;
+    if (!csv_ler_campo(linha, &texto, &tamanho)) {
+        return 0;
+    }
+    if (tamanho >= tamanho_destino) {
+        tamanho = tamanho_destino - 1;
+    }
+    memcpy(destino, texto, tamanho);
+    destino[tamanho] = '\0';
+    return 1;
+}
+
+// Consome a vírgula que separa o campo atual do próximo
+int csv_separador(LinhaCSV *linha) {
+    if (linha->atual >= linha->fim || *linha->atual != ',') {
+        return falhar(linha, "vírgula esperada");
+    }
+    linha->atual++;
+    linha->coluna++;
+    return 1;
+}
+
+// Marca um erro encontrado depois da leitura do campo (ex.: valor fora do permitido)
+// Retorna 0, como as funções de leitura
+int csv_erro_campo(LinhaCSV *linha, int coluna, const char *erro) {
+    if (!linha->coluna_erro) {
+        linha->coluna_erro = coluna;
+        linha->erro = erro;
+    }
+    return 0;
+}
+
+// Lê uma linha inteira de "entrada" para o buffer, aumentando-o se necessário
+// Retorna o tamanho da linha sem o '\n' ou -1 no fim do arquivo
+long ler_linha(FILE *entrada, char **buffer, int *capacidade) {
+    long tamanho = 0;
+    if (!*buffer) {
+        *buffer = VETOR_RESERVAR(*buffer, *capacidade, 256);
+        if (!*buffer) {
+            return -1;
+        }
+    }
+
+    while (fgets(*buffer + tamanho, *capacidade - (int) tamanho, entrada)) {
+        tamanho += (long) strlen(*buffer + tamanho);
+        if (tamanho > 0 && (*buffer)[tamanho - 1] == '\n') {
+            return tamanho - 1;
+        }
+        // A linha não coube: dobra o buffer e continua lendo
+        char *temp = VETOR_RESERVAR(*buffer, *capacidade, *capacidade + 1);
+        if (!temp) {
+            return tamanho;
+        }
+        *buffer = temp;
+    }
+    return tamanho > 0 ? tamanho : -1;
+}
+
+// Imprime o erro de leitura de uma linha, com o número da linha e do campo
+void reportar_erro_csv(const char *descricao, int numero_linha, const LinhaCSV *linha) {
+    fprintf(stderr, "Erro ao ler linha %d, coluna %d do arquivo de %s (%s): %.*s\n",
+            numero_linha, linha->coluna_erro, descricao, linha->erro ? linha->erro : "formato inválido",
+            (int) (linha->fim - linha->inicio), linha->inicio);
+}
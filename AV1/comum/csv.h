@@ -0,0 +1,45 @@
+#ifndef CSV_H
+#define CSV_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vetor.h"
+
+// Leitura dos campos de uma linha de CSV, sem sscanf
+// As vírgulas e quebras de linha são procuradas 64 bytes por vez (AVX2) ou 32 (SSE2),
+// e os números são convertidos por funções próprias, que só recorrem a strtol/strtof
+// nos casos raros (muitos dígitos, expoente, hexadecimal, inf/nan)
+//
+// As regras são as mesmas do formato "%d,%[^,],%f" do sscanf usado antes:
+//  - números podem ter espaços antes, mas a vírgula vem logo depois do número
+//  - texto vai até a próxima vírgula e tem pelo menos um caractere
+//  - o que vier depois do último campo é ignorado (por exemplo o '\r' do Windows)
+// Assim como strtol/strtof, a leitura de números pode olhar o byte em "fim":
+// a linha precisa estar dentro de um buffer terminado em '\n' ou '\0'
+
+// Linha sendo lida e o primeiro erro encontrado
+typedef struct {
+    const char *inicio;     // Início da linha (para as mensagens de erro)
+    const char *atual;      // Próximo caractere a ler
+    const char *fim;        // Fim da linha (sem o '\n')
+    int coluna;             // Campo atual (a partir de 1)
+    int coluna_erro;        // Campo em que a leitura falhou (0 = sem erro)
+    const char *erro;       // Descrição do erro
+} LinhaCSV;
+
+// Protótipos das funções em csv.c
+const char *csv_fim_linha(const char *p, const char *fim);
+const char *csv_proximo_delimitador(const char *p, const char *fim);
+void iniciar_linha_csv(LinhaCSV *linha, const char *inicio, const char *fim);
+int csv_ler_int(LinhaCSV *linha, int *valor);
+int csv_ler_float(LinhaCSV *linha, float *valor);
+int csv_ler_campo(LinhaCSV *linha, const char **texto, size_t *tamanho);
+int csv_ler_texto(LinhaCSV *linha, char *destino, size_t tamanho_destino);
+int csv_separador(LinhaCSV *linha);
+int csv_erro_campo(LinhaCSV *linha, int coluna, const char *erro);
+long ler_linha(FILE *entrada, char **buffer, int *capacidade);
+void reportar_erro_csv(const char *descricao, int numero_linha, const LinhaCSV *linha);
+
+#endif
@@ -0,0 +1,114 @@
+#include "mapeamento.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Lê o arquivo inteiro para um buffer alocado com malloc (terminado em '\0')
+// Usado quando o mmap não está disponível ou não garante o '\0' final
+static int ler_arquivo_inteiro(const char *nome_arquivo, ArquivoMapeado *arquivo) {
+    FILE *fp = fopen(nome_arquivo, "rb");
+    if (!fp) {
+        return 0;
+    }
+
+    // Descobre o tamanho do arquivo
+    if (fseek(fp, 0, SEEK_END) != 0) {
+        fclose(fp);
+        return 0;
+    }
+    long tamanho = ftell(fp);
+    if (tamanho < 0 || fseek(fp, 0, SEEK_SET) != 0) {
+        fclose(fp);
+        return 0;
+    }
+
+    char *dados = (char*) malloc((size_t) tamanho + 1);
+    if (!dados) {
+        fclose(fp);
+        return 0;
+    }
+
+    size_t lidos = fread(dados, 1, (size_t) tamanho, fp);
+    fclose(fp);
+    dados[lidos] = '\0';
+
+    arquivo->dados = dados;
+    arquivo->tamanho = lidos;
+    arquivo->mapeado = 0;
+    return 1;
+}
+
+// Mapeia o arquivo; se exige_terminador for 1, só usa mmap quando o '\0' final é garantido
+static int mapear(const char *nome_arquivo, ArquivoMapeado *arquivo, int exige_terminador) {
+    arquivo->dados = NULL;
+    arquivo->tamanho = 0;
+    arquivo->mapeado = 0;
+
+#ifndef _WIN32
+    int fd = open(nome_arquivo, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) < 0) {
+        close(fd);
+        return 0;
+    }
+
+    size_t tamanho = (size_t) info.st_size;
+    size_t pagina = (size_t) sysconf(_SC_PAGESIZE);
+
+    // Para texto, só mapeia quando o arquivo não ocupa a última página inteira:
+    // o kernel zera o restante da página, o que garante o '\0' em dados[tamanho]
+    if (S_ISREG(info.st_mode) && tamanho > 0 && (!exige_terminador || tamanho % pagina != 0)) {
+        void *dados = mmap(NULL, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (dados != MAP_FAILED) {
+            madvise(dados, tamanho, MADV_SEQUENTIAL); // Leitura será sequencial
+            close(fd);
+            arquivo->dados = (char*) dados;
+            arquivo->tamanho = tamanho;
+            arquivo->mapeado = 1;
+            return 1;
+        }
+    }
+    close(fd);
+#endif
+
+    return ler_arquivo_inteiro(nome_arquivo, arquivo);
+}
+
+// Disponibiliza o conteúdo do arquivo em memória, de preferência via mmap
+// Retorna 1 em caso de sucesso e 0 em caso de erro (errno fica preenchido)
+int mapear_arquivo(const char *nome_arquivo, ArquivoMapeado *arquivo) {
+    return mapear(nome_arquivo, arquivo, 1);
+}
+
+// Igual a mapear_arquivo, para arquivos binários: o '\0' em dados[tamanho]
+// não é garantido, então o mmap é usado para qualquer tamanho
+int mapear_arquivo_binario(const char *nome_arquivo, ArquivoMapeado *arquivo) {
+    return mapear(nome_arquivo, arquivo, 0);
+}
+
+// Libera o mapeamento (ou o buffer) criado por mapear_arquivo
+void desmapear_arquivo(ArquivoMapeado *arquivo) {
+    if (!arquivo->dados) {
+        return;
+    }
+#ifndef _WIN32
+    if (arquivo->mapeado) {
+        munmap(arquivo->dados, arquivo->tamanho);
+    } else {
+        free(arquivo->dados);
+    }
+#else
+    free(arquivo->dados);
+#endif
+    arquivo->dados = NULL;
+    arquivo->tamanho = 0;
+    arquivo->mapeado = 0;
+}
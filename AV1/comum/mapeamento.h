@@ -0,0 +1,22 @@
+#ifndef MAPEAMENTO_H
+#define MAPEAMENTO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Arquivo inteiro disponível em memória para leitura
+// Com mapear_arquivo, o conteúdo é sempre seguido por um '\0' legível em dados[tamanho],
+// então as funções de conversão (strtol, strtof) nunca passam do fim
+typedef struct {
+    char *dados;        // Início do conteúdo do arquivo
+    size_t tamanho;     // Tamanho do conteúdo em bytes
+    int mapeado;        // 1: dados vem de mmap, 0: dados foi alocado com malloc
+} ArquivoMapeado;
+
+// Protótipos das funções em mapeamento.c
+int mapear_arquivo(const char *nome_arquivo, ArquivoMapeado *arquivo);
+int mapear_arquivo_binario(const char *nome_arquivo, ArquivoMapeado *arquivo);
+void desmapear_arquivo(ArquivoMapeado *arquivo);
+
+#endif
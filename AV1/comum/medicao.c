@@ -0,0 +1,134 @@
+#include "medicao.h"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// Os nomes entre parênteses, como (malloc)(...), chamam a função da biblioteca
+// mesmo com as macros de MEDIR_ALOCACOES ativas
+
+static long contador_alocacoes;
+static long contador_liberacoes;
+static long long contador_bytes;
+
+static void contar_alocacao(size_t tamanho) {
+    __atomic_fetch_add(&contador_alocacoes, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&contador_bytes, (long long) tamanho, __ATOMIC_RELAXED);
+}
+
+void *medir_malloc(size_t tamanho) {
+    contar_alocacao(tamanho);
+    return (malloc)(tamanho);
+}
+
+void *medir_calloc(size_t quantidade, size_t tamanho) {
+    contar_alocacao(quantidade * tamanho);
+    return (calloc)(quantidade, tamanho);
+}
+
+void *medir_realloc(void *ponteiro, size_t tamanho) {
+    contar_alocacao(tamanho);
+    return (realloc)(ponteiro, tamanho);
+}
+
+void medir_free(void *ponteiro) {
+    if (ponteiro) {
+        __atomic_fetch_add(&contador_liberacoes, 1, __ATOMIC_RELAXED);
+    }
+    (free)(ponteiro);
+}
+
+// Pico de memória residente do processo em KB (VmHWM no Linux, getrusage nos outros)
+// Retorna -1 se não for possível medir
+long pico_memoria_kb(void) {
+    FILE *status = fopen("/proc/self/status", "r");
+    if (status) {
+        char linha[256];
+        long pico = -1;
+        while (fgets(linha, sizeof(linha), status)) {
+            if (strncmp(linha, "VmHWM:", 6) == 0) {
+                pico = strtol(linha + 6, NULL, 10);
+                break;
+            }
+        }
+        fclose(status);
+        if (pico >= 0) {
+            return pico;
+        }
+    }
+#ifndef _WIN32
+    struct rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) == 0) {
+        return uso.ru_maxrss;   // KB no Linux (bytes no macOS)
+    }
+#endif
+    return -1;
+}
+
+// Zera o pico de memória (só no Linux, escrevendo 5 em /proc/self/clear_refs)
+// Retorna 1 se conseguiu; sem isso o pico medido é o do processo inteiro
+int reiniciar_pico_memoria(void) {
+    FILE *arquivo = fopen("/proc/self/clear_refs", "w");
+    if (!arquivo) {
+        return 0;
+    }
+    int ok = fputs("5", arquivo) >= 0;
+    ok = (fclose(arquivo) == 0) && ok;
+    return ok;
+}
+
+// Começa a medir uma etapa: zera os contadores e o pico de memória
+void iniciar_medicao(Medicao *medicao, const char *programa, const char *arquivo, const char *etapa) {
+    memset(medicao, 0, sizeof(Medicao));
+    medicao->programa = programa;
+    medicao->arquivo = arquivo;
+    medicao->etapa = etapa;
+    medicao->pico_reiniciado = reiniciar_pico_memoria();
+    __atomic_store_n(&contador_alocacoes, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&contador_liberacoes, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&contador_bytes, 0, __ATOMIC_RELAXED);
+    medicao->inicio = tempo_atual();
+}
+
+// Termina a medição da etapa, que processou "linhas" registros
+void terminar_medicao(Medicao *medicao, long linhas) {
+    medicao->segundos = tempo_atual() - medicao->inicio;
+    medicao->linhas = linhas;
+    medicao->pico_rss_kb = pico_memoria_kb();
+    medicao->alocacoes = __atomic_load_n(&contador_alocacoes, __ATOMIC_RELAXED);
+    medicao->liberacoes = __atomic_load_n(&contador_liberacoes, __ATOMIC_RELAXED);
+    medicao->bytes_alocados = __atomic_load_n(&contador_bytes, __ATOMIC_RELAXED);
+}
+
+// Escreve um texto entre aspas, com os escapes do JSON
+static void imprimir_texto_json(FILE *saida, const char *texto) {
+    fputc('"', saida);
+    for (const unsigned char *p = (const unsigned char*) (texto ? texto : ""); *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            fprintf(saida, "\\%c", *p);
+        } else if (*p < 0x20) {
+            fprintf(saida, "\\u%04x", *p);
+        } else {
+            fputc(*p, saida);
+        }
+    }
+    fputc('"', saida);
+}
+
+// Escreve a medição como um objeto JSON em uma linha (JSON Lines: um objeto por etapa)
+void imprimir_medicao_json(FILE *saida, const Medicao *medicao) {
+    double por_segundo = medicao->segundos > 0 ? medicao->linhas / medicao->segundos : 0.0;
+    fprintf(saida, "{\"programa\": ");
+    imprimir_texto_json(saida, medicao->programa);
+    fprintf(saida, ", \"arquivo\": ");
+    imprimir_texto_json(saida, medicao->arquivo);
+    fprintf(saida, ", \"etapa\": ");
+    imprimir_texto_json(saida, medicao->etapa);
+    fprintf(saida, ", \"linhas\": %ld, \"segundos\": %.6f, \"linhas_por_segundo\": %.0f, "
+                   "\"pico_rss_kb\": %ld, \"pico_reiniciado\": %s, \"alocacoes\": %ld, "
+                   "\"liberacoes\": %ld, \"bytes_alocados\": %lld}\n",
+            medicao->linhas, medicao->segundos, por_segundo, medicao->pico_rss_kb,
+            medicao->pico_reiniciado ? "true" : "false", medicao->alocacoes,
+            medicao->liberacoes, medicao->bytes_alocados);
+    fflush(saida);
+}
@@ -0,0 +1,50 @@
+#ifndef MEDICAO_H
+#define MEDICAO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tempo.h"
+
+// Medição das etapas dos benchmarks: tempo, pico de memória residente (RSS) e
+// número de alocações, com cada etapa escrita como um objeto JSON por linha
+//
+// As alocações são contadas trocando malloc/calloc/realloc/free pelas versões
+// com contador: basta definir MEDIR_ALOCACOES antes de incluir este arquivo,
+// e antes do código medido (ex.: no benchmark, antes de #include "utils.c")
+// Os contadores são atômicos, então as threads dos carregadores paralelos também contam
+
+typedef struct {
+    const char *programa;       // "notas" ou "emprestimos"
+    const char *arquivo;
+    const char *etapa;          // Função medida (ex.: "carregar_alunos")
+    long linhas;                // Registros processados pela etapa
+    double inicio;
+    double segundos;
+    long pico_rss_kb;           // Pico de memória residente durante a etapa (ou do processo, ver pico_reiniciado)
+    int pico_reiniciado;        // 1 se o pico foi zerado no início da etapa
+    long alocacoes;             // Chamadas de malloc, calloc e realloc
+    long liberacoes;            // Chamadas de free com ponteiro não nulo
+    long long bytes_alocados;   // Soma dos tamanhos pedidos
+} Medicao;
+
+// Protótipos das funções em medicao.c (tempo_atual está em tempo.c)
+void *medir_malloc(size_t tamanho);
+void *medir_calloc(size_t quantidade, size_t tamanho);
+void *medir_realloc(void *ponteiro, size_t tamanho);
+void medir_free(void *ponteiro);
+long pico_memoria_kb(void);
+int reiniciar_pico_memoria(void);
+void iniciar_medicao(Medicao *medicao, const char *programa, const char *arquivo, const char *etapa);
+void terminar_medicao(Medicao *medicao, long linhas);
+void imprimir_medicao_json(FILE *saida, const Medicao *medicao);
+
+#ifdef MEDIR_ALOCACOES
+#define malloc(tamanho) medir_malloc(tamanho)
+#define calloc(quantidade, tamanho) medir_calloc((quantidade), (tamanho))
+#define realloc(ponteiro, tamanho) medir_realloc((ponteiro), (tamanho))
+#define free(ponteiro) medir_free(ponteiro)
+#endif
+
+#endif
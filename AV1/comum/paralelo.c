@@ -0,0 +1,158 @@
+#include "paralelo.h"
+#include "vetor.h"
+#include <pthread.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+// Define quantas threads usar: o pedido, ou o número de processadores se o pedido for 0
+int numero_threads(int pedido) {
+    int n = pedido;
+    if (n <= 0) {
+#ifdef _SC_NPROCESSORS_ONLN
+        n = (int) sysconf(_SC_NPROCESSORS_ONLN);
+#else
+        n = 1;
+#endif
+    }
+    if (n < 1) {
+        n = 1;
+    }
+    if (n > MAX_THREADS) {
+        n = MAX_THREADS;
+    }
+    return n;
+}
+
+// Divide [inicio, fim) em até "num_pedacos" partes de tamanho parecido
+// Cada corte é movido para depois do próximo '\n', então nenhuma linha fica dividida
+// Retorna quantos pedaços foram criados (pode ser menos que o pedido em arquivos pequenos)
+int dividir_em_pedacos(const char *inicio, const char *fim, int num_pedacos, PedacoArquivo *pedacos) {
+    size_t tamanho = fim - inicio;
+    int criados = 0;
+    const char *p = inicio;
+
+    for (int i = 0; i < num_pedacos && p < fim; i++) {
+        const char *corte = fim;
+        if (i < num_pedacos - 1) {
+            corte = inicio + tamanho / num_pedacos * (i + 1);
+            if (corte < p) {
+                corte = p;
+            }
+            const char *nl = memchr(corte, '\n', fim - corte);
+            corte = nl ? nl + 1 : fim;
+        }
+
+        memset(&pedacos[criados], 0, sizeof(PedacoArquivo));
+        pedacos[criados].inicio = p;
+        pedacos[criados].fim = corte;
+        criados++;
+        p = corte;
+    }
+    return criados;
+}
+
+// Ponto de entrada das threads
+typedef struct {
+    PedacoArquivo *pedaco;
+    FuncaoPedaco funcao;
+} TarefaPedaco;
+
+static void *executar_tarefa(void *arg) {
+    TarefaPedaco *tarefa = (TarefaPedaco*) arg;
+    tarefa->funcao(tarefa->pedaco);
+    return NULL;
+}
+
+// Executa "funcao" em cada pedaço, um por thread
+// O primeiro pedaço roda na própria thread chamadora
+// Retorna 1 em caso de sucesso e 0 se não foi possível criar as threads
+int processar_pedacos(PedacoArquivo *pedacos, int num_pedacos, FuncaoPedaco funcao) {
+    pthread_t threads[MAX_THREADS];
+    TarefaPedaco tarefas[MAX_THREADS];
+    int criadas[MAX_THREADS] = {0};
+    int ok = 1;
+
+    for (int i = 1; i < num_pedacos; i++) {
+        tarefas[i].pedaco = &pedacos[i];
+        tarefas[i].funcao = funcao;
+        criadas[i] = pthread_create(&threads[i], NULL, executar_tarefa, &tarefas[i]) == 0;
+        if (!criadas[i]) {
+            // Sem thread disponível: processa o pedaço aqui mesmo
+            funcao(&pedacos[i]);
+        }
+    }
+    if (num_pedacos > 0) {
+        funcao(&pedacos[0]);
+    }
+    for (int i = 1; i < num_pedacos; i++) {
+        if (criadas[i] && pthread_join(threads[i], NULL) != 0) {
+            ok = 0;
+        }
+    }
+    return ok;
+}
+
+// Guarda uma linha com erro para ser reportada depois (chamada pela thread do pedaço)
+// "coluna" e "motivo" vêm normalmente da LinhaCSV que falhou (comum/csv.h)
+void registrar_erro_linha(PedacoArquivo *pedaco, int linha, const char *inicio, const char *fim, int coluna, const char *motivo) {
+    ErroLinha *temp = VETOR_RESERVAR(pedaco->erros, pedaco->capacidade_erros, pedaco->num_erros + 1);
+    if (!temp) {
+        return;
+    }
+    pedaco->erros = temp;
+    pedaco->erros[pedaco->num_erros].linha = linha;
+    pedaco->erros[pedaco->num_erros].inicio = inicio;
+    pedaco->erros[pedaco->num_erros].tamanho = (int) (fim - inicio);
+    pedaco->erros[pedaco->num_erros].coluna = coluna;
+    pedaco->erros[pedaco->num_erros].motivo = motivo ? motivo : "formato inválido";
+    pedaco->num_erros++;
+}
+
+// Imprime um erro com o número real da linha ("base" é a linha em que o pedaço começa)
+static void reportar_erro_linha(const ErroLinha *erro, int base, const char *descricao) {
+    if (erro->coluna > 0) {
+        fprintf(stderr, "Erro ao ler linha %d, coluna %d do arquivo de %s (%s): %.*s\n",
+                base + erro->linha, erro->coluna, descricao, erro->motivo, erro->tamanho, erro->inicio);
+    } else {
+        fprintf(stderr, "Erro ao ler linha %d do arquivo de %s (%s): %.*s\n",
+                base + erro->linha, descricao, erro->motivo, erro->tamanho, erro->inicio);
+    }
+}
+
+// Imprime os erros de todos os pedaços na ordem do arquivo, com o número real da linha
+// "primeira_linha" é o número da linha em que o primeiro pedaço começa (ex.: 2 após o cabeçalho)
+void reportar_erros_pedacos(const PedacoArquivo *pedacos, int num_pedacos, int primeira_linha, const char *descricao) {
+    int base = primeira_linha;
+    for (int i = 0; i < num_pedacos; i++) {
+        for (int j = 0; j < pedacos[i].num_erros; j++) {
+            reportar_erro_linha(&pedacos[i].erros[j], base, descricao);
+        }
+        base += pedacos[i].num_linhas;
+    }
+}
+
+// Para intercalar os erros com mensagens dos resultados: imprime, a partir de "proximo_erro",
+// os erros do pedaço que aparecem no arquivo antes do resultado de índice "resultado"
+// (cada linha do pedaço é um resultado ou um erro; resultado = num_linhas imprime o resto)
+// "primeira_linha" é o número da linha em que o pedaço começa
+// Retorna o índice do próximo erro ainda não impresso
+int reportar_erros_antes(const PedacoArquivo *pedaco, int proximo_erro, int resultado, int primeira_linha, const char *descricao) {
+    while (proximo_erro < pedaco->num_erros && pedaco->erros[proximo_erro].linha <= resultado + proximo_erro) {
+        reportar_erro_linha(&pedaco->erros[proximo_erro], primeira_linha, descricao);
+        proximo_erro++;
+    }
+    return proximo_erro;
+}
+
+// Libera os buffers de erros e de resultados de cada pedaço
+void liberar_pedacos(PedacoArquivo *pedacos, int num_pedacos) {
+    for (int i = 0; i < num_pedacos; i++) {
+        free(pedacos[i].erros);
+        free(pedacos[i].resultado);
+        pedacos[i].erros = NULL;
+        pedacos[i].resultado = NULL;
+        liberar_arena(&pedacos[i].textos);
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+
+// Leitura de CSV em paralelo: o conteúdo do arquivo é dividido em pedaços que
+// terminam sempre em uma quebra de linha, cada thread analisa o seu pedaço em
+// buffers próprios e o carregador junta os resultados na ordem do arquivo
+
+#define MAX_THREADS 64
+
+// Linha que não pôde ser lida, guardada para ser reportada depois na ordem do arquivo
+typedef struct {
+    int linha;              // Número da linha dentro do pedaço (começando em 0)
+    const char *inicio;     // Conteúdo da linha (aponta para o arquivo mapeado)
+    int tamanho;            // Tamanho da linha, sem o '\n'
+    int coluna;             // Campo com erro (0 = não se aplica)
+    const char *motivo;     // Descrição do erro (texto constante)
+} ErroLinha;
+
+// Pedaço do arquivo analisado por uma thread
+typedef struct {
+    const char *inicio;     // Primeiro byte do pedaço (início de uma linha)
+    const char *fim;        // Um byte depois do último (após um '\n' ou no fim dos dados)
+    int num_linhas;         // Linhas encontradas no pedaço (preenchido pela thread)
+    ErroLinha *erros;       // Linhas com erro, na ordem em que aparecem
+    int num_erros;
+    int capacidade_erros;
+    void *resultado;        // Array de registros lidos (o tipo depende do carregador)
+    int num_resultados;
+    int capacidade_resultados;
+    void *contexto;         // Dados extras do carregador, compartilhados e só de leitura
+    ArenaTextos textos;     // Textos lidos pela thread (passados para a arena global no final)
+} PedacoArquivo;
+
+typedef void (*FuncaoPedaco)(PedacoArquivo *pedaco);
+
+// Protótipos das funções em paralelo.c
+int numero_threads(int pedido);
+int dividir_em_pedacos(const char *inicio, const char *fim, int num_pedacos, PedacoArquivo *pedacos);
+int processar_pedacos(PedacoArquivo *pedacos, int num_pedacos, FuncaoPedaco funcao);
+void registrar_erro_linha(PedacoArquivo *pedaco, int linha, const char *inicio, const char *fim, int coluna, const char *motivo);
+void reportar_erros_pedacos(const PedacoArquivo *pedacos, int num_pedacos, int primeira_linha, const char *descricao);
+int reportar_erros_antes(const PedacoArquivo *pedaco, int proximo_erro, int resultado, int primeira_linha, const char *descricao);
+void liberar_pedacos(PedacoArquivo *pedacos, int num_pedacos);
+
+#endif
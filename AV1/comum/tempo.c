@@ -0,0 +1,8 @@
+#include "tempo.h"
+
+// Retorna o tempo atual em segundos (relógio monotônico)
+double tempo_atual(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
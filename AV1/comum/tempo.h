@@ -0,0 +1,11 @@
+#ifndef TEMPO_H
+#define TEMPO_H
+
+#include <time.h>
+
+// Relógio monotônico para medir durações (carga, partições, diário e benchmarks)
+
+// Protótipos das funções em tempo.c
+double tempo_atual(void);
+
+#endif
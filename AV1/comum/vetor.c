@@ -0,0 +1,43 @@
+#include "vetor.h"
+#include <limits.h>
+
+// Garante que o array tenha capacidade para "necessario" elementos
+// Se precisar crescer, a nova capacidade é o dobro da atual (ou mais, se necessário)
+void *vetor_reservar(void *dados, int *capacidade, int necessario, size_t tamanho_elemento) {
+    // Já existe espaço suficiente: nada a fazer
+    if (dados && necessario <= *capacidade) {
+        return dados;
+    }
+
+    // Calcula a nova capacidade dobrando a atual, sem estourar o limite de int
+    int nova_capacidade = *capacidade > 0 ? *capacidade : VETOR_CAPACIDADE_INICIAL;
+    while (nova_capacidade < necessario) {
+        if (nova_capacidade > INT_MAX / 2) {
+            nova_capacidade = necessario;
+            break;
+        }
+        nova_capacidade *= 2;
+    }
+
+    void *temp = realloc(dados, (size_t) nova_capacidade * tamanho_elemento);
+    if (!temp) {
+        return NULL;
+    }
+    *capacidade = nova_capacidade;
+    return temp;
+}
+
+// Libera a capacidade que sobrou no fim do array (shrink-to-fit)
+// Em caso de falha o array original é mantido, já que ele continua válido
+void *vetor_ajustar(void *dados, int *capacidade, int tamanho, size_t tamanho_elemento) {
+    if (!dados || tamanho <= 0 || tamanho == *capacidade) {
+        return dados;
+    }
+
+    void *temp = realloc(dados, (size_t) tamanho * tamanho_elemento);
+    if (!temp) {
+        return dados;
+    }
+    *capacidade = tamanho;
+    return temp;
+}
@@ -0,0 +1,28 @@
+#ifndef VETOR_H
+#define VETOR_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Vetor dinâmico com capacidade: o array cresce geometricamente (dobrando),
+// então n inserções no fim custam O(n) no total, em vez de O(n²) com realloc a cada elemento.
+// O tamanho do elemento vem do tipo do ponteiro, então as macros funcionam com
+// qualquer array tipado (Aluno*, Cliente*, Emprestimo*, ...)
+
+#define VETOR_CAPACIDADE_INICIAL 8
+
+// Protótipos das funções em vetor.c
+void *vetor_reservar(void *dados, int *capacidade, int necessario, size_t tamanho_elemento);
+void *vetor_ajustar(void *dados, int *capacidade, int tamanho, size_t tamanho_elemento);
+
+// Garante espaço para pelo menos "necessario" elementos em "dados"
+// Retorna o novo ponteiro ou NULL em caso de falha (o array antigo continua válido)
+#define VETOR_RESERVAR(dados, capacidade, necessario) \
+    vetor_reservar((dados), &(capacidade), (necessario), sizeof(*(dados)))
+
+// Reduz a capacidade de "dados" para exatamente "tamanho" elementos
+#define VETOR_AJUSTAR(dados, capacidade, tamanho) \
+    vetor_ajustar((dados), &(capacidade), (tamanho), sizeof(*(dados)))
+
+#endif
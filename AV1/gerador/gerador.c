@@ -0,0 +1,352 @@
+// gerador.c
+// Gera arquivos CSV sintéticos para os programas da AV1 (notas.csv, clientes.csv e emprestimos.csv),
+// de 1e3 a 1e8 linhas, sempre iguais para a mesma semente
+//
+// Uso: ./gerador notas <linhas> [opções]
+//      ./gerador clientes <linhas> [opções]
+//      ./gerador emprestimos <linhas> --clientes N [opções]
+//
+// Opções:
+//   --saida arquivo       Escreve no arquivo em vez da saída padrão
+//   --semente S           Semente do gerador (padrão 1)
+//   --fora P              notas: fração das notas fora de 0..10 (padrão 0.02)
+//   --nomes-longos P      notas e clientes: fração dos nomes com mais de 50 caracteres
+//   --invalidas P         fração das linhas com um campo inválido (testa os erros de leitura)
+//   --ids densos|esparsos clientes e empréstimos: ids 1..N ou espalhados até 2^31 (padrão densos)
+//   --quentes K           empréstimos: número de clientes "quentes"
+//   --fracao-quente F     empréstimos: fração dos empréstimos que vai para os clientes quentes
+//   --orfaos P            empréstimos: fração dos empréstimos de clientes que não existem
+//
+// Compile com: gcc -O2 gerador.c -o gerador
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define PRIMO_IDS 2147483647ULL     // 2^31 - 1: ids esparsos são uma permutação de 1..PRIMO_IDS-1
+#define MULTIPLICADOR_IDS 48271ULL
+
+static const char *primeiros_nomes[] = {
+    "Alice", "Antonia", "Arthur", "Beatriz", "Bernardo", "Bruna", "Caio", "Camila", "Daniel", "Davi",
+    "Eduarda", "Enzo", "Felipe", "Fernanda", "Gabriel", "Gabriela", "Guilherme", "Heitor", "Helena", "Isabela",
+    "Joao", "Julia", "Juliana", "Laura", "Leonardo", "Lucas", "Luiza", "Manuela", "Maria", "Matheus",
+    "Miguel", "Pedro", "Rafael", "Sofia", "Valentina", "Vitor"
+};
+static const char *sobrenomes[] = {
+    "Almeida", "Alves", "Araujo", "Barbosa", "Cardoso", "Carvalho", "Castro", "Costa", "Dias", "Ferreira",
+    "Gomes", "Lima", "Martins", "Melo", "Moreira", "Oliveira", "Pereira", "Pinto", "Ribeiro", "Rocha",
+    "Rodrigues", "Santos", "Silva", "Souza", "Teixeira"
+};
+#define NUM_PRIMEIROS (sizeof(primeiros_nomes) / sizeof(primeiros_nomes[0]))
+#define NUM_SOBRENOMES (sizeof(sobrenomes) / sizeof(sobrenomes[0]))
+
+typedef struct {
+    long long linhas;
+    unsigned long long semente;
+    double fora;
+    double nomes_longos;
+    double invalidas;
+    int ids_esparsos;
+    long long clientes;
+    long long quentes;
+    double fracao_quente;
+    double orfaos;
+    const char *saida;
+} Opcoes;
+
+// Gerador pseudoaleatório splitmix64: rápido e igual em qualquer plataforma (rand() não é)
+static unsigned long long estado;
+
+static unsigned long long proximo_aleatorio(void) {
+    unsigned long long z = (estado += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Inteiro em [0, n)
+static unsigned long long aleatorio_ate(unsigned long long n) {
+    return n > 0 ? proximo_aleatorio() % n : 0;
+}
+
+// Real em [0, 1)
+static double aleatorio_real(void) {
+    return (proximo_aleatorio() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static unsigned long long mdc(unsigned long long a, unsigned long long b) {
+    while (b) {
+        unsigned long long r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+// Id do cliente de índice i (0..N-1): denso é i + 1; esparso é uma permutação de 1..2^31-2,
+// então os ids continuam únicos e os empréstimos encontram os mesmos ids com o mesmo índice
+static long long id_cliente(const Opcoes *opcoes, long long i) {
+    if (!opcoes->ids_esparsos) {
+        return i + 1;
+    }
+    return (long long) ((MULTIPLICADOR_IDS * (unsigned long long) (i + 1)) % PRIMO_IDS);
+}
+
+// Escreve um nome "Primeiro Sobrenome Sobrenome" (ou com vários sobrenomes, se for longo)
+static void escrever_nome(FILE *saida, double nomes_longos) {
+    int num_sobrenomes = aleatorio_real() < nomes_longos ? 8 : 2;
+    fputs(primeiros_nomes[aleatorio_ate(NUM_PRIMEIROS)], saida);
+    for (int i = 0; i < num_sobrenomes; i++) {
+        fputc(' ', saida);
+        fputs(sobrenomes[aleatorio_ate(NUM_SOBRENOMES)], saida);
+    }
+}
+
+// Escreve um valor em décimos ou centésimos (ex.: -7 com 1 casa -> "-0.7"), sem printf
+static void escrever_decimal(FILE *saida, long long valor, int casas) {
+    char buffer[32];
+    int pos = sizeof(buffer);
+    int negativo = valor < 0;
+    unsigned long long v = negativo ? (unsigned long long) -valor : (unsigned long long) valor;
+    for (int i = 0; i < casas; i++) {
+        buffer[--pos] = (char) ('0' + v % 10);
+        v /= 10;
+    }
+    if (casas > 0) {
+        buffer[--pos] = '.';
+    }
+    do {
+        buffer[--pos] = (char) ('0' + v % 10);
+        v /= 10;
+    } while (v);
+    if (negativo) {
+        buffer[--pos] = '-';
+    }
+    fwrite(buffer + pos, 1, sizeof(buffer) - pos, saida);
+}
+
+// Uma nota em décimos: 0.0 a 10.0, ou de -3.0 a 13.0 com probabilidade "fora"
+// Notas inteiras saem sem casa decimal, como no notas.csv original ("10")
+static void escrever_nota(FILE *saida, double fora) {
+    long long decimos;
+    if (aleatorio_real() < fora) {
+        decimos = aleatorio_real() < 0.5 ? -1 - (long long) aleatorio_ate(30) : 101 + (long long) aleatorio_ate(30);
+    } else {
+        decimos = (long long) aleatorio_ate(101);
+    }
+    escrever_decimal(saida, decimos % 10 == 0 ? decimos / 10 : decimos, decimos % 10 == 0 ? 0 : 1);
+}
+
+// Campo inválido para as linhas com erro
+static void escrever_invalido(FILE *saida) {
+    static const char *invalidos[] = {"abc", "", "1.2.3x", "--5"};
+    fputs(invalidos[aleatorio_ate(4)], saida);
+}
+
+// Matrículas únicas de 1 a N, embaralhadas: i -> (a * i + c) mod N, com a primo com N
+static void gerar_notas(FILE *saida, const Opcoes *opcoes) {
+    unsigned long long n = (unsigned long long) opcoes->linhas;
+    unsigned long long a = n > 1 ? 2654435761ULL % n : 1;
+    while (n > 1 && (a == 0 || mdc(a, n) != 1)) {
+        a++;
+    }
+    unsigned long long c = aleatorio_ate(n);
+
+    fputs("matricula,nome,av1ap1,av1ap2,av1ap3,np1,av2ap1,av2ap2,av2ap3,np2\n", saida);
+    for (unsigned long long i = 0; i < n; i++) {
+        // A coluna com erro é a matrícula (0) ou uma das notas (2 a 9)
+        int coluna_invalida = -1;
+        if (aleatorio_real() < opcoes->invalidas) {
+            coluna_invalida = (int) aleatorio_ate(9);
+            coluna_invalida += coluna_invalida > 0;
+        }
+
+        if (coluna_invalida == 0) {
+            escrever_invalido(saida);
+        } else {
+            escrever_decimal(saida, (long long) ((a * i + c) % n) + 1, 0);
+        }
+        fputc(',', saida);
+        escrever_nome(saida, opcoes->nomes_longos);
+        for (int coluna = 2; coluna < 10; coluna++) {
+            fputc(',', saida);
+            if (coluna == coluna_invalida) {
+                escrever_invalido(saida);
+            } else {
+                escrever_nota(saida, opcoes->fora);
+            }
+        }
+        fputc('\n', saida);
+    }
+}
+
+static void gerar_clientes(FILE *saida, const Opcoes *opcoes) {
+    fputs("id,nome,salario\n", saida);
+    for (long long i = 0; i < opcoes->linhas; i++) {
+        int invalida = aleatorio_real() < opcoes->invalidas;
+        escrever_decimal(saida, id_cliente(opcoes, i), 0);
+        fputc(',', saida);
+        escrever_nome(saida, opcoes->nomes_longos);
+        fputc(',', saida);
+        if (invalida) {
+            escrever_invalido(saida);
+        } else {
+            escrever_decimal(saida, 100000 + (long long) aleatorio_ate(1900001), 2);   // 1000.00 a 20000.00
+        }
+        fputc('\n', saida);
+    }
+}
+
+// Os clientes quentes ficam espalhados pelo arquivo (índices múltiplos de N / K)
+static void gerar_emprestimos(FILE *saida, const Opcoes *opcoes) {
+    long long passo_quentes = opcoes->quentes > 0 ? opcoes->clientes / opcoes->quentes : 1;
+    if (passo_quentes < 1) {
+        passo_quentes = 1;
+    }
+
+    fputs("cliente_id,valor,num_meses\n", saida);
+    for (long long i = 0; i < opcoes->linhas; i++) {
+        int invalida = aleatorio_real() < opcoes->invalidas;
+        long long id;
+        if (aleatorio_real() < opcoes->orfaos) {
+            // Ids que nenhum cliente usa: os dos índices logo depois do último cliente
+            id = id_cliente(opcoes, opcoes->clientes + (long long) aleatorio_ate(1000));
+        } else if (opcoes->quentes > 0 && aleatorio_real() < opcoes->fracao_quente) {
+            long long k = (long long) aleatorio_ate((unsigned long long) opcoes->quentes);
+            long long indice = k * passo_quentes;
+            id = id_cliente(opcoes, indice < opcoes->clientes ? indice : opcoes->clientes - 1);
+        } else {
+            id = id_cliente(opcoes, (long long) aleatorio_ate((unsigned long long) opcoes->clientes));
+        }
+
+        escrever_decimal(saida, id, 0);
+        fputc(',', saida);
+        escrever_decimal(saida, 50000 + (long long) aleatorio_ate(14950001), 2);       // 500.00 a 150000.00
+        fputc(',', saida);
+        if (invalida) {
+            escrever_invalido(saida);
+        } else {
+            escrever_decimal(saida, 1 + (long long) aleatorio_ate(144), 0);            // 1 a 144 meses
+        }
+        fputc('\n', saida);
+    }
+}
+
+// Lê uma fração entre 0 e 1; retorna 0 se for inválida
+static int ler_fracao(const char *texto, double *valor) {
+    char *fim;
+    *valor = strtod(texto, &fim);
+    return fim != texto && *fim == '\0' && *valor >= 0.0 && *valor <= 1.0;
+}
+
+// Lê um número de linhas (aceita notação científica, como 1e6); retorna 0 se for inválido
+static int ler_quantidade(const char *texto, long long *valor) {
+    char *fim;
+    double lido = strtod(texto, &fim);
+    if (fim == texto || *fim != '\0' || lido < 0 || lido > 1e12) {
+        return 0;
+    }
+    *valor = (long long) lido;
+    return 1;
+}
+
+static void uso(const char *programa) {
+    fprintf(stderr, "Uso: %s notas|clientes|emprestimos <linhas> [--saida arquivo] [--semente S] [--fora P] "
+                    "[--nomes-longos P] [--invalidas P] [--ids densos|esparsos] [--clientes N] [--quentes K] "
+                    "[--fracao-quente F] [--orfaos P]\n", programa);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        uso(argv[0]);
+        return 1;
+    }
+
+    Opcoes opcoes;
+    memset(&opcoes, 0, sizeof(opcoes));
+    opcoes.semente = 1;
+    opcoes.fora = 0.02;
+    opcoes.clientes = -1;
+    const char *tipo = argv[1];
+    int ok = ler_quantidade(argv[2], &opcoes.linhas);
+
+    for (int i = 3; ok && i < argc; i++) {
+        const char *valor = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!valor) {
+            ok = 0;
+        } else if (strcmp(argv[i], "--saida") == 0) {
+            opcoes.saida = valor;
+        } else if (strcmp(argv[i], "--semente") == 0) {
+            opcoes.semente = strtoull(valor, NULL, 10);
+        } else if (strcmp(argv[i], "--fora") == 0) {
+            ok = ler_fracao(valor, &opcoes.fora);
+        } else if (strcmp(argv[i], "--nomes-longos") == 0) {
+            ok = ler_fracao(valor, &opcoes.nomes_longos);
+        } else if (strcmp(argv[i], "--invalidas") == 0) {
+            ok = ler_fracao(valor, &opcoes.invalidas);
+        } else if (strcmp(argv[i], "--ids") == 0) {
+            ok = strcmp(valor, "densos") == 0 || strcmp(valor, "esparsos") == 0;
+            opcoes.ids_esparsos = strcmp(valor, "esparsos") == 0;
+        } else if (strcmp(argv[i], "--clientes") == 0) {
+            ok = ler_quantidade(valor, &opcoes.clientes);
+        } else if (strcmp(argv[i], "--quentes") == 0) {
+            ok = ler_quantidade(valor, &opcoes.quentes);
+        } else if (strcmp(argv[i], "--fracao-quente") == 0) {
+            ok = ler_fracao(valor, &opcoes.fracao_quente);
+        } else if (strcmp(argv[i], "--orfaos") == 0) {
+            ok = ler_fracao(valor, &opcoes.orfaos);
+        } else {
+            ok = 0;
+        }
+        i++;
+    }
+
+    int tipo_valido = strcmp(tipo, "notas") == 0 || strcmp(tipo, "clientes") == 0 || strcmp(tipo, "emprestimos") == 0;
+    if (!ok || !tipo_valido) {
+        uso(argv[0]);
+        return 1;
+    }
+    if (strcmp(tipo, "emprestimos") == 0 && opcoes.clientes <= 0) {
+        fprintf(stderr, "Erro: emprestimos precisa de --clientes N (o número de linhas do clientes.csv)\n");
+        return 1;
+    }
+    // Os ids (e os 1000 ids dos órfãos) precisam caber em um int
+    if (opcoes.clientes > 2000000000LL || (strcmp(tipo, "clientes") == 0 && opcoes.linhas > 2000000000LL)) {
+        fprintf(stderr, "Erro: no máximo 2000000000 clientes\n");
+        return 1;
+    }
+    if (opcoes.quentes > opcoes.clientes && opcoes.clientes > 0) {
+        opcoes.quentes = opcoes.clientes;
+    }
+
+    FILE *saida = opcoes.saida ? fopen(opcoes.saida, "w") : stdout;
+    if (!saida) {
+        perror("Erro ao criar arquivo de saída");
+        return 1;
+    }
+    // Buffer grande: os arquivos maiores têm alguns GB
+    setvbuf(saida, NULL, _IOFBF, 1 << 20);
+
+    // Cada tipo de arquivo tem a sua sequência, então clientes e empréstimos com a mesma
+    // semente não repetem os mesmos números
+    estado = opcoes.semente * 0x9E3779B97F4A7C15ULL + (unsigned long long) tipo[0];
+    if (strcmp(tipo, "notas") == 0) {
+        gerar_notas(saida, &opcoes);
+    } else if (strcmp(tipo, "clientes") == 0) {
+        gerar_clientes(saida, &opcoes);
+    } else {
+        gerar_emprestimos(saida, &opcoes);
+    }
+
+    int erro = ferror(saida);
+    if (saida != stdout) {
+        erro = fclose(saida) != 0 || erro;
+    } else {
+        erro = fflush(saida) != 0 || erro;
+    }
+    if (erro) {
+        perror("Erro ao escrever o arquivo");
+        return 1;
+    }
+    return 0;
+}
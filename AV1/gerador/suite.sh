@@ -0,0 +1,37 @@
+#!/bin/sh
+# suite.sh
+# Gera os arquivos sintéticos em vários tamanhos e roda os benchmarks da AV1 com --json
+# Uso: ./suite.sh [tamanho ...]    (padrão: 1e3 1e4 1e5 1e6; 1e7 e 1e8 precisam de alguns GB em disco)
+# Variáveis: DADOS (pasta dos arquivos gerados, padrão /tmp/av1_dados), THREADS (padrão 0 = todos),
+#            SEMENTE (padrão 1), EMPRESTIMOS_POR_CLIENTE (padrão 10)
+# Cada etapa medida sai como um objeto JSON por linha na saída padrão
+set -e
+
+PASTA=$(cd "$(dirname "$0")" && pwd)
+DADOS=${DADOS:-/tmp/av1_dados}
+THREADS=${THREADS:-0}
+SEMENTE=${SEMENTE:-1}
+EMPRESTIMOS_POR_CLIENTE=${EMPRESTIMOS_POR_CLIENTE:-10}
+TAMANHOS=${*:-"1e3 1e4 1e5 1e6"}
+
+mkdir -p "$DADOS"
+gcc -O2 "$PASTA/gerador.c" -o "$DADOS/gerador"
+(cd "$PASTA/../Prova Guilherme Augusto" && gcc -O2 benchmark.c -o "$DADOS/benchmark_notas" -pthread -lm)
+(cd "$PASTA/../ap3" && gcc -O2 benchmark.c -o "$DADOS/benchmark_emprestimos" -pthread -lm)
+
+for tamanho in $TAMANHOS; do
+    notas="$DADOS/notas_$tamanho.csv"
+    clientes="$DADOS/clientes_$tamanho.csv"
+    emprestimos="$DADOS/emprestimos_$tamanho.csv"
+    # tamanho / EMPRESTIMOS_POR_CLIENTE clientes, com 20% dos empréstimos nos 100 clientes "quentes"
+    num_clientes=$(awk "BEGIN { printf \"%d\", $tamanho / $EMPRESTIMOS_POR_CLIENTE }")
+
+    "$DADOS/gerador" notas "$tamanho" --semente "$SEMENTE" --saida "$notas"
+    "$DADOS/gerador" clientes "$num_clientes" --semente "$SEMENTE" --saida "$clientes"
+    "$DADOS/gerador" emprestimos "$tamanho" --clientes "$num_clientes" --quentes 100 --fracao-quente 0.2 \
+        --semente "$SEMENTE" --saida "$emprestimos"
+
+    # Os avisos de leitura (stderr) ficam fora do JSON
+    "$DADOS/benchmark_notas" --json --threads "$THREADS" "$notas" 2>/dev/null
+    "$DADOS/benchmark_emprestimos" --json --threads "$THREADS" "$clientes" "$emprestimos" 2>/dev/null
+done